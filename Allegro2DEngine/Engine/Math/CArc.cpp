@@ -17,8 +17,9 @@
 #include "CPolygon.h"
 #include "CSpline.h"
 #include "CSector.h"
+#include "GJK.h"
 
-
+#include <cmath>
 
 #include "MathConstants.h"
 #include "MiscMath.h"
@@ -111,8 +112,8 @@ bool Arc::Intersects(const Shape& shape) const {
     return shape.Intersects(*this);
 }
 
-bool Arc::Intersects(const Point& /*point*/) const {
-    return false;
+bool Arc::Intersects(const Point& point) const {
+    return a2de::GJK::Intersects(*this, point);
 }
 
 bool Arc::Intersects(const Line& line) const {
@@ -162,16 +163,16 @@ bool Arc::Intersects(const Arc& arc) const {
     return ((myCenter == yourCenter) && distance_between_centers == arc.GetRadius() || distance_between_centers == this->GetRadius());
 }
 
-bool Arc::Intersects(const Polygon& /*polygon*/) const {
-    return false; //this->GetStartPoint().Intersects(polygon) || this->GetEndPoint().Intersects(polygon);
+bool Arc::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
 
-bool Arc::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Arc::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Arc::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Arc::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Arc::Intersects(const Vector2D& /*position*/) const {
@@ -314,5 +315,31 @@ Arc& Arc::operator=(const Arc& rhs) {
     return *this;
 }
 
+void Arc::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    double cx = GetPosition().GetX();
+    double cy = GetPosition().GetY();
+    x = cx + std::cos(_startAngle) * _radius;
+    y = cy - std::sin(_startAngle) * _radius;
+    double best_dot = direction_x * x + direction_y * y;
+    double end_x = cx + std::cos(_endAngle) * _radius;
+    double end_y = cy - std::sin(_endAngle) * _radius;
+    double dot = direction_x * end_x + direction_y * end_y;
+    if(dot > best_dot) {
+        best_dot = dot;
+        x = end_x;
+        y = end_y;
+    }
+    if(direction_x == 0.0 && direction_y == 0.0) return;
+
+    //The farthest point of the whole circle counts only when the sweep reaches it. Angles run
+    //counter-clockwise with y pointing down.
+    double angle = std::atan2(-direction_y, direction_x);
+    double sweep = std::fmod(angle - _startAngle, Math::A2DE_2PI);
+    if(sweep < 0.0) sweep += Math::A2DE_2PI;
+    if(sweep > _theta) return;
+    double length = std::sqrt(direction_x * direction_x + direction_y * direction_y);
+    x = cx + _radius * direction_x / length;
+    y = cy + _radius * direction_y / length;
+}
 
 A2DE_END
\ No newline at end of file
@@ -145,6 +145,17 @@ public:
      **************************************************************************************************/
     virtual void SetPosition(const Vector2D& position);
 
+    /**************************************************************************************************
+     * <summary>Gets the support point, the end point or the point of the curve farthest along the
+     * direction. The arc answers for the circular segment it bounds.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="direction_x">The x-component of the direction, need not be unit length.</param>
+     * <param name="direction_y">The y-component of the direction, need not be unit length.</param>
+     * <param name="x">          [out] The x-component of the support point.</param>
+     * <param name="y">          [out] The y-component of the support point.</param>
+     **************************************************************************************************/
+    virtual void GetSupport(double direction_x, double direction_y, double& x, double& y) const;
+
     /**************************************************************************************************
      * <summary>Query if this object intersects the given position.</summary>
      * <remarks>Casey Ugone, 8/24/2013.</remarks>
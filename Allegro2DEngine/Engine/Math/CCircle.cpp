@@ -8,6 +8,7 @@
 #include "CCircle.h"
 
 #include <cassert>
+#include <cmath>
 #include <allegro/gfx.h>
 #include "MathConstants.h"
 #include "MiscMath.h"
@@ -22,6 +23,7 @@
 #include "CSpline.h"
 #include "CSector.h"
 #include "CVector2D.h"
+#include "GJK.h"
 
 
 A2DE_BEGIN
@@ -185,20 +187,20 @@ bool Circle::Intersects(const Line& line) const {
     return line.Intersects(*this);
 }
 
-bool Circle::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Circle::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
 
-bool Circle::Intersects(const Polygon& /*polygon*/) const {
-    return false;
+bool Circle::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
 
-bool Circle::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Circle::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Circle::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Circle::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Circle::Intersects(const Vector2D& position) const {
@@ -230,5 +232,13 @@ bool Circle::Contains(const Circle& circle) const {
     return this->Intersects(Point(circle.GetPosition())) && circle.GetDiameter() <= this->GetRadius();
 }
 
+void Circle::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    x = _position.GetX();
+    y = _position.GetY();
+    double length = std::sqrt(direction_x * direction_x + direction_y * direction_y);
+    if(length == 0.0) return;
+    x += _radius * direction_x / length;
+    y += _radius * direction_y / length;
+}
 
 A2DE_END
\ No newline at end of file
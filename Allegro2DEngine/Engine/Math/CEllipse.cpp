@@ -8,6 +8,7 @@
 #include "CEllipse.h"
 
 #include <cassert>
+#include <cmath>
 #include <allegro/gfx.h>
 #include "MathConstants.h"
 #include "MiscMath.h"
@@ -21,6 +22,7 @@
 #include "CPolygon.h"
 #include "CSpline.h"
 #include "CSector.h"
+#include "GJK.h"
 
 
 A2DE_BEGIN
@@ -92,66 +94,39 @@ bool Ellipse::Intersects(const Shape& shape) const {
     return shape.Intersects(*this);
 }
 
-bool Ellipse::Intersects(const Triangle& /*triangle*/) const {
-    return false;
-    //Line tlAB(triangle.GetLineAB());
-    //Line tlBC(triangle.GetLineBC());
-    //Line tlCA(triangle.GetLineCA());
-    //bool resultAB = tlAB.Intersects(*this);
-    //bool resultBC = tlBC.Intersects(*this);
-    //bool resultCA = tlCA.Intersects(*this);
-    //bool isInside = Intersects(Point(triangle.GetCenter()));
-    //return (isInside || resultAB || resultBC || resultCA);
-}
-bool Ellipse::Intersects(const Ellipse& /*ellipse*/) const {
-    return false;
-    //return Point(this->GetCenter().GetX(), this->GetCenter().GetY()).GetDistance(Point(ellipse.GetCenter().GetX(), ellipse.GetCenter().GetY())) <= this->_radii.GetX() + ellipse._radii.GetX() &&
-    //       Point(this->GetCenter().GetX(), this->GetCenter().GetY()).GetDistance(Point(ellipse.GetCenter().GetX(), ellipse.GetCenter().GetY())) <= this->_radii.GetY() + ellipse._radii.GetY();
+bool Ellipse::Intersects(const Triangle& triangle) const {
+    return a2de::GJK::Intersects(*this, triangle);
 }
-bool Ellipse::Intersects(const Circle& /*circle*/) const {
-    return false;
-    //return Point(this->GetCenter().GetX(), this->GetCenter().GetY()).GetDistance(Point(circle.GetCenter().GetX(), circle.GetCenter().GetY())) <= this->_radii.GetX() + circle.GetRadius() &&
-    //       Point(this->GetCenter().GetX(), this->GetCenter().GetY()).GetDistance(Point(circle.GetCenter().GetX(), circle.GetCenter().GetY())) <= this->_radii.GetY() + circle.GetRadius();
+bool Ellipse::Intersects(const Ellipse& ellipse) const {
+    return a2de::GJK::Intersects(*this, ellipse);
 }
-bool Ellipse::Intersects(const Rectangle& /*rectangle*/) const {
-    return false;
-    //double distTop = Point(GetCenter().GetX(),GetCenter().GetY()).GetDistance(rectangle.GetTop());
-    //double distLeft = Point(GetCenter().GetX(),GetCenter().GetY()).GetDistance(rectangle.GetLeft());
-    //double distRight = Point(GetCenter().GetX(),GetCenter().GetY()).GetDistance(rectangle.GetRight());
-    //double distBottom = Point(GetCenter().GetX(),GetCenter().GetY()).GetDistance(rectangle.GetBottom());
-    //double radiusWidth = GetRadiusWidth();
-    //double radiusHeight = GetRadiusHeight();
-
-    //bool resultTop = (distTop < radiusWidth && distTop < radiusHeight);
-    //bool resultBottom = (distBottom < radiusWidth && distBottom < radiusHeight);
-    //bool resultLeft = (distLeft < radiusWidth && distLeft < radiusHeight);
-    //bool resultRight = (distRight < radiusWidth && distRight < radiusHeight);
-    //bool isInside = Point(GetCenter().GetX(),GetCenter().GetY()).Intersects(rectangle);
-    //return (isInside || resultTop || resultBottom || resultLeft || resultRight);
-}
-bool Ellipse::Intersects(const Point& /*point*/) const {
-    return false;
-    //return (Point(GetCenter().GetX(),GetCenter().GetY()).GetDistance(point) <= _radii.GetX() &&
-    //        Point(GetCenter().GetX(),GetCenter().GetY()).GetDistance(point) <= _radii.GetY());
+bool Ellipse::Intersects(const Circle& circle) const {
+    return a2de::GJK::Intersects(*this, circle);
+}
+bool Ellipse::Intersects(const Rectangle& rectangle) const {
+    return a2de::GJK::Intersects(*this, rectangle);
+}
+bool Ellipse::Intersects(const Point& point) const {
+    return a2de::GJK::Intersects(*this, point);
 }
 bool Ellipse::Intersects(const Line& line) const {
     return line.Intersects(*this);
 }
 
-bool Ellipse::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Ellipse::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
 
-bool Ellipse::Intersects(const Polygon& /*polygon*/) const {
-    return false;
+bool Ellipse::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
 
-bool Ellipse::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Ellipse::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Ellipse::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Ellipse::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Ellipse::Intersects(const Vector2D& position) const {
@@ -264,5 +239,16 @@ Ellipse& Ellipse::operator=(const Ellipse& rhs) {
     return *this;
 }
 
+void Ellipse::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    //The point of the ellipse whose normal is d is c + (a^2 dx, b^2 dy) / sqrt(a^2 dx^2 + b^2 dy^2).
+    double aa = _radii.GetX() * _radii.GetX();
+    double bb = _radii.GetY() * _radii.GetY();
+    x = _position.GetX();
+    y = _position.GetY();
+    double length = std::sqrt(aa * direction_x * direction_x + bb * direction_y * direction_y);
+    if(length == 0.0) return;
+    x += aa * direction_x / length;
+    y += bb * direction_y / length;
+}
 
 A2DE_END
\ No newline at end of file
@@ -17,6 +17,7 @@
 #include "CPolygon.h"
 #include "CSpline.h"
 #include "CSector.h"
+#include "GJK.h"
 
 
 
@@ -353,29 +354,24 @@ bool Line::Intersects(const Ellipse& ellipse) const {
     return (resultX && resultY);
 }
 
-bool Line::Intersects(const Triangle& /*triangle*/) const {
-    return false;
-    //bool resultAB = Intersects(triangle.GetLineAB());
-    //bool resultBC = Intersects(triangle.GetLineBC());
-    //bool resultCA = Intersects(triangle.GetLineCA());
-    //bool isInside = Point(GetPointOne()).Intersects(triangle) || Point(GetPointTwo()).Intersects(triangle);
-    //return (isInside || resultAB || resultBC || resultCA);
+bool Line::Intersects(const Triangle& triangle) const {
+    return a2de::GJK::Intersects(*this, triangle);
 }
 
-bool Line::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Line::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
 
-bool Line::Intersects(const Polygon& /*polygon*/) const {
-    return false;
+bool Line::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
 
-bool Line::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Line::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Line::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Line::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Line::Intersects(const Vector2D& position) const {
@@ -538,5 +534,12 @@ bool Line::Contains(const Sector& /*sector*/) const {
     return false;
 }
 
+void Line::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    double one = direction_x * _extent_one.GetX() + direction_y * _extent_one.GetY();
+    double two = direction_x * _extent_two.GetX() + direction_y * _extent_two.GetY();
+    const Vector2D& best = (one < two ? _extent_two : _extent_one);
+    x = best.GetX();
+    y = best.GetY();
+}
 
 A2DE_END
\ No newline at end of file
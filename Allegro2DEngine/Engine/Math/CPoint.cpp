@@ -21,6 +21,7 @@
 #include "CSpline.h"
 #include "CSector.h"
 #include "CVector2D.h"
+#include "GJK.h"
 
 
 #include "../a2de_exceptions.h"
@@ -356,14 +357,14 @@ bool Point::Intersects(const Triangle& triangle) const {
     return (resultAB && resultBC && resultCA && resultA && resultB && resultC);
 }
 
-bool Point::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Point::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
-bool Point::Intersects(const Polygon& /*polygon*/) const {
-    return false;
+bool Point::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
-bool Point::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Point::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
 bool Point::Intersects(const Sector& sector) const {
@@ -415,5 +416,9 @@ bool Point::Contains(const Sector& /*sector*/) const {
     return false;
 }
 
+void Point::GetSupport(double /*direction_x*/, double /*direction_y*/, double& x, double& y) const {
+    x = _position.GetX();
+    y = _position.GetY();
+}
 
 A2DE_END
\ No newline at end of file
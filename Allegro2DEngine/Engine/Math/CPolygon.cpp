@@ -17,17 +17,19 @@
 #include "CArc.h"
 #include "CSpline.h"
 #include "CSector.h"
+#include "GJK.h"
 
 
 #include "MathConstants.h"
 #include "MiscMath.h"
 #include <algorithm>
+#include <cmath>
 #include <cfloat>
 #include "../a2de_exceptions.h"
 
 A2DE_BEGIN
 
-Polygon::Polygon(const std::vector<a2de::Vector2D>& points, const a2de::Color& color, bool filled) : Shape() {
+Polygon::Polygon(const std::vector<a2de::Vector2D>& points, const a2de::Color& color, bool filled) : Shape(), _points(), _normals(), _convex(false) {
     std::size_t s = points.size();
     if(s < 3) throw Exception("A polygon must have at least 3 vertices.");
     _type = Shape::SHAPETYPE_POLYGON;
@@ -52,8 +54,9 @@ Polygon::Polygon(const std::vector<a2de::Vector2D>& points, const a2de::Color& c
     _half_extents = Vector2D(width, height);
     CalculateArea();
     CalculateCenter();
+    CalculateNormals();
 }
-Polygon::Polygon(const Polygon& polygon) : Shape(polygon) {
+Polygon::Polygon(const Polygon& polygon) : Shape(polygon), _points(), _normals(polygon._normals), _convex(polygon._convex) {
     std::size_t s = polygon._points.size();
     if(s < 3) throw Exception("A polygon must have at least 3 vertices.");
     _type = Shape::SHAPETYPE_POLYGON;
@@ -88,6 +91,7 @@ void Polygon::SetVertexPosition(unsigned int vertexNum, double x, double y) {
     _points[vertexNum] = a2de::Vector2D(x, y);
     CalculateArea();
     CalculateCenter();
+    CalculateNormals();
 }
 
 bool Polygon::Intersects(const Shape& shape) const {
@@ -142,6 +146,10 @@ bool Polygon::Intersects(const Triangle& triangle) const {
 }
 bool Polygon::Intersects(const Polygon& polygon) const {
     if(polygon.Intersects(this->GetBoundingBox()) == false) return false;
+    //Convex pairs are decided on the cached side normals; only concave ones need every pair of sides.
+    if(_convex && polygon._convex) {
+        return HasSeparatingAxis(*this, polygon) == false && HasSeparatingAxis(polygon, *this) == false;
+    }
     std::vector<Line> mySides(0);
     std::vector<Line> yourSides(0);
     this->GetSides(mySides);
@@ -173,16 +181,16 @@ void Polygon::Draw(BITMAP* dest, const a2de::Color& color, bool filled) {
 
 }
 
-bool Polygon::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Polygon::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
 
-bool Polygon::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Polygon::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Polygon::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Polygon::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Polygon::Intersects(const Vector2D& position) const {
@@ -228,6 +236,67 @@ const std::vector<a2de::Vector2D>& Polygon::GetVertices() const {
     return _points;
 }
 
+const std::vector<a2de::Vector2D>& Polygon::GetNormals() const {
+    return _normals;
+}
+
+bool Polygon::IsConvex() const {
+    return _convex;
+}
+
+void Polygon::CalculateNormals() {
+    std::size_t s = _points.size();
+
+    //The winding decides which side of each edge is outside.
+    double twice_area = 0.0;
+    for(std::size_t i = 0; i < s; ++i) {
+        const a2de::Vector2D& a = _points[i];
+        const a2de::Vector2D& b = _points[(i + 1) % s];
+        twice_area += a.GetX() * b.GetY() - b.GetX() * a.GetY();
+    }
+    double winding = twice_area < 0.0 ? -1.0 : 1.0;
+
+    _normals.clear();
+    _normals.reserve(s);
+    _convex = true;
+    for(std::size_t i = 0; i < s; ++i) {
+        const a2de::Vector2D& a = _points[i];
+        const a2de::Vector2D& b = _points[(i + 1) % s];
+        const a2de::Vector2D& c = _points[(i + 2) % s];
+        double dx = b.GetX() - a.GetX();
+        double dy = b.GetY() - a.GetY();
+        double length = std::sqrt(dx * dx + dy * dy);
+        if(length > 0.0) {
+            _normals.push_back(a2de::Vector2D(winding * dy / length, -winding * dx / length));
+        } else {
+            _normals.push_back(a2de::Vector2D(0.0, 0.0));
+        }
+        //Every corner turns the same way as the polygon as a whole.
+        double turn = dx * (c.GetY() - b.GetY()) - dy * (c.GetX() - b.GetX());
+        if(turn * winding < 0.0) _convex = false;
+    }
+}
+
+bool Polygon::HasSeparatingAxis(const Polygon& polygon, const Polygon& other) {
+    std::size_t s = polygon._points.size();
+    std::size_t os = other._points.size();
+    for(std::size_t i = 0; i < s; ++i) {
+        double nx = polygon._normals[i].GetX();
+        double ny = polygon._normals[i].GetY();
+        //The polygon lies behind its own side, so the other is separated if all of it is in front.
+        double face = nx * polygon._points[i].GetX() + ny * polygon._points[i].GetY();
+        bool separated = true;
+        for(std::size_t j = 0; j < os; ++j) {
+            if(nx * other._points[j].GetX() + ny * other._points[j].GetY() <= face) {
+                separated = false;
+                break;
+            }
+        }
+        if(separated) return true;
+    }
+    return false;
+}
+
 int* Polygon::CreateVerticesArray() {
     int* points = new int[GetNumVertices() * 2];
     std::size_t s = _points.size();
@@ -423,14 +492,30 @@ Polygon& Polygon::operator=(const Polygon& rhs) {
     std::size_t rhs_s = rhs._points.size();
     if(rhs_s < 3) throw Exception("A polygon must have at least 3 vertices.");
     _type = Shape::SHAPETYPE_POLYGON;
+    this->_points.clear();
     for(size_t i = 0; i < rhs_s; ++i) {
         this->_points.push_back(rhs._points[i]);
     }
+    this->_normals = rhs._normals;
+    this->_convex = rhs._convex;
     CalculateArea();
     CalculateCenter();
 
     return *this;
 }
 
+void Polygon::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    x = _position.GetX();
+    y = _position.GetY();
+    double best_dot = -DBL_MAX;
+    for(std::size_t i = 0; i < _points.size(); ++i) {
+        double dot = direction_x * _points[i].GetX() + direction_y * _points[i].GetY();
+        if(dot > best_dot) {
+            best_dot = dot;
+            x = _points[i].GetX();
+            y = _points[i].GetY();
+        }
+    }
+}
 
 A2DE_END
\ No newline at end of file
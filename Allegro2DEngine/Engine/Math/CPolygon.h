@@ -82,6 +82,17 @@ public:
      **************************************************************************************************/
     virtual void SetPosition(const Vector2D& position);
 
+    /**************************************************************************************************
+     * <summary>Gets the support point, the vertex farthest along the direction. A concave polygon
+     * answers for its convex hull.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="direction_x">The x-component of the direction, need not be unit length.</param>
+     * <param name="direction_y">The y-component of the direction, need not be unit length.</param>
+     * <param name="x">          [out] The x-component of the support point.</param>
+     * <param name="y">          [out] The y-component of the support point.</param>
+     **************************************************************************************************/
+    virtual void GetSupport(double direction_x, double direction_y, double& x, double& y) const;
+
     /**************************************************************************************************
      * <summary>Query if this object intersects the given position.</summary>
      * <remarks>Casey Ugone, 8/23/2013.</remarks>
@@ -334,6 +345,22 @@ public:
      **************************************************************************************************/
     std::vector<a2de::Vector2D>& GetVertices();
 
+    /**************************************************************************************************
+     * <summary>Gets the outward unit normal of each side, side i running from vertex i to vertex
+     * i + 1. Kept up to date by every member that changes the shape of the polygon; moving it does
+     * not change them. Vertices changed through GetVertices() leave them stale.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <returns>The normals.</returns>
+     **************************************************************************************************/
+    const std::vector<a2de::Vector2D>& GetNormals() const;
+
+    /**************************************************************************************************
+     * <summary>Query if the polygon is convex, as of the last time its normals were calculated.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <returns>true if convex, false if not.</returns>
+     **************************************************************************************************/
+    bool IsConvex() const;
+
     /**************************************************************************************************
      * <summary>Creates the vertices array.</summary>
      * <remarks>Casey Ugone, 9/3/2012.</remarks>
@@ -395,6 +422,12 @@ protected:
      **************************************************************************************************/
     void CalculatePoints(double deltaX, double deltaY);
 
+    /**************************************************************************************************
+     * <summary>Calculates the side normals and whether the polygon is convex.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     **************************************************************************************************/
+    void CalculateNormals();
+
     /**************************************************************************************************
      * <summary>Gets the bounding box.</summary>
      * <remarks>Casey Ugone, 9/3/2012.</remarks>
@@ -404,9 +437,22 @@ protected:
 
     /// <summary> The points </summary>
     std::vector<a2de::Vector2D> _points;
+    /// <summary> The outward unit normal of each side </summary>
+    std::vector<a2de::Vector2D> _normals;
+    /// <summary> Whether the polygon is convex </summary>
+    bool _convex;
 
 private:
 
+    /**************************************************************************************************
+     * <summary>Query if a side normal of one convex polygon separates it from another.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="polygon">The polygon whose normals are tried.</param>
+     * <param name="other">  The other polygon.</param>
+     * <returns>true if a separating axis was found, false if not.</returns>
+     **************************************************************************************************/
+    static bool HasSeparatingAxis(const Polygon& polygon, const Polygon& other);
+
     /**************************************************************************************************
      * <summary>Sets the dimensions.</summary>
      * <remarks>Casey Ugone, 9/3/2012.</remarks>
@@ -20,6 +20,7 @@
 #include "CSpline.h"
 #include "CSector.h"
 #include "CVector2D.h"
+#include "GJK.h"
 
 #include "MiscMath.h"
 #include "../a2de_exceptions.h"
@@ -218,22 +219,8 @@ bool Rectangle::Intersects(const Rectangle& rectangle) const {
 
     return true;
 }
-bool Rectangle::Intersects(const Triangle& /*triangle*/) const {
-    return false;
-    //bool resultTop = GetTop().Intersects(triangle.GetLineAB()) ||
-    //    GetTop().Intersects(triangle.GetLineBC()) ||
-    //    GetTop().Intersects(triangle.GetLineCA());
-    //bool resultLeft = GetLeft().Intersects(triangle.GetLineAB()) ||
-    //    GetLeft().Intersects(triangle.GetLineBC()) ||
-    //    GetLeft().Intersects(triangle.GetLineCA());
-    //bool resultRight = GetRight().Intersects(triangle.GetLineAB()) ||
-    //    GetRight().Intersects(triangle.GetLineBC()) ||
-    //    GetRight().Intersects(triangle.GetLineCA());
-    //bool resultBottom = GetBottom().Intersects(triangle.GetLineAB()) ||
-    //    GetBottom().Intersects(triangle.GetLineBC()) ||
-    //    GetBottom().Intersects(triangle.GetLineCA());
-    //bool isInside = Intersects(Point(triangle.GetCenter(), triangle.GetColor()));
-    //return (isInside || resultTop || resultLeft || resultRight || resultBottom);
+bool Rectangle::Intersects(const Triangle& triangle) const {
+    return a2de::GJK::Intersects(*this, triangle);
 }
 bool Rectangle::Intersects(const Ellipse& ellipse) const {
 
@@ -281,16 +268,16 @@ bool Rectangle::Intersects(const Shape& shape) const {
     return shape.Intersects(*this);
 }
 
-bool Rectangle::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Rectangle::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
 
-bool Rectangle::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Rectangle::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Rectangle::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Rectangle::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Rectangle::Intersects(const Vector2D& position) const {
@@ -316,7 +303,7 @@ bool Rectangle::Intersects(const Vector2D& position) const {
     return true;
 }
 
-void Rectangle::Overlap(const Rectangle& rectIN, Rectangle& rectOUT, bool& result) {
+void Rectangle::Overlap(const Rectangle& rectIN, Rectangle& rectOUT, bool& result) const {
     if(this->Intersects(rectIN) == false) {
         result = false;
         return;
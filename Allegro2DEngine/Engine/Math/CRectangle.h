@@ -396,7 +396,7 @@ public:
      * <param name="rectOUT">[in,out] The rectangle out.</param>
      * <param name="result"> [in,out] The result.</param>
      **************************************************************************************************/
-    void Overlap(const Rectangle& rectIN, Rectangle& rectOUT, bool& result);
+    void Overlap(const Rectangle& rectIN, Rectangle& rectOUT, bool& result) const;
 
     /**************************************************************************************************
      * <summary>Assignment operator.</summary>
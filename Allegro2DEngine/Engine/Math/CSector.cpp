@@ -16,6 +16,7 @@
 #include "CArc.h"
 #include "CPolygon.h"
 #include "CSpline.h"
+#include "GJK.h"
 
 #include "MathConstants.h"
 #include "MiscMath.h"
@@ -271,8 +272,8 @@ bool Sector::Intersects(const Circle& circle) const {
     return false;
 }
 
-bool Sector::Intersects(const Ellipse& /*ellipse*/) const {
-    return false;
+bool Sector::Intersects(const Ellipse& ellipse) const {
+    return a2de::GJK::Intersects(*this, ellipse);
 }
 
 bool Sector::Intersects(const Triangle& triangle) const {
@@ -296,20 +297,20 @@ bool Sector::Intersects(const Triangle& triangle) const {
     return false;
 }
 
-bool Sector::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Sector::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
 
-bool Sector::Intersects(const Polygon& /*polygon*/) const {
-    return false;
+bool Sector::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
 
-bool Sector::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Sector::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
-bool Sector::Intersects(const Sector& /*sector*/) const {
-    return false;
+bool Sector::Intersects(const Sector& sector) const {
+    return a2de::GJK::Intersects(*this, sector);
 }
 
 bool Sector::Intersects(const Vector2D& position) const {
@@ -340,5 +341,14 @@ Sector& Sector::operator=(const Sector& rhs) {
     return *this;
 }
 
+void Sector::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    _arc.GetSupport(direction_x, direction_y, x, y);
+    double cx = GetPosition().GetX();
+    double cy = GetPosition().GetY();
+    if(direction_x * cx + direction_y * cy > direction_x * x + direction_y * y) {
+        x = cx;
+        y = cy;
+    }
+}
 
 A2DE_END
\ No newline at end of file
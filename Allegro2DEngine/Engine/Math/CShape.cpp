@@ -424,5 +424,9 @@ void Shape::Draw(BITMAP* dest) {
     Draw(dest, _color, _filled);
 }
 
+void Shape::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    x = _position.GetX() + (direction_x < 0.0 ? -_half_extents.GetX() : _half_extents.GetX());
+    y = _position.GetY() + (direction_y < 0.0 ? -_half_extents.GetY() : _half_extents.GetY());
+}
 
 A2DE_END
\ No newline at end of file
@@ -444,6 +444,18 @@ public:
      **************************************************************************************************/
     virtual void Draw(BITMAP* dest);
 
+    /**************************************************************************************************
+     * <summary>Gets the support point: the point of the shape farthest along a direction. Collision
+     * queries such as GJK only need this, so a shape that overrides it collides with every other
+     * shape. The default is the corner of the bounding box.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="direction_x">The x-component of the direction, need not be unit length.</param>
+     * <param name="direction_y">The y-component of the direction, need not be unit length.</param>
+     * <param name="x">          [out] The x-component of the support point.</param>
+     * <param name="y">          [out] The y-component of the support point.</param>
+     **************************************************************************************************/
+    virtual void GetSupport(double direction_x, double direction_y, double& x, double& y) const;
+
     /**************************************************************************************************
      * <summary>Gets the shape type.</summary>
      * <remarks>Casey Ugone, 3/28/2013.</remarks>
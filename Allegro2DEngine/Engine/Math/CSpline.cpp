@@ -308,4 +308,19 @@ bool Spline::Contains(const Sector& /*sector*/) const {
     return false;
 }
 
+void Spline::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    x = GetPosition().GetX();
+    y = GetPosition().GetY();
+    double best_dot = 0.0;
+    for(std::size_t i = 0; i < _result_points.size(); ++i) {
+        const Vector2D& point = _result_points[i].GetPosition();
+        double dot = direction_x * point.GetX() + direction_y * point.GetY();
+        if(i == 0 || dot > best_dot) {
+            best_dot = dot;
+            x = point.GetX();
+            y = point.GetY();
+        }
+    }
+}
+
 A2DE_END
\ No newline at end of file
@@ -21,6 +21,7 @@
 
 #include "CVector2D.h"
 #include "CVector3D.h"
+#include "GJK.h"
 
 #include "MathConstants.h"
 #include "MiscMath.h"
@@ -115,69 +116,27 @@ bool Triangle::Intersects(const Line& line) const {
     return line.Intersects(*this);
 }
 
-bool Triangle::Intersects(const Rectangle& /*rectangle*/) const {
-    return false;
-    //bool resultAB = GetLineAB().Intersects(rectangle);
-    //bool resultBC = GetLineBC().Intersects(rectangle);
-    //bool resultCA = GetLineCA().Intersects(rectangle);
-
-    //bool resultA = GetPointA().Intersects(rectangle);
-    //bool resultB = GetPointB().Intersects(rectangle);
-    //bool resultC = GetPointC().Intersects(rectangle);
-    //return (resultAB || resultBC || resultCA || resultA || resultB || resultC);
+bool Triangle::Intersects(const Rectangle& rectangle) const {
+    return a2de::GJK::Intersects(*this, rectangle);
 }
-bool Triangle::Intersects(const Circle& /*circle*/) const {
-    return false;
-    //bool resultAB = GetLineAB().Intersects(circle);
-    //bool resultBC = GetLineBC().Intersects(circle);
-    //bool resultCA = GetLineCA().Intersects(circle);
-
-    //bool resultA = GetPointA().Intersects(circle);
-    //bool resultB = GetPointB().Intersects(circle);
-    //bool resultC = GetPointC().Intersects(circle);
-    //bool resultCircleCenter = this->Intersects(Point(circle.GetPosition()));
-    //return (resultAB || resultBC || resultCA || resultA || resultB || resultC || resultCircleCenter);
+bool Triangle::Intersects(const Circle& circle) const {
+    return a2de::GJK::Intersects(*this, circle);
 }
-bool Triangle::Intersects(const Ellipse& /*ellipse*/) const {
-    return false;
-    //bool resultAB = GetLineAB().Intersects(ellipse);
-    //bool resultBC = GetLineBC().Intersects(ellipse);
-    //bool resultCA = GetLineCA().Intersects(ellipse);
-
-    //bool resultA = GetPointA().Intersects(ellipse);
-    //bool resultB = GetPointB().Intersects(ellipse);
-    //bool resultC = GetPointC().Intersects(ellipse);
-    //return (resultAB || resultBC || resultCA || resultA || resultB || resultC);
+bool Triangle::Intersects(const Ellipse& ellipse) const {
+    return a2de::GJK::Intersects(*this, ellipse);
 }
-bool Triangle::Intersects(const Triangle& /*triangle*/) const {
-    return false;
-    //bool resultAB = this->GetLineAB().Intersects(triangle.GetLineAB()) ||
-    //                this->GetLineAB().Intersects(triangle.GetLineBC()) ||
-    //                this->GetLineAB().Intersects(triangle.GetLineCA());
-
-    //bool resultBC = this->GetLineBC().Intersects(triangle.GetLineAB()) ||
-    //    this->GetLineBC().Intersects(triangle.GetLineBC()) ||
-    //    this->GetLineBC().Intersects(triangle.GetLineCA());
-
-    //bool resultCA = this->GetLineCA().Intersects(triangle.GetLineAB()) ||
-    //    this->GetLineCA().Intersects(triangle.GetLineBC()) ||
-    //    this->GetLineCA().Intersects(triangle.GetLineCA());
-
-    //bool resultA = this->GetPointA().Intersects(triangle);
-    //bool resultB = this->GetPointB().Intersects(triangle);
-    //bool resultC = this->GetPointC().Intersects(triangle);
-
-    //return (resultAB || resultBC || resultCA || resultA || resultB || resultC);
+bool Triangle::Intersects(const Triangle& triangle) const {
+    return a2de::GJK::Intersects(*this, triangle);
 }
 
-bool Triangle::Intersects(const Arc& /*arc*/) const {
-    return false;
+bool Triangle::Intersects(const Arc& arc) const {
+    return a2de::GJK::Intersects(*this, arc);
 }
-bool Triangle::Intersects(const Polygon& /*polygon*/) const {
-    return false;
+bool Triangle::Intersects(const Polygon& polygon) const {
+    return a2de::GJK::Intersects(*this, polygon);
 }
-bool Triangle::Intersects(const Spline& /*spline*/) const {
-    return false;
+bool Triangle::Intersects(const Spline& spline) const {
+    return a2de::GJK::Intersects(*this, spline);
 }
 
 bool Triangle::Intersects(const Sector& sector) const {
@@ -396,4 +355,20 @@ Triangle& Triangle::operator=(const Triangle& rhs) {
     return *this;
 }
 
+void Triangle::GetSupport(double direction_x, double direction_y, double& x, double& y) const {
+    const Vector2D* best = &_pointA;
+    double best_dot = direction_x * _pointA.GetX() + direction_y * _pointA.GetY();
+    double dot = direction_x * _pointB.GetX() + direction_y * _pointB.GetY();
+    if(dot > best_dot) {
+        best_dot = dot;
+        best = &_pointB;
+    }
+    dot = direction_x * _pointC.GetX() + direction_y * _pointC.GetY();
+    if(dot > best_dot) {
+        best = &_pointC;
+    }
+    x = best->GetX();
+    y = best->GetY();
+}
+
 A2DE_END
\ No newline at end of file
@@ -0,0 +1,395 @@
+/**************************************************************************************************
+// file:	Engine\Math\GJK.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the GJK class
+ **************************************************************************************************/
+#include "GJK.h"
+
+#include "CShape.h"
+
+#include <cmath>
+#include <cfloat>
+
+A2DE_BEGIN
+
+const std::size_t GJK::MAX_ITERATIONS;
+const double GJK::TOLERANCE = 1.0e-9;
+
+bool GJK::Intersects(const a2de::Shape& a, const a2de::Shape& b) {
+    Simplex simplex;
+    return Evolve(a, b, 0.0, 0.0, simplex);
+}
+
+double GJK::GetDistance(const a2de::Shape& a, const a2de::Shape& b, a2de::Vector2D& point_a, a2de::Vector2D& point_b) {
+    Simplex simplex;
+    bool touching = Evolve(a, b, 0.0, 0.0, simplex);
+
+    double ax = 0.0;
+    double ay = 0.0;
+    double bx = 0.0;
+    double by = 0.0;
+    GetWitnessPoints(simplex, ax, ay, bx, by);
+    point_a = a2de::Vector2D(ax, ay);
+    if(touching) {
+        point_b = point_a;
+        return 0.0;
+    }
+    point_b = a2de::Vector2D(bx, by);
+    return std::sqrt((bx - ax) * (bx - ax) + (by - ay) * (by - ay));
+}
+
+bool GJK::GetPenetration(const a2de::Shape& a, const a2de::Shape& b, a2de::Vector2D& normal, double& depth, a2de::Vector2D& point) {
+    Simplex simplex;
+    if(Evolve(a, b, 0.0, 0.0, simplex) == false) return false;
+    Expand(a, b, 0.0, 0.0, simplex, normal, depth, point);
+    return true;
+}
+
+bool GJK::GetTimeOfImpact(const a2de::Shape& a, const a2de::Vector2D& translation_a, const a2de::Shape& b, const a2de::Vector2D& translation_b, double separation, double& time, a2de::Vector2D& normal) {
+    a2de::Vector2D point;
+    return GetTimeOfImpact(a, translation_a, b, translation_b, separation, time, normal, point);
+}
+
+bool GJK::GetTimeOfImpact(const a2de::Shape& a, const a2de::Vector2D& translation_a, const a2de::Shape& b, const a2de::Vector2D& translation_b, double separation, double& time, a2de::Vector2D& normal, a2de::Vector2D& point) {
+    //Only the motion of b as seen from a matters.
+    double rx = translation_b.GetX() - translation_a.GetX();
+    double ry = translation_b.GetY() - translation_a.GetY();
+    double t = 0.0;
+    double nx = 1.0;
+    double ny = 0.0;
+    double ax = 0.0;
+    double ay = 0.0;
+    for(std::size_t iteration = 0; iteration <= MAX_ITERATIONS; ++iteration) {
+        Simplex simplex;
+        if(Evolve(a, b, t * rx, t * ry, simplex)) {
+            double depth = 0.0;
+            Expand(a, b, t * rx, t * ry, simplex, normal, depth, point);
+            time = t;
+            point = a2de::Vector2D(point.GetX() + t * translation_a.GetX(), point.GetY() + t * translation_a.GetY());
+            return true;
+        }
+        double bx = 0.0;
+        double by = 0.0;
+        GetWitnessPoints(simplex, ax, ay, bx, by);
+        nx = bx - ax;
+        ny = by - ay;
+        double distance = std::sqrt(nx * nx + ny * ny);
+        if(distance <= TOLERANCE) {
+            time = t;
+            normal = a2de::Vector2D(1.0, 0.0);
+            point = a2de::Vector2D(ax + t * translation_a.GetX(), ay + t * translation_a.GetY());
+            return true;
+        }
+        nx /= distance;
+        ny /= distance;
+        if(distance <= separation + TOLERANCE) {
+            time = t;
+            normal = a2de::Vector2D(nx, ny);
+            point = a2de::Vector2D(ax + t * translation_a.GetX(), ay + t * translation_a.GetY());
+            return true;
+        }
+
+        //No point of b can close on a faster than the motion along the normal, so the shapes may
+        //safely advance until that closing covers the gap.
+        double closing = -(rx * nx + ry * ny);
+        if(closing <= 0.0) return false;
+        t += (distance - separation) / closing;
+        if(t > 1.0) return false;
+    }
+
+    //Still closing in when out of iterations; every step stopped short of contact, so this time is safe.
+    time = t;
+    normal = a2de::Vector2D(nx, ny);
+    point = a2de::Vector2D(ax + t * translation_a.GetX(), ay + t * translation_a.GetY());
+    return true;
+}
+
+void GJK::GetSupport(const a2de::Shape& a, const a2de::Shape& b, double offset_x, double offset_y, double direction_x, double direction_y, SupportPoint& point) {
+    a.GetSupport(-direction_x, -direction_y, point.ax, point.ay);
+    b.GetSupport(direction_x, direction_y, point.bx, point.by);
+    point.bx += offset_x;
+    point.by += offset_y;
+    point.wx = point.bx - point.ax;
+    point.wy = point.by - point.ay;
+    point.u = 1.0;
+}
+
+bool GJK::Evolve(const a2de::Shape& a, const a2de::Shape& b, double offset_x, double offset_y, Simplex& simplex) {
+    double dx = b.GetPosition().GetX() + offset_x - a.GetPosition().GetX();
+    double dy = b.GetPosition().GetY() + offset_y - a.GetPosition().GetY();
+    if(dx == 0.0 && dy == 0.0) dx = 1.0;
+    GetSupport(a, b, offset_x, offset_y, dx, dy, simplex.points[0]);
+    simplex.count = 1;
+
+    for(std::size_t iteration = 0; ; ++iteration) {
+        if(simplex.count == 2) Solve2(simplex);
+        if(simplex.count == 3) Solve3(simplex);
+        if(simplex.count == 3) return true;
+
+        //Search towards the origin. Along an edge the perpendicular is more precise than the
+        //negated closest point, which loses digits as the edge nears the origin.
+        double cx = 0.0;
+        double cy = 0.0;
+        GetClosestPoint(simplex, cx, cy);
+        if(simplex.count == 1) {
+            dx = -cx;
+            dy = -cy;
+        } else {
+            const SupportPoint& p0 = simplex.points[0];
+            const SupportPoint& p1 = simplex.points[1];
+            double ex = p1.wx - p0.wx;
+            double ey = p1.wy - p0.wy;
+            if(ex * -p0.wy - ey * -p0.wx > 0.0) {
+                dx = -ey;
+                dy = ex;
+            } else {
+                dx = ey;
+                dy = -ex;
+            }
+        }
+        double length = std::sqrt(dx * dx + dy * dy);
+        if(length <= TOLERANCE || cx * cx + cy * cy <= TOLERANCE * TOLERANCE) return true;
+        if(iteration == MAX_ITERATIONS) return false;
+
+        SupportPoint& next = simplex.points[simplex.count];
+        GetSupport(a, b, offset_x, offset_y, dx, dy, next);
+
+        //A point already in the simplex, or one no nearer the origin, means the search converged
+        //short of it.
+        for(std::size_t i = 0; i < simplex.count; ++i) {
+            if(simplex.points[i].wx == next.wx && simplex.points[i].wy == next.wy) return false;
+        }
+        if(((next.wx - cx) * dx + (next.wy - cy) * dy) / length <= TOLERANCE) return false;
+        ++simplex.count;
+    }
+}
+
+void GJK::Solve2(Simplex& simplex) {
+    SupportPoint& p0 = simplex.points[0];
+    SupportPoint& p1 = simplex.points[1];
+    double ex = p1.wx - p0.wx;
+    double ey = p1.wy - p0.wy;
+
+    double d0 = -(p0.wx * ex + p0.wy * ey);
+    if(d0 <= 0.0) {
+        p0.u = 1.0;
+        simplex.count = 1;
+        return;
+    }
+    double d1 = p1.wx * ex + p1.wy * ey;
+    if(d1 <= 0.0) {
+        p1.u = 1.0;
+        p0 = p1;
+        simplex.count = 1;
+        return;
+    }
+    p0.u = d1 / (d0 + d1);
+    p1.u = d0 / (d0 + d1);
+    simplex.count = 2;
+}
+
+void GJK::Solve3(Simplex& simplex) {
+    SupportPoint& p0 = simplex.points[0];
+    SupportPoint& p1 = simplex.points[1];
+    SupportPoint& p2 = simplex.points[2];
+
+    double e01x = p1.wx - p0.wx;
+    double e01y = p1.wy - p0.wy;
+    double d01_0 = p1.wx * e01x + p1.wy * e01y;
+    double d01_1 = -(p0.wx * e01x + p0.wy * e01y);
+
+    double e02x = p2.wx - p0.wx;
+    double e02y = p2.wy - p0.wy;
+    double d02_0 = p2.wx * e02x + p2.wy * e02y;
+    double d02_2 = -(p0.wx * e02x + p0.wy * e02y);
+
+    double e12x = p2.wx - p1.wx;
+    double e12y = p2.wy - p1.wy;
+    double d12_1 = p2.wx * e12x + p2.wy * e12y;
+    double d12_2 = -(p1.wx * e12x + p1.wy * e12y);
+
+    //The signed areas of the triangles the origin makes with each edge.
+    double n = e01x * e02y - e01y * e02x;
+    double d012_0 = n * (p1.wx * p2.wy - p1.wy * p2.wx);
+    double d012_1 = n * (p2.wx * p0.wy - p2.wy * p0.wx);
+    double d012_2 = n * (p0.wx * p1.wy - p0.wy * p1.wx);
+
+    if(d01_1 <= 0.0 && d02_2 <= 0.0) {
+        p0.u = 1.0;
+        simplex.count = 1;
+        return;
+    }
+    if(d01_0 > 0.0 && d01_1 > 0.0 && d012_2 <= 0.0) {
+        double inverse = 1.0 / (d01_0 + d01_1);
+        p0.u = d01_0 * inverse;
+        p1.u = d01_1 * inverse;
+        simplex.count = 2;
+        return;
+    }
+    if(d02_0 > 0.0 && d02_2 > 0.0 && d012_1 <= 0.0) {
+        double inverse = 1.0 / (d02_0 + d02_2);
+        p0.u = d02_0 * inverse;
+        p2.u = d02_2 * inverse;
+        p1 = p2;
+        simplex.count = 2;
+        return;
+    }
+    if(d01_0 <= 0.0 && d12_2 <= 0.0) {
+        p1.u = 1.0;
+        p0 = p1;
+        simplex.count = 1;
+        return;
+    }
+    if(d02_0 <= 0.0 && d12_1 <= 0.0) {
+        p2.u = 1.0;
+        p0 = p2;
+        simplex.count = 1;
+        return;
+    }
+    if(d12_1 > 0.0 && d12_2 > 0.0 && d012_0 <= 0.0) {
+        double inverse = 1.0 / (d12_1 + d12_2);
+        p1.u = d12_1 * inverse;
+        p2.u = d12_2 * inverse;
+        p0 = p2;
+        simplex.count = 2;
+        return;
+    }
+    double inverse = 1.0 / (d012_0 + d012_1 + d012_2);
+    p0.u = d012_0 * inverse;
+    p1.u = d012_1 * inverse;
+    p2.u = d012_2 * inverse;
+    simplex.count = 3;
+}
+
+void GJK::GetClosestPoint(const Simplex& simplex, double& x, double& y) {
+    x = 0.0;
+    y = 0.0;
+    for(std::size_t i = 0; i < simplex.count; ++i) {
+        x += simplex.points[i].u * simplex.points[i].wx;
+        y += simplex.points[i].u * simplex.points[i].wy;
+    }
+}
+
+void GJK::GetWitnessPoints(const Simplex& simplex, double& ax, double& ay, double& bx, double& by) {
+    ax = 0.0;
+    ay = 0.0;
+    bx = 0.0;
+    by = 0.0;
+    for(std::size_t i = 0; i < simplex.count; ++i) {
+        const SupportPoint& p = simplex.points[i];
+        ax += p.u * p.ax;
+        ay += p.u * p.ay;
+        bx += p.u * p.bx;
+        by += p.u * p.by;
+    }
+}
+
+void GJK::Expand(const a2de::Shape& a, const a2de::Shape& b, double offset_x, double offset_y, const Simplex& simplex, a2de::Vector2D& normal, double& depth, a2de::Vector2D& point) {
+    SupportPoint polytope[MAX_ITERATIONS + 3];
+    std::size_t count = simplex.count;
+    for(std::size_t i = 0; i < count; ++i) {
+        polytope[i] = simplex.points[i];
+    }
+
+    //GJK stops early when the origin lies on its simplex, so grow it into a triangle first.
+    if(count == 1) {
+        GetSupport(a, b, offset_x, offset_y, 1.0, 0.0, polytope[1]);
+        if(polytope[1].wx == polytope[0].wx && polytope[1].wy == polytope[0].wy) {
+            GetSupport(a, b, offset_x, offset_y, -1.0, 0.0, polytope[1]);
+        }
+        count = 2;
+    }
+    double ex = polytope[1].wx - polytope[0].wx;
+    double ey = polytope[1].wy - polytope[0].wy;
+    double area = 0.0;
+    if(count == 2) {
+        GetSupport(a, b, offset_x, offset_y, -ey, ex, polytope[2]);
+        area = ex * (polytope[2].wy - polytope[0].wy) - ey * (polytope[2].wx - polytope[0].wx);
+        if(std::fabs(area) <= TOLERANCE) {
+            GetSupport(a, b, offset_x, offset_y, ey, -ex, polytope[2]);
+            area = ex * (polytope[2].wy - polytope[0].wy) - ey * (polytope[2].wx - polytope[0].wx);
+        }
+        count = 3;
+    } else {
+        area = ex * (polytope[2].wy - polytope[0].wy) - ey * (polytope[2].wx - polytope[0].wx);
+    }
+
+    //Flat shapes lying along one line only touch; report them with no depth.
+    if(std::fabs(area) <= TOLERANCE) {
+        double length = std::sqrt(ex * ex + ey * ey);
+        double nx = length > 0.0 ? -ey / length : 1.0;
+        double ny = length > 0.0 ? ex / length : 0.0;
+        if(nx * (b.GetPosition().GetX() + offset_x - a.GetPosition().GetX()) + ny * (b.GetPosition().GetY() + offset_y - a.GetPosition().GetY()) < 0.0) {
+            nx = -nx;
+            ny = -ny;
+        }
+        normal = a2de::Vector2D(nx, ny);
+        depth = 0.0;
+        point = a2de::Vector2D((polytope[0].ax + polytope[0].bx) * 0.5, (polytope[0].ay + polytope[0].by) * 0.5);
+        return;
+    }
+
+    //Keep the polytope counter-clockwise so the outward normal of an edge is its right-hand perpendicular.
+    if(area < 0.0) {
+        SupportPoint swap = polytope[1];
+        polytope[1] = polytope[2];
+        polytope[2] = swap;
+    }
+
+    std::size_t edge = 0;
+    double nx = 0.0;
+    double ny = 0.0;
+    double distance = 0.0;
+    for(std::size_t iteration = 0; ; ++iteration) {
+        distance = DBL_MAX;
+        for(std::size_t i = 0; i < count; ++i) {
+            std::size_t j = (i + 1) % count;
+            double dx = polytope[j].wx - polytope[i].wx;
+            double dy = polytope[j].wy - polytope[i].wy;
+            double length = std::sqrt(dx * dx + dy * dy);
+            if(length == 0.0) continue;
+            double edge_nx = dy / length;
+            double edge_ny = -dx / length;
+            double edge_distance = edge_nx * polytope[i].wx + edge_ny * polytope[i].wy;
+            if(edge_distance < distance) {
+                distance = edge_distance;
+                edge = i;
+                nx = edge_nx;
+                ny = edge_ny;
+            }
+        }
+        if(iteration == MAX_ITERATIONS) break;
+
+        SupportPoint next;
+        GetSupport(a, b, offset_x, offset_y, nx, ny, next);
+        if(nx * next.wx + ny * next.wy - distance <= TOLERANCE) break;
+
+        for(std::size_t i = count; i > edge + 1; --i) {
+            polytope[i] = polytope[i - 1];
+        }
+        polytope[edge + 1] = next;
+        ++count;
+    }
+
+    //The nearest edge of b - a faces from b towards a, so the normal from a to b is its reverse.
+    normal = a2de::Vector2D(-nx, -ny);
+    depth = distance < 0.0 ? 0.0 : distance;
+
+    const SupportPoint& p0 = polytope[edge];
+    const SupportPoint& p1 = polytope[(edge + 1) % count];
+    double dx = p1.wx - p0.wx;
+    double dy = p1.wy - p0.wy;
+    double length_squared = dx * dx + dy * dy;
+    double t = length_squared > 0.0 ? -(p0.wx * dx + p0.wy * dy) / length_squared : 0.0;
+    if(t < 0.0) t = 0.0;
+    if(t > 1.0) t = 1.0;
+    double ax = p0.ax + t * (p1.ax - p0.ax);
+    double ay = p0.ay + t * (p1.ay - p0.ay);
+    double bx = p0.bx + t * (p1.bx - p0.bx);
+    double by = p0.by + t * (p1.by - p0.by);
+    point = a2de::Vector2D((ax + bx) * 0.5, (ay + by) * 0.5);
+}
+
+A2DE_END
@@ -0,0 +1,222 @@
+/**************************************************************************************************
+// file:	Engine\Math\GJK.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the GJK class
+ **************************************************************************************************/
+#ifndef A2DE_GJK_H
+#define A2DE_GJK_H
+
+#include "../a2de_vals.h"
+
+#include "CVector2D.h"
+
+A2DE_BEGIN
+
+class Shape;
+
+/**************************************************************************************************
+ * <summary>Collision queries between any two shapes, using nothing but their support points.
+ * GJK walks a simplex of the Minkowski difference towards the origin to find whether two shapes
+ * touch and how far apart they are; EPA then expands that simplex to the face nearest the origin
+ * to find how deep they overlap. Conservative advancement repeats the distance query along a
+ * motion to find the time of impact. All work on convex shapes: a concave shape is tested by its
+ * convex hull. Neither allocates.</summary>
+ * <remarks>Casey Ugone, 8/19/2014.</remarks>
+ **************************************************************************************************/
+class GJK {
+public:
+
+    /// <summary> The most iterations either algorithm takes before giving its best answer </summary>
+    static const std::size_t MAX_ITERATIONS = 32;
+
+    /// <summary> How close, in world units, an answer must come before the search stops </summary>
+    static const double TOLERANCE;
+
+    /**************************************************************************************************
+     * <summary>Query if two shapes touch.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="a">The first shape.</param>
+     * <param name="b">The second shape.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    static bool Intersects(const a2de::Shape& a, const a2de::Shape& b);
+
+    /**************************************************************************************************
+     * <summary>Gets the distance between two shapes and the closest points on each.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="a">      The first shape.</param>
+     * <param name="b">      The second shape.</param>
+     * <param name="point_a">[out] The point of the first shape closest to the second.</param>
+     * <param name="point_b">[out] The point of the second shape closest to the first.</param>
+     * <returns>The distance, zero if the shapes touch.</returns>
+     **************************************************************************************************/
+    static double GetDistance(const a2de::Shape& a, const a2de::Shape& b, a2de::Vector2D& point_a, a2de::Vector2D& point_b);
+
+    /**************************************************************************************************
+     * <summary>Gets how deep two shapes overlap.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="a">     The first shape.</param>
+     * <param name="b">     The second shape.</param>
+     * <param name="normal">[out] The unit normal pointing from the first shape to the second.
+     *                      Moving the second shape along it by the depth separates them.</param>
+     * <param name="depth"> [out] The penetration depth.</param>
+     * <param name="point"> [out] The contact point, midway between the deepest points of each shape.</param>
+     * <returns>true if the shapes touch, false if not. The outputs are only written when they do.</returns>
+     **************************************************************************************************/
+    static bool GetPenetration(const a2de::Shape& a, const a2de::Shape& b, a2de::Vector2D& normal, double& depth, a2de::Vector2D& point);
+
+    /**************************************************************************************************
+     * <summary>Gets when two moving shapes first come within a separation of each other, by
+     * conservative advancement: each step moves the shapes as far as the distance between them
+     * allows without either passing through the other. The shapes only translate.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="a">            The first shape, where it starts.</param>
+     * <param name="translation_a">How far the first shape moves.</param>
+     * <param name="b">            The second shape, where it starts.</param>
+     * <param name="translation_b">How far the second shape moves.</param>
+     * <param name="separation">   The distance at which the shapes count as touching.</param>
+     * <param name="time">         [out] The fraction of the motion at which they touch, 0 if they
+     *                             already do. When the iterations run out it is the last time
+     *                             reached, which is still short of contact.</param>
+     * <param name="normal">       [out] The unit normal pointing from the first shape to the second
+     *                             where they touch.</param>
+     * <returns>true if the shapes touch during the motion, false if not. The outputs are only
+     * written when they do.</returns>
+     **************************************************************************************************/
+    static bool GetTimeOfImpact(const a2de::Shape& a, const a2de::Vector2D& translation_a, const a2de::Shape& b, const a2de::Vector2D& translation_b, double separation, double& time, a2de::Vector2D& normal);
+
+    /**************************************************************************************************
+     * <summary>Gets when two moving shapes first come within a separation of each other, and
+     * where.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="a">            The first shape, where it starts.</param>
+     * <param name="translation_a">How far the first shape moves.</param>
+     * <param name="b">            The second shape, where it starts.</param>
+     * <param name="translation_b">How far the second shape moves.</param>
+     * <param name="separation">   The distance at which the shapes count as touching.</param>
+     * <param name="time">         [out] The fraction of the motion at which they touch.</param>
+     * <param name="normal">       [out] The unit normal pointing from the first shape to the second
+     *                             where they touch.</param>
+     * <param name="point">        [out] The point of the first shape nearest the second at that
+     *                             time, where it has moved to.</param>
+     * <returns>true if the shapes touch during the motion, false if not. The outputs are only
+     * written when they do.</returns>
+     **************************************************************************************************/
+    static bool GetTimeOfImpact(const a2de::Shape& a, const a2de::Vector2D& translation_a, const a2de::Shape& b, const a2de::Vector2D& translation_b, double separation, double& time, a2de::Vector2D& normal, a2de::Vector2D& point);
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>A point of the Minkowski difference b - a and the support points it came from.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     **************************************************************************************************/
+    struct SupportPoint {
+        /// <summary> The x-component of the support point of the first shape </summary>
+        double ax;
+        /// <summary> The y-component of the support point of the first shape </summary>
+        double ay;
+        /// <summary> The x-component of the support point of the second shape </summary>
+        double bx;
+        /// <summary> The y-component of the support point of the second shape </summary>
+        double by;
+        /// <summary> The x-component of the difference </summary>
+        double wx;
+        /// <summary> The y-component of the difference </summary>
+        double wy;
+        /// <summary> The barycentric weight of the point in the simplex </summary>
+        double u;
+    };
+
+    /**************************************************************************************************
+     * <summary>Up to three points of the Minkowski difference.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     **************************************************************************************************/
+    struct Simplex {
+        /// <summary> The points </summary>
+        SupportPoint points[3];
+        /// <summary> The number of points </summary>
+        std::size_t count;
+    };
+
+    /**************************************************************************************************
+     * <summary>Gets the point of the Minkowski difference farthest along a direction.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="a">          The first shape.</param>
+     * <param name="b">          The second shape.</param>
+     * <param name="offset_x">   The x-component of how far the second shape is moved from where it is.</param>
+     * <param name="offset_y">   The y-component of how far the second shape is moved from where it is.</param>
+     * <param name="direction_x">The x-component of the direction.</param>
+     * <param name="direction_y">The y-component of the direction.</param>
+     * <param name="point">      [out] The support point.</param>
+     **************************************************************************************************/
+    static void GetSupport(const a2de::Shape& a, const a2de::Shape& b, double offset_x, double offset_y, double direction_x, double direction_y, SupportPoint& point);
+
+    /**************************************************************************************************
+     * <summary>Runs GJK, leaving the simplex nearest the origin.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="a">       The first shape.</param>
+     * <param name="b">       The second shape.</param>
+     * <param name="offset_x">The x-component of how far the second shape is moved from where it is.</param>
+     * <param name="offset_y">The y-component of how far the second shape is moved from where it is.</param>
+     * <param name="simplex"> [out] The final simplex.</param>
+     * <returns>true if the origin is inside the Minkowski difference, false if not.</returns>
+     **************************************************************************************************/
+    static bool Evolve(const a2de::Shape& a, const a2de::Shape& b, double offset_x, double offset_y, Simplex& simplex);
+
+    /**************************************************************************************************
+     * <summary>Reduces a two point simplex to the feature nearest the origin and weights it.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="simplex">[in,out] The simplex.</param>
+     **************************************************************************************************/
+    static void Solve2(Simplex& simplex);
+
+    /**************************************************************************************************
+     * <summary>Reduces a three point simplex to the feature nearest the origin and weights it. The
+     * simplex keeps all three points when it contains the origin.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="simplex">[in,out] The simplex.</param>
+     **************************************************************************************************/
+    static void Solve3(Simplex& simplex);
+
+    /**************************************************************************************************
+     * <summary>Gets the point of a one or two point simplex nearest the origin.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="simplex">The simplex.</param>
+     * <param name="x">      [out] The x-component.</param>
+     * <param name="y">      [out] The y-component.</param>
+     **************************************************************************************************/
+    static void GetClosestPoint(const Simplex& simplex, double& x, double& y);
+
+    /**************************************************************************************************
+     * <summary>Gets the closest points of the two shapes from the weights of a simplex.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="simplex">The simplex.</param>
+     * <param name="ax">     [out] The x-component of the point on the first shape.</param>
+     * <param name="ay">     [out] The y-component of the point on the first shape.</param>
+     * <param name="bx">     [out] The x-component of the point on the second shape.</param>
+     * <param name="by">     [out] The y-component of the point on the second shape.</param>
+     **************************************************************************************************/
+    static void GetWitnessPoints(const Simplex& simplex, double& ax, double& ay, double& bx, double& by);
+
+    /**************************************************************************************************
+     * <summary>Runs EPA from a simplex that contains the origin.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="a">       The first shape.</param>
+     * <param name="b">       The second shape.</param>
+     * <param name="offset_x">The x-component of how far the second shape is moved from where it is.</param>
+     * <param name="offset_y">The y-component of how far the second shape is moved from where it is.</param>
+     * <param name="simplex"> The simplex GJK finished with.</param>
+     * <param name="normal">  [out] The normal.</param>
+     * <param name="depth">   [out] The depth.</param>
+     * <param name="point">   [out] The contact point.</param>
+     **************************************************************************************************/
+    static void Expand(const a2de::Shape& a, const a2de::Shape& b, double offset_x, double offset_y, const Simplex& simplex, a2de::Vector2D& normal, double& depth, a2de::Vector2D& point);
+
+};
+
+A2DE_END
+
+#endif
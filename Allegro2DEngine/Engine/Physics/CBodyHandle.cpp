@@ -0,0 +1,159 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CBodyHandle.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the body handle class
+ **************************************************************************************************/
+#include "CBodyHandle.h"
+
+#include "CRigidBody.h"
+#include "IBoundingBox.h"
+#include "../Objects/ADTObject.h"
+
+A2DE_BEGIN
+
+double BodyHandle::BOUNDS_MARGIN = 0.1;
+
+BodyHandle::BodyHandle() : _id(0), _object(nullptr), _bounds(), _fat_bounds(), _sleep_time(0.0) {
+    /* DO NOTHING */
+}
+
+BodyHandle::BodyHandle(unsigned long id, a2de::Object* object) : _id(id), _object(object), _bounds(), _fat_bounds(), _sleep_time(0.0) {
+    UpdateBounds();
+    Refit();
+}
+
+BodyHandle::BodyHandle(const BodyHandle& other) : _id(other._id), _object(other._object), _bounds(other._bounds), _fat_bounds(other._fat_bounds), _sleep_time(other._sleep_time) {
+    /* DO NOTHING */
+}
+
+BodyHandle& BodyHandle::operator=(const BodyHandle& rhs) {
+    if(this == &rhs) return *this;
+
+    this->_id = rhs._id;
+    this->_object = rhs._object;
+    this->_bounds = rhs._bounds;
+    this->_fat_bounds = rhs._fat_bounds;
+    this->_sleep_time = rhs._sleep_time;
+
+    return *this;
+}
+
+BodyHandle::~BodyHandle() {
+    _object = nullptr;
+}
+
+unsigned long BodyHandle::GetId() const {
+    return _id;
+}
+
+const a2de::Object* BodyHandle::GetObject() const {
+    return _object;
+}
+
+a2de::Object* BodyHandle::GetObject() {
+    return const_cast<a2de::Object*>(static_cast<const BodyHandle&>(*this).GetObject());
+}
+
+const a2de::RigidBody* BodyHandle::GetBody() const {
+    if(_object == nullptr) return nullptr;
+    return _object->GetBody();
+}
+
+a2de::RigidBody* BodyHandle::GetBody() {
+    return const_cast<a2de::RigidBody*>(static_cast<const BodyHandle&>(*this).GetBody());
+}
+
+const a2de::Rectangle& BodyHandle::GetBounds() const {
+    return _bounds;
+}
+
+a2de::Rectangle& BodyHandle::GetBounds() {
+    return const_cast<a2de::Rectangle&>(static_cast<const BodyHandle&>(*this).GetBounds());
+}
+
+const a2de::Rectangle& BodyHandle::GetFatBounds() const {
+    return _fat_bounds;
+}
+
+a2de::Rectangle& BodyHandle::GetFatBounds() {
+    return const_cast<a2de::Rectangle&>(static_cast<const BodyHandle&>(*this).GetFatBounds());
+}
+
+void BodyHandle::UpdateBounds() {
+    const a2de::RigidBody* body = GetBody();
+    if(body == nullptr) return;
+
+    const a2de::IBoundingBox* bb = body->GetBoundingRectangle();
+    if(bb) {
+        _bounds.SetPosition(bb->GetTransform().GetPosition());
+        _bounds.SetDimensions(bb->GetHalfExtents());
+        return;
+    }
+
+    const a2de::Shape* shape = body->GetCollisionShape();
+    if(shape) {
+        _bounds.SetPosition(shape->GetPosition());
+        _bounds.SetDimensions(shape->GetDimensions());
+        return;
+    }
+
+    _bounds.SetPosition(body->GetPosition());
+    _bounds.SetDimensions(0.0, 0.0);
+}
+
+bool BodyHandle::IsContained() const {
+    double left = _bounds.GetX() - _bounds.GetWidth();
+    double right = _bounds.GetX() + _bounds.GetWidth();
+    double top = _bounds.GetY() - _bounds.GetHeight();
+    double bottom = _bounds.GetY() + _bounds.GetHeight();
+
+    double fat_left = _fat_bounds.GetX() - _fat_bounds.GetWidth();
+    double fat_right = _fat_bounds.GetX() + _fat_bounds.GetWidth();
+    double fat_top = _fat_bounds.GetY() - _fat_bounds.GetHeight();
+    double fat_bottom = _fat_bounds.GetY() + _fat_bounds.GetHeight();
+
+    return fat_left <= left && right <= fat_right && fat_top <= top && bottom <= fat_bottom;
+}
+
+void BodyHandle::Refit() {
+    _fat_bounds.SetPosition(_bounds.GetPosition());
+    _fat_bounds.SetDimensions(_bounds.GetDimensions() + a2de::Vector2D(BOUNDS_MARGIN, BOUNDS_MARGIN));
+}
+
+double BodyHandle::GetBoundsMargin() {
+    return BOUNDS_MARGIN;
+}
+
+void BodyHandle::SetBoundsMargin(double margin) {
+    if(margin < 0.0) return;
+    BOUNDS_MARGIN = margin;
+}
+
+double BodyHandle::GetSleepTime() const {
+    return _sleep_time;
+}
+
+void BodyHandle::SetSleepTime(double sleep_time) {
+    _sleep_time = sleep_time;
+}
+
+bool BodyHandle::operator==(const BodyHandle& rhs) const {
+    return _id == rhs._id;
+}
+
+bool BodyHandle::operator<(const BodyHandle& rhs) const {
+    return _id < rhs._id;
+}
+
+const a2de::Rectangle& bounds_of(a2de::BodyHandle* handle) {
+    return handle->GetFatBounds();
+}
+
+void refit(a2de::BodyHandle* handle) {
+    handle->UpdateBounds();
+    handle->Refit();
+}
+
+A2DE_END
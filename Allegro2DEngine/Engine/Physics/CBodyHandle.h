@@ -0,0 +1,224 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CBodyHandle.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the body handle class
+ **************************************************************************************************/
+#ifndef A2DE_CBODYHANDLE_H
+#define A2DE_CBODYHANDLE_H
+
+#include "../a2de_vals.h"
+#include "../Math/CRectangle.h"
+
+A2DE_BEGIN
+
+class Object;
+class RigidBody;
+
+/**************************************************************************************************
+ * <summary>A stable, world-assigned handle to an Object's body and its cached axis-aligned bounds.
+ * The broadphase stores handles instead of positions so candidate pairs resolve directly to their
+ * bodies. Handles are stored under fattened bounds so a body only has to be reinserted once it
+ * moves outside of them.</summary>
+ * <remarks>Casey Ugone, 7/20/2014.</remarks>
+ **************************************************************************************************/
+class BodyHandle {
+public:
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     **************************************************************************************************/
+    BodyHandle();
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="id">    The world-unique identifier of the handle.</param>
+     * <param name="object">[in,out] If non-null, the object that owns the body.</param>
+     **************************************************************************************************/
+    BodyHandle(unsigned long id, a2de::Object* object);
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    BodyHandle(const BodyHandle& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    BodyHandle& operator=(const BodyHandle& rhs);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     **************************************************************************************************/
+    ~BodyHandle();
+
+    /**************************************************************************************************
+     * <summary>Gets the identifier.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>The identifier.</returns>
+     **************************************************************************************************/
+    unsigned long GetId() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the object.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>null if it fails, else the object.</returns>
+     **************************************************************************************************/
+    const a2de::Object* GetObject() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the object.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>null if it fails, else the object.</returns>
+     **************************************************************************************************/
+    a2de::Object* GetObject();
+
+    /**************************************************************************************************
+     * <summary>Gets the body of the object.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>null if the object has no body, else the body.</returns>
+     **************************************************************************************************/
+    const a2de::RigidBody* GetBody() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the body of the object.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>null if the object has no body, else the body.</returns>
+     **************************************************************************************************/
+    a2de::RigidBody* GetBody();
+
+    /**************************************************************************************************
+     * <summary>Gets the cached bounds.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    const a2de::Rectangle& GetBounds() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the cached bounds.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    a2de::Rectangle& GetBounds();
+
+    /**************************************************************************************************
+     * <summary>Gets the fattened bounds the handle is stored under.</summary>
+     * <remarks>Casey Ugone, 7/24/2014.</remarks>
+     * <returns>The fat bounds.</returns>
+     **************************************************************************************************/
+    const a2de::Rectangle& GetFatBounds() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the fattened bounds the handle is stored under.</summary>
+     * <remarks>Casey Ugone, 7/24/2014.</remarks>
+     * <returns>The fat bounds.</returns>
+     **************************************************************************************************/
+    a2de::Rectangle& GetFatBounds();
+
+    /**************************************************************************************************
+     * <summary>Recalculates the cached bounds from the body's bounding rectangle, falling back to the
+     * collision shape and then the position. The fat bounds are left alone.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     **************************************************************************************************/
+    void UpdateBounds();
+
+    /**************************************************************************************************
+     * <summary>Query if the fat bounds still enclose the cached bounds.</summary>
+     * <remarks>Casey Ugone, 7/24/2014.</remarks>
+     * <returns>true if the handle does not need to be reinserted, false if it does.</returns>
+     **************************************************************************************************/
+    bool IsContained() const;
+
+    /**************************************************************************************************
+     * <summary>Resets the fat bounds to the cached bounds grown by the bounds margin.</summary>
+     * <remarks>Casey Ugone, 7/24/2014.</remarks>
+     **************************************************************************************************/
+    void Refit();
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds margin.</summary>
+     * <remarks>Casey Ugone, 7/24/2014.</remarks>
+     * <returns>The distance in meters the fat bounds extend past the cached bounds.</returns>
+     **************************************************************************************************/
+    static double GetBoundsMargin();
+
+    /**************************************************************************************************
+     * <summary>Sets the bounds margin. Takes effect as handles are refit.</summary>
+     * <remarks>Casey Ugone, 7/24/2014.</remarks>
+     * <param name="margin">The distance in meters the fat bounds extend past the cached bounds.</param>
+     **************************************************************************************************/
+    static void SetBoundsMargin(double margin);
+
+    /**************************************************************************************************
+     * <summary>Gets how long the body has been resting.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <returns>The time in seconds the body's energy has stayed below the world's sleep threshold.</returns>
+     **************************************************************************************************/
+    double GetSleepTime() const;
+
+    /**************************************************************************************************
+     * <summary>Sets how long the body has been resting.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <param name="sleep_time">The time in seconds.</param>
+     **************************************************************************************************/
+    void SetSleepTime(double sleep_time);
+
+    /**************************************************************************************************
+     * <summary>Equality operator.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>true if the handles refer to the same id.</returns>
+     **************************************************************************************************/
+    bool operator==(const BodyHandle& rhs) const;
+
+    /**************************************************************************************************
+     * <summary>Less-than comparison operator.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>true if this handle's id is less than rhs's id.</returns>
+     **************************************************************************************************/
+    bool operator<(const BodyHandle& rhs) const;
+
+protected:
+private:
+    /// <summary> The identifier </summary>
+    unsigned long _id;
+    /// <summary> The object </summary>
+    a2de::Object* _object;
+    /// <summary> The cached bounds </summary>
+    a2de::Rectangle _bounds;
+    /// <summary> The fattened bounds </summary>
+    a2de::Rectangle _fat_bounds;
+    /// <summary> The time the body has been resting </summary>
+    double _sleep_time;
+    /// <summary> The bounds margin </summary>
+    static double BOUNDS_MARGIN;
+};
+
+/**************************************************************************************************
+ * <summary>Gets the extents a spatial partition stores a handle under.</summary>
+ * <remarks>Casey Ugone, 7/20/2014.</remarks>
+ * <param name="handle">[in,out] The handle.</param>
+ * <returns>The fat bounds of the handle.</returns>
+ **************************************************************************************************/
+const a2de::Rectangle& bounds_of(a2de::BodyHandle* handle);
+
+/**************************************************************************************************
+ * <summary>Refits a handle while a spatial partition is updating it.</summary>
+ * <remarks>Casey Ugone, 7/24/2014.</remarks>
+ * <param name="handle">[in,out] The handle.</param>
+ **************************************************************************************************/
+void refit(a2de::BodyHandle* handle);
+
+A2DE_END
+
+#endif
@@ -0,0 +1,402 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CBodyStore.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the body store class
+ **************************************************************************************************/
+#include "CBodyStore.h"
+
+#include "CRigidBody.h"
+#include "../Math/MiscMath.h"
+#include "../Math/MathConstants.h"
+
+#include <cmath>
+
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#  include <emmintrin.h>
+#  define A2DE_SIMD_SSE2
+#endif
+
+A2DE_BEGIN
+
+BodyStore::BodyStore() : _position_x(), _position_y(), _velocity_x(), _velocity_y(), _acceleration_x(), _acceleration_y(), _force_x(), _force_y(), _gravity_modifier_x(), _gravity_modifier_y(), _gravity_scale_x(), _gravity_scale_y(), _drag_scale(), _inverse_masses(), _flags(), _bodies() {
+    /* DO NOTHING */
+}
+
+BodyStore::~BodyStore() {
+    Clear();
+}
+
+void BodyStore::Attach(std::size_t index, a2de::RigidBody* body) {
+    if(body == nullptr) return;
+    if(index < _bodies.size() && _bodies[index] == body) return;
+    if(index < _bodies.size() && _bodies[index] != nullptr) Detach(index);
+
+    if(index >= _bodies.size()) {
+        std::size_t size = index + 1;
+        _position_x.resize(size, 0.0);
+        _position_y.resize(size, 0.0);
+        _velocity_x.resize(size, 0.0);
+        _velocity_y.resize(size, 0.0);
+        _acceleration_x.resize(size, 0.0);
+        _acceleration_y.resize(size, 0.0);
+        _force_x.resize(size, 0.0);
+        _force_y.resize(size, 0.0);
+        _gravity_modifier_x.resize(size, 0.0);
+        _gravity_modifier_y.resize(size, 0.0);
+        _gravity_scale_x.resize(size, 0.0);
+        _gravity_scale_y.resize(size, 0.0);
+        _drag_scale.resize(size, 0.0);
+        _inverse_masses.resize(size, 0.0);
+        _flags.resize(size, 0);
+        _bodies.resize(size, nullptr);
+    }
+
+    //The body detaches from wherever it was before it copies its data in.
+    body->Attach(this, index);
+    _bodies[index] = body;
+    _flags[index] |= FLAG_USED;
+    UpdateGravityScale(index);
+}
+
+void BodyStore::Detach(std::size_t index) {
+    if(index >= _bodies.size()) return;
+    a2de::RigidBody* body = _bodies[index];
+    if(body == nullptr) return;
+
+    body->Detach();
+    _bodies[index] = nullptr;
+    _position_x[index] = 0.0;
+    _position_y[index] = 0.0;
+    _velocity_x[index] = 0.0;
+    _velocity_y[index] = 0.0;
+    _acceleration_x[index] = 0.0;
+    _acceleration_y[index] = 0.0;
+    _force_x[index] = 0.0;
+    _force_y[index] = 0.0;
+    _gravity_modifier_x[index] = 0.0;
+    _gravity_modifier_y[index] = 0.0;
+    _gravity_scale_x[index] = 0.0;
+    _gravity_scale_y[index] = 0.0;
+    _drag_scale[index] = 0.0;
+    _inverse_masses[index] = 0.0;
+    _flags[index] = 0;
+}
+
+void BodyStore::Clear() {
+    for(std::size_t i = 0; i < _bodies.size(); ++i) {
+        Detach(i);
+    }
+    _position_x.clear();
+    _position_y.clear();
+    _velocity_x.clear();
+    _velocity_y.clear();
+    _acceleration_x.clear();
+    _acceleration_y.clear();
+    _force_x.clear();
+    _force_y.clear();
+    _gravity_modifier_x.clear();
+    _gravity_modifier_y.clear();
+    _gravity_scale_x.clear();
+    _gravity_scale_y.clear();
+    _drag_scale.clear();
+    _inverse_masses.clear();
+    _flags.clear();
+    _bodies.clear();
+}
+
+void BodyStore::Integrate(std::size_t first, std::size_t last, double deltaTime) {
+    IntegrateRange(first, last, deltaTime, 0.0, 0.0);
+}
+
+void BodyStore::Integrate(std::size_t first, std::size_t last, double deltaTime, const a2de::Vector2D& gravity) {
+    IntegrateRange(first, last, deltaTime, gravity.GetX(), gravity.GetY());
+}
+
+void BodyStore::IntegrateRange(std::size_t first, std::size_t last, double deltaTime, double gravity_x, double gravity_y) {
+    if(last > _bodies.size()) last = _bodies.size();
+    if(first >= last) return;
+
+    //Slots that must not move get zero velocity and force, which lets the kernel run over every slot
+    //without a branch: a = 0 * m^-1, v = 0, p = p.
+    for(std::size_t i = first; i < last; ++i) {
+        unsigned char flags = _flags[i];
+        if((flags & FLAG_USED) == 0) continue;
+        if((flags & FLAG_FORCED) != 0) _bodies[i]->CollectForces(deltaTime);
+        if((_flags[i] & FLAG_ACTIVE) != 0 && (_flags[i] & FLAG_STATIC) == 0) continue;
+        _velocity_x[i] = 0.0;
+        _velocity_y[i] = 0.0;
+        _acceleration_x[i] = 0.0;
+        _acceleration_y[i] = 0.0;
+        _force_x[i] = 0.0;
+        _force_y[i] = 0.0;
+        _flags[i] &= ~FLAG_ACTIVE;
+        UpdateGravityScale(i);
+    }
+
+    //Integrate from constant acceleration. Gravity rides along as a force per unit of gravity, which is
+    //zero for every slot that must not move.
+    //a = (F + g * s) / m
+    //v = at + v;
+    //p = (1/2)at^2 + vt + p
+    double* px = &_position_x[0];
+    double* py = &_position_y[0];
+    double* vx = &_velocity_x[0];
+    double* vy = &_velocity_y[0];
+    double* ax = &_acceleration_x[0];
+    double* ay = &_acceleration_y[0];
+    double* fx = &_force_x[0];
+    double* fy = &_force_y[0];
+    const double* gsx = &_gravity_scale_x[0];
+    const double* gsy = &_gravity_scale_y[0];
+    const double* im = &_inverse_masses[0];
+    double half_dt_squared = 0.5 * deltaTime * deltaTime;
+    std::size_t k = first;
+#if defined(A2DE_SIMD_SSE2)
+    __m128d dt = _mm_set1_pd(deltaTime);
+    __m128d hdt2 = _mm_set1_pd(half_dt_squared);
+    __m128d zero = _mm_setzero_pd();
+    __m128d grav_x = _mm_set1_pd(gravity_x);
+    __m128d grav_y = _mm_set1_pd(gravity_y);
+    for(; k + 2 <= last; k += 2) {
+        __m128d inv_mass = _mm_loadu_pd(im + k);
+        __m128d acc_x = _mm_mul_pd(_mm_add_pd(_mm_loadu_pd(fx + k), _mm_mul_pd(grav_x, _mm_loadu_pd(gsx + k))), inv_mass);
+        __m128d acc_y = _mm_mul_pd(_mm_add_pd(_mm_loadu_pd(fy + k), _mm_mul_pd(grav_y, _mm_loadu_pd(gsy + k))), inv_mass);
+        __m128d vel_x = _mm_add_pd(_mm_loadu_pd(vx + k), _mm_mul_pd(acc_x, dt));
+        __m128d vel_y = _mm_add_pd(_mm_loadu_pd(vy + k), _mm_mul_pd(acc_y, dt));
+        __m128d pos_x = _mm_add_pd(_mm_loadu_pd(px + k), _mm_add_pd(_mm_mul_pd(acc_x, hdt2), _mm_mul_pd(vel_x, dt)));
+        __m128d pos_y = _mm_add_pd(_mm_loadu_pd(py + k), _mm_add_pd(_mm_mul_pd(acc_y, hdt2), _mm_mul_pd(vel_y, dt)));
+        _mm_storeu_pd(ax + k, acc_x);
+        _mm_storeu_pd(ay + k, acc_y);
+        _mm_storeu_pd(vx + k, vel_x);
+        _mm_storeu_pd(vy + k, vel_y);
+        _mm_storeu_pd(px + k, pos_x);
+        _mm_storeu_pd(py + k, pos_y);
+        _mm_storeu_pd(fx + k, zero);
+        _mm_storeu_pd(fy + k, zero);
+    }
+#endif
+    for(; k < last; ++k) {
+        ax[k] = (fx[k] + gravity_x * gsx[k]) * im[k];
+        ay[k] = (fy[k] + gravity_y * gsy[k]) * im[k];
+        vx[k] += ax[k] * deltaTime;
+        vy[k] += ay[k] * deltaTime;
+        px[k] += ax[k] * half_dt_squared + vx[k] * deltaTime;
+        py[k] += ay[k] * half_dt_squared + vy[k] * deltaTime;
+        fx[k] = 0.0;
+        fy[k] = 0.0;
+    }
+
+    //Put to sleep what came to rest and carry the shapes of what moved.
+    for(std::size_t i = first; i < last; ++i) {
+        unsigned char flags = _flags[i];
+        if((flags & FLAG_USED) == 0 || (flags & FLAG_ACTIVE) == 0) continue;
+        bool at_rest = (flags & FLAG_FORCED) == 0 &&
+                       a2de::Math::IsEqual(ax[i], 0.0) && a2de::Math::IsEqual(ay[i], 0.0) &&
+                       a2de::Math::IsEqual(vx[i], 0.0) && a2de::Math::IsEqual(vy[i], 0.0);
+        if(at_rest) {
+            vx[i] = 0.0;
+            vy[i] = 0.0;
+            ax[i] = 0.0;
+            ay[i] = 0.0;
+            _flags[i] &= ~FLAG_ACTIVE;
+            UpdateGravityScale(i);
+        }
+        _bodies[i]->UpdateShapes();
+    }
+}
+
+void BodyStore::ApplyGravity(std::size_t first, std::size_t last, const a2de::Vector2D& gravity) {
+    if(last > _bodies.size()) last = _bodies.size();
+    if(first >= last) return;
+
+    double gravity_x = gravity.GetX();
+    double gravity_y = gravity.GetY();
+    double* fx = &_force_x[0];
+    double* fy = &_force_y[0];
+    const double* gsx = &_gravity_scale_x[0];
+    const double* gsy = &_gravity_scale_y[0];
+    std::size_t k = first;
+#if defined(A2DE_SIMD_SSE2)
+    __m128d grav_x = _mm_set1_pd(gravity_x);
+    __m128d grav_y = _mm_set1_pd(gravity_y);
+    for(; k + 2 <= last; k += 2) {
+        _mm_storeu_pd(fx + k, _mm_add_pd(_mm_loadu_pd(fx + k), _mm_mul_pd(grav_x, _mm_loadu_pd(gsx + k))));
+        _mm_storeu_pd(fy + k, _mm_add_pd(_mm_loadu_pd(fy + k), _mm_mul_pd(grav_y, _mm_loadu_pd(gsy + k))));
+    }
+#endif
+    for(; k < last; ++k) {
+        fx[k] += gravity_x * gsx[k];
+        fy[k] += gravity_y * gsy[k];
+    }
+}
+
+void BodyStore::ApplyDrag(std::size_t first, std::size_t last, double k1, double k2) {
+    if(last > _bodies.size()) last = _bodies.size();
+    if(first >= last) return;
+
+    //The drag k1 * |v| + k2 * |v|^2 along -v / |v| is -v * (k1 + k2 * |v|), which needs no branch at rest.
+    //The drag scale zeroes it for slots that are not subscribed.
+    const double* vx = &_velocity_x[0];
+    const double* vy = &_velocity_y[0];
+    const double* ds = &_drag_scale[0];
+    double* fx = &_force_x[0];
+    double* fy = &_force_y[0];
+    std::size_t k = first;
+#if defined(A2DE_SIMD_SSE2)
+    __m128d linear = _mm_set1_pd(k1);
+    __m128d quadratic = _mm_set1_pd(k2);
+    for(; k + 2 <= last; k += 2) {
+        __m128d vel_x = _mm_loadu_pd(vx + k);
+        __m128d vel_y = _mm_loadu_pd(vy + k);
+        __m128d speed = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(vel_x, vel_x), _mm_mul_pd(vel_y, vel_y)));
+        __m128d coefficient = _mm_mul_pd(_mm_add_pd(linear, _mm_mul_pd(quadratic, speed)), _mm_loadu_pd(ds + k));
+        _mm_storeu_pd(fx + k, _mm_sub_pd(_mm_loadu_pd(fx + k), _mm_mul_pd(vel_x, coefficient)));
+        _mm_storeu_pd(fy + k, _mm_sub_pd(_mm_loadu_pd(fy + k), _mm_mul_pd(vel_y, coefficient)));
+    }
+#endif
+    for(; k < last; ++k) {
+        double speed = std::sqrt(vx[k] * vx[k] + vy[k] * vy[k]);
+        double coefficient = (k1 + k2 * speed) * ds[k];
+        fx[k] -= vx[k] * coefficient;
+        fy[k] -= vy[k] * coefficient;
+    }
+}
+
+void BodyStore::SetGravitySubscribed(std::size_t index, bool subscribed) {
+    if(subscribed) {
+        _flags[index] |= FLAG_GRAVITY;
+    } else {
+        _flags[index] &= ~FLAG_GRAVITY;
+    }
+    UpdateGravityScale(index);
+}
+
+void BodyStore::SetDragSubscribed(std::size_t index, bool subscribed) {
+    if(subscribed) {
+        _flags[index] |= FLAG_DRAG;
+    } else {
+        _flags[index] &= ~FLAG_DRAG;
+    }
+    _drag_scale[index] = subscribed ? 1.0 : 0.0;
+}
+
+bool BodyStore::GetIndex(const a2de::RigidBody* body, std::size_t& index) const {
+    if(body == nullptr || body->_store != this) return false;
+    index = body->_store_index;
+    return true;
+}
+
+std::size_t BodyStore::GetSize() const {
+    return _bodies.size();
+}
+
+bool BodyStore::IsUsed(std::size_t index) const {
+    return index < _flags.size() && (_flags[index] & FLAG_USED) != 0;
+}
+
+const a2de::RigidBody* BodyStore::GetBody(std::size_t index) const {
+    if(index >= _bodies.size()) return nullptr;
+    return _bodies[index];
+}
+
+a2de::RigidBody* BodyStore::GetBody(std::size_t index) {
+    return const_cast<a2de::RigidBody*>(static_cast<const BodyStore&>(*this).GetBody(index));
+}
+
+double BodyStore::CalculateInverseMass(double mass) {
+    if(a2de::Math::IsEqual(mass, 0.0) || a2de::Math::IsEqual(mass, a2de::Math::A2DE_INFINITY)) return 0.0;
+    return 1.0 / mass;
+}
+
+void BodyStore::SetMass(std::size_t index, double mass) {
+    _inverse_masses[index] = CalculateInverseMass(mass);
+    //Only zero mass is held in place. Infinite mass keeps its velocity but no force can change it.
+    if(a2de::Math::IsEqual(mass, 0.0)) {
+        _flags[index] |= FLAG_STATIC;
+    } else {
+        _flags[index] &= ~FLAG_STATIC;
+    }
+    UpdateGravityScale(index);
+}
+
+void BodyStore::SetGravityModifier(std::size_t index, const a2de::Vector2D& gravity_modifier) {
+    _gravity_modifier_x[index] = gravity_modifier.GetX();
+    _gravity_modifier_y[index] = gravity_modifier.GetY();
+    UpdateGravityScale(index);
+}
+
+void BodyStore::UpdateGravityScale(std::size_t index) {
+    //Kept at zero for what gravity must not move, or is not subscribed to it, so the kernels can run over
+    //every slot without a branch.
+    unsigned char flags = _flags[index];
+    double inverse_mass = _inverse_masses[index];
+    bool moves = (flags & FLAG_USED) != 0 && (flags & FLAG_ACTIVE) != 0 && (flags & FLAG_STATIC) == 0 && (flags & FLAG_GRAVITY) != 0 && inverse_mass > 0.0;
+    _gravity_scale_x[index] = moves ? _gravity_modifier_x[index] / inverse_mass : 0.0;
+    _gravity_scale_y[index] = moves ? _gravity_modifier_y[index] / inverse_mass : 0.0;
+}
+
+bool BodyStore::IsActive(std::size_t index) const {
+    return (_flags[index] & FLAG_ACTIVE) != 0;
+}
+
+void BodyStore::SetActive(std::size_t index, bool active) {
+    if(active) {
+        _flags[index] |= FLAG_ACTIVE;
+    } else {
+        _flags[index] &= ~FLAG_ACTIVE;
+    }
+    UpdateGravityScale(index);
+}
+
+void BodyStore::SetForced(std::size_t index, bool forced) {
+    if(forced) {
+        _flags[index] |= FLAG_FORCED;
+    } else {
+        _flags[index] &= ~FLAG_FORCED;
+    }
+}
+
+a2de::Vector2D BodyStore::GetPosition(std::size_t index) const {
+    return a2de::Vector2D(_position_x[index], _position_y[index]);
+}
+
+void BodyStore::SetPosition(std::size_t index, const a2de::Vector2D& position) {
+    _position_x[index] = position.GetX();
+    _position_y[index] = position.GetY();
+}
+
+a2de::Vector2D BodyStore::GetVelocity(std::size_t index) const {
+    return a2de::Vector2D(_velocity_x[index], _velocity_y[index]);
+}
+
+void BodyStore::SetVelocity(std::size_t index, const a2de::Vector2D& velocity) {
+    _velocity_x[index] = velocity.GetX();
+    _velocity_y[index] = velocity.GetY();
+}
+
+a2de::Vector2D BodyStore::GetAcceleration(std::size_t index) const {
+    return a2de::Vector2D(_acceleration_x[index], _acceleration_y[index]);
+}
+
+void BodyStore::SetAcceleration(std::size_t index, const a2de::Vector2D& acceleration) {
+    _acceleration_x[index] = acceleration.GetX();
+    _acceleration_y[index] = acceleration.GetY();
+}
+
+a2de::Vector2D BodyStore::GetForce(std::size_t index) const {
+    return a2de::Vector2D(_force_x[index], _force_y[index]);
+}
+
+void BodyStore::SetForce(std::size_t index, const a2de::Vector2D& force) {
+    _force_x[index] = force.GetX();
+    _force_y[index] = force.GetY();
+}
+
+void BodyStore::AddForce(std::size_t index, const a2de::Vector2D& force) {
+    _force_x[index] += force.GetX();
+    _force_y[index] += force.GetY();
+}
+
+A2DE_END
@@ -0,0 +1,376 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CBodyStore.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the body store class
+ **************************************************************************************************/
+#ifndef A2DE_CBODYSTORE_H
+#define A2DE_CBODYSTORE_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+class RigidBody;
+
+/**************************************************************************************************
+ * <summary>The kinematic data of every body in a World, one contiguous array per field and
+ * component. A slot is indexed by the id of the body's handle. While a RigidBody is attached it is
+ * only a handle: its position, velocity, acceleration, pending impulses and sleep state live here, and
+ * its State keeps the material, shapes and timed forces.</summary>
+ * <remarks>Casey Ugone, 8/11/2014.</remarks>
+ **************************************************************************************************/
+class BodyStore {
+public:
+
+    /**************************************************************************************************
+     * <summary>Values that represent the bits of a slot's flags.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     **************************************************************************************************/
+    enum FLAG {
+        FLAG_USED = 0x01,
+        FLAG_ACTIVE = 0x02,
+        FLAG_STATIC = 0x04,
+        FLAG_FORCED = 0x08,
+        FLAG_GRAVITY = 0x10,
+        FLAG_DRAG = 0x20,
+    };
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     **************************************************************************************************/
+    BodyStore();
+
+    /**************************************************************************************************
+     * <summary>Destructor. Detaches every body.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     **************************************************************************************************/
+    ~BodyStore();
+
+    /**************************************************************************************************
+     * <summary>Moves a body's kinematic data into a slot. A body attached elsewhere is detached
+     * first.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot, usually the id of the body's handle.</param>
+     * <param name="body"> [in,out] The body.</param>
+     **************************************************************************************************/
+    void Attach(std::size_t index, a2de::RigidBody* body);
+
+    /**************************************************************************************************
+     * <summary>Moves a slot's data back into its body and frees the slot.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot.</param>
+     **************************************************************************************************/
+    void Detach(std::size_t index);
+
+    /**************************************************************************************************
+     * <summary>Detaches every body.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Integrates a range of slots from constant acceleration, puts to sleep those that came
+     * to rest and moves the shapes of the rest. Unused, sleeping and static slots do not move. Touches
+     * nothing outside of the range, so disjoint ranges may run on different threads.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="first">    The first slot.</param>
+     * <param name="last">     One past the last slot.</param>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void Integrate(std::size_t first, std::size_t last, double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Integrates a range of slots as Integrate does, adding gravity, scaled by each slot's
+     * gravity modifier, straight to the acceleration instead of going through the force
+     * accumulator.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="first">    The first slot.</param>
+     * <param name="last">     One past the last slot.</param>
+     * <param name="deltaTime">Time since the last frame.</param>
+     * <param name="gravity">  The acceleration of gravity.</param>
+     **************************************************************************************************/
+    void Integrate(std::size_t first, std::size_t last, double deltaTime, const a2de::Vector2D& gravity);
+
+    /**************************************************************************************************
+     * <summary>Adds the force of gravity, scaled by each slot's gravity modifier and mass, to the
+     * accumulator of every awake dynamic slot in a range that is subscribed to gravity.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="first">  The first slot.</param>
+     * <param name="last">   One past the last slot.</param>
+     * <param name="gravity">The acceleration of gravity.</param>
+     **************************************************************************************************/
+    void ApplyGravity(std::size_t first, std::size_t last, const a2de::Vector2D& gravity);
+
+    /**************************************************************************************************
+     * <summary>Adds a drag force of k1 * |v| + k2 * |v|^2 against the velocity to the accumulator of
+     * every slot in a range that is subscribed to drag. Slots at rest get none.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="first">The first slot.</param>
+     * <param name="last"> One past the last slot.</param>
+     * <param name="k1">   The linear drag coefficient.</param>
+     * <param name="k2">   The quadratic drag coefficient.</param>
+     **************************************************************************************************/
+    void ApplyDrag(std::size_t first, std::size_t last, double k1, double k2);
+
+    /**************************************************************************************************
+     * <summary>Sets whether gravity applied over the store reaches a slot. Mirrors the subscribers of
+     * a gravity generator; a slot starts unsubscribed.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="index">     The slot.</param>
+     * <param name="subscribed">true if gravity reaches the slot.</param>
+     **************************************************************************************************/
+    void SetGravitySubscribed(std::size_t index, bool subscribed);
+
+    /**************************************************************************************************
+     * <summary>Sets whether drag applied over the store reaches a slot. Mirrors the subscribers of a
+     * drag generator; a slot starts unsubscribed.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="index">     The slot.</param>
+     * <param name="subscribed">true if drag reaches the slot.</param>
+     **************************************************************************************************/
+    void SetDragSubscribed(std::size_t index, bool subscribed);
+
+    /**************************************************************************************************
+     * <summary>Gets the slot a body is attached to.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="body"> The body.</param>
+     * <param name="index">[out] The slot.</param>
+     * <returns>true if the body is attached to this store, false if not.</returns>
+     **************************************************************************************************/
+    bool GetIndex(const a2de::RigidBody* body, std::size_t& index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of slots, used or not.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <returns>The size.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+    /**************************************************************************************************
+     * <summary>Query if a slot holds a body.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>true if used, false if not.</returns>
+     **************************************************************************************************/
+    bool IsUsed(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the body attached to a slot.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>null if the slot is free, else the body.</returns>
+     **************************************************************************************************/
+    const a2de::RigidBody* GetBody(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the body attached to a slot.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>null if the slot is free, else the body.</returns>
+     **************************************************************************************************/
+    a2de::RigidBody* GetBody(std::size_t index);
+
+    /**************************************************************************************************
+     * <summary>Sets the mass of a slot, updating its inverse mass and whether it is static.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <param name="mass"> The mass. Zero is static and infinite mass does not accelerate.</param>
+     **************************************************************************************************/
+    void SetMass(std::size_t index, double mass);
+
+    /**************************************************************************************************
+     * <summary>Sets the gravity modifier of a slot.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="index">           The slot.</param>
+     * <param name="gravity_modifier">The gravity modifier.</param>
+     **************************************************************************************************/
+    void SetGravityModifier(std::size_t index, const a2de::Vector2D& gravity_modifier);
+
+    /**************************************************************************************************
+     * <summary>Query if a slot is awake.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>true if active, false if asleep.</returns>
+     **************************************************************************************************/
+    bool IsActive(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Wakes or puts to sleep a slot.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index"> The slot.</param>
+     * <param name="active">true to wake, false to sleep.</param>
+     **************************************************************************************************/
+    void SetActive(std::size_t index, bool active);
+
+    /**************************************************************************************************
+     * <summary>Marks whether a slot still has timed forces acting on it, which keeps it from
+     * resting.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="index"> The slot.</param>
+     * <param name="forced">true if forces remain.</param>
+     **************************************************************************************************/
+    void SetForced(std::size_t index, bool forced);
+
+    /**************************************************************************************************
+     * <summary>Gets the position of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>The position.</returns>
+     **************************************************************************************************/
+    a2de::Vector2D GetPosition(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Sets the position of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">   The slot.</param>
+     * <param name="position">The position.</param>
+     **************************************************************************************************/
+    void SetPosition(std::size_t index, const a2de::Vector2D& position);
+
+    /**************************************************************************************************
+     * <summary>Gets the velocity of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>The velocity.</returns>
+     **************************************************************************************************/
+    a2de::Vector2D GetVelocity(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Sets the velocity of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">   The slot.</param>
+     * <param name="velocity">The velocity.</param>
+     **************************************************************************************************/
+    void SetVelocity(std::size_t index, const a2de::Vector2D& velocity);
+
+    /**************************************************************************************************
+     * <summary>Gets the acceleration of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>The acceleration.</returns>
+     **************************************************************************************************/
+    a2de::Vector2D GetAcceleration(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Sets the acceleration of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">       The slot.</param>
+     * <param name="acceleration">The acceleration.</param>
+     **************************************************************************************************/
+    void SetAcceleration(std::size_t index, const a2de::Vector2D& acceleration);
+
+    /**************************************************************************************************
+     * <summary>Gets the accumulated force of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <returns>The accumulated force.</returns>
+     **************************************************************************************************/
+    a2de::Vector2D GetForce(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Sets the accumulated force of a slot.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <param name="force">The accumulated force.</param>
+     **************************************************************************************************/
+    void SetForce(std::size_t index, const a2de::Vector2D& force);
+
+    /**************************************************************************************************
+     * <summary>Adds to the accumulated force of a slot. Integration empties the accumulator.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="index">The slot.</param>
+     * <param name="force">The force.</param>
+     **************************************************************************************************/
+    void AddForce(std::size_t index, const a2de::Vector2D& force);
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Calculates the inverse of a mass.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="mass">The mass.</param>
+     * <returns>Zero for zero or infinite mass, else one over the mass.</returns>
+     **************************************************************************************************/
+    static double CalculateInverseMass(double mass);
+
+    /**************************************************************************************************
+     * <summary>Recalculates the gravity scale of a slot after its mass, gravity modifier or flags
+     * changed.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="index">The slot.</param>
+     **************************************************************************************************/
+    void UpdateGravityScale(std::size_t index);
+
+    /**************************************************************************************************
+     * <summary>Runs the integration kernel over a range of slots.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="first">    The first slot.</param>
+     * <param name="last">     One past the last slot.</param>
+     * <param name="deltaTime">Time since the last frame.</param>
+     * <param name="gravity_x">The x-component of gravity added to the acceleration.</param>
+     * <param name="gravity_y">The y-component of gravity added to the acceleration.</param>
+     **************************************************************************************************/
+    void IntegrateRange(std::size_t first, std::size_t last, double deltaTime, double gravity_x, double gravity_y);
+
+    /// <summary> The x-coordinate of the position of each slot </summary>
+    std::vector<double> _position_x;
+    /// <summary> The y-coordinate of the position of each slot </summary>
+    std::vector<double> _position_y;
+    /// <summary> The x-component of the velocity of each slot </summary>
+    std::vector<double> _velocity_x;
+    /// <summary> The y-component of the velocity of each slot </summary>
+    std::vector<double> _velocity_y;
+    /// <summary> The x-component of the acceleration of each slot from its last integration </summary>
+    std::vector<double> _acceleration_x;
+    /// <summary> The y-component of the acceleration of each slot from its last integration </summary>
+    std::vector<double> _acceleration_y;
+    /// <summary> The x-component of the force accumulated by each slot since its last integration </summary>
+    std::vector<double> _force_x;
+    /// <summary> The y-component of the force accumulated by each slot since its last integration </summary>
+    std::vector<double> _force_y;
+    /// <summary> The x-component of the gravity modifier of each slot </summary>
+    std::vector<double> _gravity_modifier_x;
+    /// <summary> The y-component of the gravity modifier of each slot </summary>
+    std::vector<double> _gravity_modifier_y;
+    /// <summary> The x-component of the force per unit of gravity on each slot: modifier times mass while the slot is awake, dynamic and subscribed, else zero </summary>
+    std::vector<double> _gravity_scale_x;
+    /// <summary> The y-component of the force per unit of gravity on each slot: modifier times mass while the slot is awake, dynamic and subscribed, else zero </summary>
+    std::vector<double> _gravity_scale_y;
+    /// <summary> One for each slot subscribed to drag, else zero </summary>
+    std::vector<double> _drag_scale;
+    /// <summary> The inverse mass of each slot </summary>
+    std::vector<double> _inverse_masses;
+    /// <summary> The FLAG bits of each slot </summary>
+    std::vector<unsigned char> _flags;
+    /// <summary> The body attached to each slot </summary>
+    std::vector<a2de::RigidBody*> _bodies;
+
+    //DO NOT COPY!
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    BodyStore(const BodyStore& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    BodyStore& operator=(const BodyStore& rhs);
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,259 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CCollisionDispatcher.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the collision dispatcher class
+ **************************************************************************************************/
+#include "CCollisionDispatcher.h"
+
+#include "CRigidBody.h"
+#include "CConvexHull.h"
+#include "../a2de_math.h"
+
+#include <algorithm>
+#include <cmath>
+
+A2DE_BEGIN
+
+CollisionDispatcher::CollisionDispatcher() {
+    for(int i = 0; i < a2de::Shape::SHAPETYPE_MAX; ++i) {
+        for(int j = 0; j < a2de::Shape::SHAPETYPE_MAX; ++j) {
+            _table[i][j].routine = &CollisionDispatcher::Convex;
+            _table[i][j].swap = false;
+        }
+    }
+    Register(a2de::Shape::SHAPETYPE_CIRCLE, a2de::Shape::SHAPETYPE_CIRCLE, &CollisionDispatcher::CircleCircle);
+    Register(a2de::Shape::SHAPETYPE_CIRCLE, a2de::Shape::SHAPETYPE_LINE, &CollisionDispatcher::CircleLine);
+    Register(a2de::Shape::SHAPETYPE_CIRCLE, a2de::Shape::SHAPETYPE_RECTANGLE, &CollisionDispatcher::CircleRectangle);
+    Register(a2de::Shape::SHAPETYPE_RECTANGLE, a2de::Shape::SHAPETYPE_RECTANGLE, &CollisionDispatcher::RectangleRectangle);
+    Register(a2de::Shape::SHAPETYPE_RECTANGLE, a2de::Shape::SHAPETYPE_LINE, &CollisionDispatcher::HullHull<a2de::Rectangle, a2de::Line>);
+    Register(a2de::Shape::SHAPETYPE_TRIANGLE, a2de::Shape::SHAPETYPE_LINE, &CollisionDispatcher::HullHull<a2de::Triangle, a2de::Line>);
+    Register(a2de::Shape::SHAPETYPE_TRIANGLE, a2de::Shape::SHAPETYPE_RECTANGLE, &CollisionDispatcher::HullHull<a2de::Triangle, a2de::Rectangle>);
+    Register(a2de::Shape::SHAPETYPE_TRIANGLE, a2de::Shape::SHAPETYPE_TRIANGLE, &CollisionDispatcher::HullHull<a2de::Triangle, a2de::Triangle>);
+    Register(a2de::Shape::SHAPETYPE_POLYGON, a2de::Shape::SHAPETYPE_LINE, &CollisionDispatcher::HullHull<a2de::Polygon, a2de::Line>);
+    Register(a2de::Shape::SHAPETYPE_POLYGON, a2de::Shape::SHAPETYPE_RECTANGLE, &CollisionDispatcher::HullHull<a2de::Polygon, a2de::Rectangle>);
+    Register(a2de::Shape::SHAPETYPE_POLYGON, a2de::Shape::SHAPETYPE_TRIANGLE, &CollisionDispatcher::HullHull<a2de::Polygon, a2de::Triangle>);
+    Register(a2de::Shape::SHAPETYPE_POLYGON, a2de::Shape::SHAPETYPE_POLYGON, &CollisionDispatcher::HullHull<a2de::Polygon, a2de::Polygon>);
+}
+
+CollisionDispatcher::~CollisionDispatcher() {
+    /* DO NOTHING */
+}
+
+bool CollisionDispatcher::Register(a2de::Shape::SHAPE_TYPE first_type, a2de::Shape::SHAPE_TYPE second_type, CollisionRoutine routine) {
+    if(first_type < 0 || first_type >= a2de::Shape::SHAPETYPE_MAX) return false;
+    if(second_type < 0 || second_type >= a2de::Shape::SHAPETYPE_MAX) return false;
+
+    if(routine == nullptr) {
+        _table[first_type][second_type].routine = &CollisionDispatcher::Convex;
+        _table[first_type][second_type].swap = false;
+        _table[second_type][first_type].routine = &CollisionDispatcher::Convex;
+        _table[second_type][first_type].swap = false;
+        return true;
+    }
+
+    //The reversed entry is written first so a pair of equal types ends up unswapped.
+    _table[second_type][first_type].routine = routine;
+    _table[second_type][first_type].swap = true;
+    _table[first_type][second_type].routine = routine;
+    _table[first_type][second_type].swap = false;
+    return true;
+}
+
+bool CollisionDispatcher::IsRegistered(a2de::Shape::SHAPE_TYPE first_type, a2de::Shape::SHAPE_TYPE second_type) const {
+    if(first_type < 0 || first_type >= a2de::Shape::SHAPETYPE_MAX) return false;
+    if(second_type < 0 || second_type >= a2de::Shape::SHAPETYPE_MAX) return false;
+    return _table[first_type][second_type].routine != &CollisionDispatcher::Convex;
+}
+
+bool CollisionDispatcher::Collide(const a2de::RigidBody& first_body, const a2de::RigidBody& second_body, a2de::ContactManifold& manifold) const {
+    manifold.Reset();
+    const a2de::Shape* first_shape = first_body.GetCollisionShape();
+    const a2de::Shape* second_shape = second_body.GetCollisionShape();
+    if(first_shape == nullptr || second_shape == nullptr) return false;
+
+    a2de::Shape::SHAPE_TYPE first_type = first_shape->GetShapeType();
+    a2de::Shape::SHAPE_TYPE second_type = second_shape->GetShapeType();
+    if(first_type < 0 || first_type >= a2de::Shape::SHAPETYPE_MAX) return false;
+    if(second_type < 0 || second_type >= a2de::Shape::SHAPETYPE_MAX) return false;
+
+    const Entry& entry = _table[first_type][second_type];
+    if(entry.swap == false) return entry.routine(first_body, *first_shape, second_body, *second_shape, manifold);
+
+    bool touching = entry.routine(second_body, *second_shape, first_body, *first_shape, manifold);
+    manifold.Flip();
+    return touching;
+}
+
+bool CollisionDispatcher::CircleCircle(const a2de::RigidBody& /*first_body*/, const a2de::Shape& first_collision_shape, const a2de::RigidBody& /*second_body*/, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold) {
+    const a2de::Circle& first_shape = static_cast<const a2de::Circle&>(first_collision_shape);
+    const a2de::Circle& second_shape = static_cast<const a2de::Circle&>(second_collision_shape);
+
+    const a2de::Vector2D& p1 = first_shape.GetPosition();
+    const a2de::Vector2D& p2 = second_shape.GetPosition();
+    double r1 = first_shape.GetRadius();
+    double r2 = second_shape.GetRadius();
+    double dx = p2.GetX() - p1.GetX();
+    double dy = p2.GetY() - p1.GetY();
+    double distance_squared = dx * dx + dy * dy;
+    if(distance_squared > (r1 + r2) * (r1 + r2)) return false;
+
+    //Concentric circles have no direction of their own; push them apart along x.
+    double distance = std::sqrt(distance_squared);
+    double nx = 1.0;
+    double ny = 0.0;
+    if(distance > 0.0) {
+        nx = dx / distance;
+        ny = dy / distance;
+    }
+
+    manifold.SetNormal(nx, ny);
+    manifold.AddPoint(p1.GetX() + nx * r1, p1.GetY() + ny * r1, r1 + r2 - distance);
+    return true;
+}
+
+bool CollisionDispatcher::CircleLine(const a2de::RigidBody& /*first_body*/, const a2de::Shape& first_collision_shape, const a2de::RigidBody& /*second_body*/, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold) {
+    const a2de::Circle& first_shape = static_cast<const a2de::Circle&>(first_collision_shape);
+    const a2de::Line& second_shape = static_cast<const a2de::Line&>(second_collision_shape);
+
+    const a2de::Vector2D& c = first_shape.GetPosition();
+    const a2de::Vector2D& a = second_shape.GetPointOne();
+    const a2de::Vector2D& b = second_shape.GetPointTwo();
+    double r = first_shape.GetRadius();
+
+    //Closest point on the segment to the centre.
+    double abx = b.GetX() - a.GetX();
+    double aby = b.GetY() - a.GetY();
+    double length_squared = abx * abx + aby * aby;
+    double t = 0.0;
+    if(length_squared > 0.0) {
+        t = ((c.GetX() - a.GetX()) * abx + (c.GetY() - a.GetY()) * aby) / length_squared;
+        t = std::max(0.0, std::min(t, 1.0));
+    }
+    double qx = a.GetX() + abx * t;
+    double qy = a.GetY() + aby * t;
+
+    double dx = qx - c.GetX();
+    double dy = qy - c.GetY();
+    double distance_squared = dx * dx + dy * dy;
+    if(distance_squared > r * r) return false;
+
+    //A centre on the line pushes out along the line's left normal.
+    double distance = std::sqrt(distance_squared);
+    double nx = 0.0;
+    double ny = 0.0;
+    if(distance > 0.0) {
+        nx = dx / distance;
+        ny = dy / distance;
+    } else if(length_squared > 0.0) {
+        double length = std::sqrt(length_squared);
+        nx = aby / length;
+        ny = -abx / length;
+    } else {
+        nx = 1.0;
+    }
+
+    manifold.SetNormal(nx, ny);
+    manifold.AddPoint(qx, qy, r - distance);
+    return true;
+}
+
+bool CollisionDispatcher::CircleRectangle(const a2de::RigidBody& /*first_body*/, const a2de::Shape& first_collision_shape, const a2de::RigidBody& /*second_body*/, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold) {
+    const a2de::Circle& first_shape = static_cast<const a2de::Circle&>(first_collision_shape);
+    const a2de::Rectangle& second_shape = static_cast<const a2de::Rectangle&>(second_collision_shape);
+
+    const a2de::Vector2D& c = first_shape.GetPosition();
+    const a2de::Vector2D& p = second_shape.GetPosition();
+    double r = first_shape.GetRadius();
+    double hw = second_shape.GetWidth();
+    double hh = second_shape.GetHeight();
+
+    //Centre relative to the rectangle and the closest point of the rectangle to it.
+    double cx = c.GetX() - p.GetX();
+    double cy = c.GetY() - p.GetY();
+    double qx = std::max(-hw, std::min(cx, hw));
+    double qy = std::max(-hh, std::min(cy, hh));
+
+    if(qx != cx || qy != cy) {
+        double dx = qx - cx;
+        double dy = qy - cy;
+        double distance_squared = dx * dx + dy * dy;
+        if(distance_squared > r * r) return false;
+        double distance = std::sqrt(distance_squared);
+        manifold.SetNormal(dx / distance, dy / distance);
+        manifold.AddPoint(p.GetX() + qx, p.GetY() + qy, r - distance);
+        return true;
+    }
+
+    //The centre is inside: leave through the nearest side, so the normal points into the rectangle.
+    double x_depth = hw - std::abs(cx);
+    double y_depth = hh - std::abs(cy);
+    if(x_depth < y_depth) {
+        manifold.SetNormal(cx < 0.0 ? 1.0 : -1.0, 0.0);
+        manifold.AddPoint(c, r + x_depth);
+    } else {
+        manifold.SetNormal(0.0, cy < 0.0 ? 1.0 : -1.0);
+        manifold.AddPoint(c, r + y_depth);
+    }
+    return true;
+}
+
+bool CollisionDispatcher::RectangleRectangle(const a2de::RigidBody& /*first_body*/, const a2de::Shape& first_collision_shape, const a2de::RigidBody& /*second_body*/, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold) {
+    const a2de::Rectangle& first_shape = static_cast<const a2de::Rectangle&>(first_collision_shape);
+    const a2de::Rectangle& second_shape = static_cast<const a2de::Rectangle&>(second_collision_shape);
+
+    const a2de::Vector2D& fp = first_shape.GetPosition();
+    const a2de::Vector2D& sp = second_shape.GetPosition();
+    double fw = first_shape.GetWidth();
+    double fh = first_shape.GetHeight();
+    double sw = second_shape.GetWidth();
+    double sh = second_shape.GetHeight();
+    double dx = sp.GetX() - fp.GetX();
+    double dy = sp.GetY() - fp.GetY();
+
+    double x_overlap = fw + sw - std::abs(dx);
+    if(x_overlap < 0.0) return false;
+    double y_overlap = fh + sh - std::abs(dy);
+    if(y_overlap < 0.0) return false;
+
+    //Separate along the axis of least overlap. The points are the two ends of the touching span of
+    //the faces, placed halfway into the overlap.
+    if(x_overlap < y_overlap) {
+        double sign = dx < 0.0 ? -1.0 : 1.0;
+        double x = fp.GetX() + sign * (fw - x_overlap * 0.5);
+        double top = std::max(fp.GetY() - fh, sp.GetY() - sh);
+        double bottom = std::min(fp.GetY() + fh, sp.GetY() + sh);
+        manifold.SetNormal(sign, 0.0);
+        manifold.AddPoint(x, top, x_overlap);
+        manifold.AddPoint(x, bottom, x_overlap);
+    } else {
+        double sign = dy < 0.0 ? -1.0 : 1.0;
+        double y = fp.GetY() + sign * (fh - y_overlap * 0.5);
+        double left = std::max(fp.GetX() - fw, sp.GetX() - sw);
+        double right = std::min(fp.GetX() + fw, sp.GetX() + sw);
+        manifold.SetNormal(0.0, sign);
+        manifold.AddPoint(left, y, y_overlap);
+        manifold.AddPoint(right, y, y_overlap);
+    }
+    return true;
+}
+
+bool CollisionDispatcher::Convex(const a2de::RigidBody& /*first_body*/, const a2de::Shape& first_collision_shape, const a2de::RigidBody& /*second_body*/, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold) {
+    a2de::Vector2D normal;
+    a2de::Vector2D point;
+    double depth = 0.0;
+    if(a2de::GJK::GetPenetration(first_collision_shape, second_collision_shape, normal, depth, point) == false) return false;
+    manifold.SetNormal(normal);
+    manifold.AddPoint(point, depth);
+    return true;
+}
+
+template<typename First, typename Second>
+bool CollisionDispatcher::HullHull(const a2de::RigidBody& /*first_body*/, const a2de::Shape& first_collision_shape, const a2de::RigidBody& /*second_body*/, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold) {
+    a2de::ConvexHull first_hull(static_cast<const First&>(first_collision_shape));
+    a2de::ConvexHull second_hull(static_cast<const Second&>(second_collision_shape));
+    return first_hull.Collide(second_hull, manifold);
+}
+
+A2DE_END
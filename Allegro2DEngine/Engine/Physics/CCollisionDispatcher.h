@@ -0,0 +1,179 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CCollisionDispatcher.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the collision dispatcher class
+ **************************************************************************************************/
+#ifndef A2DE_CCOLLISIONDISPATCHER_H
+#define A2DE_CCOLLISIONDISPATCHER_H
+
+#include "../a2de_vals.h"
+
+#include "../Math/CShape.h"
+#include "CContactManifold.h"
+
+A2DE_BEGIN
+
+class RigidBody;
+
+/**************************************************************************************************
+ * <summary>Picks the narrow phase routine of a pair of collision shapes with one lookup in a
+ * SHAPETYPE_MAX by SHAPETYPE_MAX table indexed by the shape types. A routine is registered once
+ * for an ordered pair of types and serves both orders: the reversed entry calls it with the bodies
+ * swapped. Routines get the shapes as references already known to be of their types, so they may
+ * static_cast them instead of casting and copying. A pair with no routine of its own falls back to
+ * GJK and EPA on the support points of the shapes, so every pair of shape types collides.</summary>
+ * <remarks>Casey Ugone, 8/16/2014.</remarks>
+ **************************************************************************************************/
+class CollisionDispatcher {
+public:
+
+    /**************************************************************************************************
+     * <summary>A narrow phase routine. The shapes are the collision shapes of the bodies and are of
+     * the types the routine was registered for, in that order. The routine adds the points where
+     * the shapes touch to the manifold, which arrives reset, and sets its normal to point from the
+     * first shape to the second.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     **************************************************************************************************/
+    typedef bool (*CollisionRoutine)(const a2de::RigidBody& first_body, const a2de::Shape& first_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_shape, a2de::ContactManifold& manifold);
+
+    /**************************************************************************************************
+     * <summary>Default constructor. Gives every pair the GJK routine, then registers the built-in
+     * routines over it.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     **************************************************************************************************/
+    CollisionDispatcher();
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     **************************************************************************************************/
+    ~CollisionDispatcher();
+
+    /**************************************************************************************************
+     * <summary>Registers the routine of a pair of shape types, replacing any routine either order of
+     * the pair had.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_type"> The type of the routine's first shape.</param>
+     * <param name="second_type">The type of the routine's second shape.</param>
+     * <param name="routine">    The routine, or null to fall back to the GJK routine.</param>
+     * <returns>true if it succeeds, false if a type is out of range.</returns>
+     **************************************************************************************************/
+    bool Register(a2de::Shape::SHAPE_TYPE first_type, a2de::Shape::SHAPE_TYPE second_type, CollisionRoutine routine);
+
+    /**************************************************************************************************
+     * <summary>Query if a pair of shape types has a routine of its own rather than the GJK routine.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_type"> The type of the first shape.</param>
+     * <param name="second_type">The type of the second shape.</param>
+     * <returns>true if registered, false if not.</returns>
+     **************************************************************************************************/
+    bool IsRegistered(a2de::Shape::SHAPE_TYPE first_type, a2de::Shape::SHAPE_TYPE second_type) const;
+
+    /**************************************************************************************************
+     * <summary>Runs the routine of the collision shapes of two bodies. The manifold is reset first
+     * and its normal points from the first body to the second whichever order the routine takes.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_body"> The first body.</param>
+     * <param name="second_body">The second body.</param>
+     * <param name="manifold">   [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if they do not or a body has no collision shape.</returns>
+     **************************************************************************************************/
+    bool Collide(const a2de::RigidBody& first_body, const a2de::RigidBody& second_body, a2de::ContactManifold& manifold) const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>An entry of the table.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     **************************************************************************************************/
+    struct Entry {
+        /// <summary> The routine </summary>
+        CollisionRoutine routine;
+        /// <summary> Whether the routine takes the bodies in the other order </summary>
+        bool swap;
+    };
+
+    /**************************************************************************************************
+     * <summary>Circle-Circle collision routine.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_body">            The first body.</param>
+     * <param name="first_collision_shape"> The collision shape of the first body.</param>
+     * <param name="second_body">           The second body.</param>
+     * <param name="second_collision_shape">The collision shape of the second body.</param>
+     * <param name="manifold">              [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    static bool CircleCircle(const a2de::RigidBody& first_body, const a2de::Shape& first_collision_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold);
+
+    /**************************************************************************************************
+     * <summary>Circle-Line collision routine.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_body">            The first body.</param>
+     * <param name="first_collision_shape"> The collision shape of the first body.</param>
+     * <param name="second_body">           The second body.</param>
+     * <param name="second_collision_shape">The collision shape of the second body.</param>
+     * <param name="manifold">              [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    static bool CircleLine(const a2de::RigidBody& first_body, const a2de::Shape& first_collision_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold);
+
+    /**************************************************************************************************
+     * <summary>Circle-Rectangle collision routine.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_body">            The first body.</param>
+     * <param name="first_collision_shape"> The collision shape of the first body.</param>
+     * <param name="second_body">           The second body.</param>
+     * <param name="second_collision_shape">The collision shape of the second body.</param>
+     * <param name="manifold">              [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    static bool CircleRectangle(const a2de::RigidBody& first_body, const a2de::Shape& first_collision_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold);
+
+    /**************************************************************************************************
+     * <summary>Rectangle-Rectangle collision routine.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <param name="first_body">            The first body.</param>
+     * <param name="first_collision_shape"> The collision shape of the first body.</param>
+     * <param name="second_body">           The second body.</param>
+     * <param name="second_collision_shape">The collision shape of the second body.</param>
+     * <param name="manifold">              [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    static bool RectangleRectangle(const a2de::RigidBody& first_body, const a2de::Shape& first_collision_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold);
+
+    /**************************************************************************************************
+     * <summary>GJK and EPA routine for any two shapes, giving one point at the deepest overlap.</summary>
+     * <remarks>Casey Ugone, 8/19/2014.</remarks>
+     * <param name="first_body">            The first body.</param>
+     * <param name="first_collision_shape"> The collision shape of the first body.</param>
+     * <param name="second_body">           The second body.</param>
+     * <param name="second_collision_shape">The collision shape of the second body.</param>
+     * <param name="manifold">              [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    static bool Convex(const a2de::RigidBody& first_body, const a2de::Shape& first_collision_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold);
+
+    /**************************************************************************************************
+     * <summary>Separating axis routine for any two shapes a ConvexHull can be built from.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="first_body">            The first body.</param>
+     * <param name="first_collision_shape"> The collision shape of the first body, a First.</param>
+     * <param name="second_body">           The second body.</param>
+     * <param name="second_collision_shape">The collision shape of the second body, a Second.</param>
+     * <param name="manifold">              [in,out] The manifold that receives the points.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
+     **************************************************************************************************/
+    template<typename First, typename Second>
+    static bool HullHull(const a2de::RigidBody& first_body, const a2de::Shape& first_collision_shape, const a2de::RigidBody& second_body, const a2de::Shape& second_collision_shape, a2de::ContactManifold& manifold);
+
+    /// <summary> The routine of each pair of shape types, indexed [first type][second type] </summary>
+    Entry _table[a2de::Shape::SHAPETYPE_MAX][a2de::Shape::SHAPETYPE_MAX];
+
+};
+
+A2DE_END
+
+#endif
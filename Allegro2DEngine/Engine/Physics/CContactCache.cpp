@@ -0,0 +1,112 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CContactCache.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the contact cache class
+ **************************************************************************************************/
+#include "CContactCache.h"
+
+#include "CBodyHandle.h"
+
+#include <algorithm>
+#include <utility>
+
+A2DE_BEGIN
+
+ContactCache::ContactCache() : _contacts(), _frame(0) {
+    /* DO NOTHING */
+}
+
+ContactCache::~ContactCache() {
+    _contacts.clear();
+}
+
+bool ContactCache::IsLess(const a2de::Contact& lhs, const std::pair<unsigned long, unsigned long>& rhs) {
+    if(lhs.first_id != rhs.first) return lhs.first_id < rhs.first;
+    return lhs.second_id < rhs.second;
+}
+
+void ContactCache::BeginFrame() {
+    ++_frame;
+    _contacts.erase(std::remove_if(_contacts.begin(), _contacts.end(), [](const a2de::Contact& contact)->bool
+    {
+        return contact.state == a2de::Contact::STATE_END;
+    }), _contacts.end());
+}
+
+a2de::Contact& ContactCache::Touch(a2de::BodyHandle* first, a2de::BodyHandle* second) {
+    if(second->GetId() < first->GetId()) std::swap(first, second);
+    std::pair<unsigned long, unsigned long> key(first->GetId(), second->GetId());
+
+    ContactsIter _iter = std::lower_bound(_contacts.begin(), _contacts.end(), key, IsLess);
+    if(_iter != _contacts.end() && _iter->first_id == key.first && _iter->second_id == key.second) {
+        //Touched twice in one frame, e.g. a partition that reports duplicates, keeps its state.
+        if(_iter->frame != _frame) {
+            _iter->state = a2de::Contact::STATE_PERSIST;
+        }
+        _iter->frame = _frame;
+        return *_iter;
+    }
+
+    a2de::Contact contact;
+    contact.first = first;
+    contact.second = second;
+    contact.first_id = key.first;
+    contact.second_id = key.second;
+    contact.state = a2de::Contact::STATE_BEGIN;
+    contact.frame = _frame;
+    return *_contacts.insert(_iter, contact);
+}
+
+void ContactCache::EndFrame() {
+    for(ContactsIter _iter = _contacts.begin(); _iter != _contacts.end(); ++_iter) {
+        if(_iter->frame == _frame) continue;
+        _iter->state = a2de::Contact::STATE_END;
+    }
+}
+
+const a2de::Contact* ContactCache::Find(unsigned long first_id, unsigned long second_id) const {
+    //The lower id always comes first so either order finds the same pair.
+    if(second_id < first_id) std::swap(first_id, second_id);
+    std::pair<unsigned long, unsigned long> key(first_id, second_id);
+    ContactsConstIter _iter = std::lower_bound(_contacts.begin(), _contacts.end(), key, IsLess);
+    if(_iter == _contacts.end()) return nullptr;
+    if(_iter->first_id != key.first || _iter->second_id != key.second) return nullptr;
+    return &(*_iter);
+}
+
+a2de::Contact* ContactCache::Find(unsigned long first_id, unsigned long second_id) {
+    return const_cast<a2de::Contact*>(static_cast<const ContactCache&>(*this).Find(first_id, second_id));
+}
+
+void ContactCache::Remove(const a2de::BodyHandle* handle) {
+    if(handle == nullptr) return;
+    unsigned long id = handle->GetId();
+    _contacts.erase(std::remove_if(_contacts.begin(), _contacts.end(), [id](const a2de::Contact& contact)->bool
+    {
+        return contact.first_id == id || contact.second_id == id;
+    }), _contacts.end());
+}
+
+void ContactCache::Clear() {
+    _contacts.clear();
+}
+
+const ContactCache::Contacts& ContactCache::GetContacts() const {
+    return _contacts;
+}
+
+ContactCache::Contacts& ContactCache::GetContacts() {
+    return const_cast<ContactCache::Contacts&>(static_cast<const ContactCache&>(*this).GetContacts());
+}
+
+unsigned long ContactCache::GetFrame() const {
+    return _frame;
+}
+
+void ContactCache::SetFrame(unsigned long frame) {
+    _frame = frame;
+}
+
+A2DE_END
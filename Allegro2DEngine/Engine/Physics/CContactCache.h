@@ -0,0 +1,206 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CContactCache.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the contact cache class
+ **************************************************************************************************/
+#ifndef A2DE_CCONTACTCACHE_H
+#define A2DE_CCONTACTCACHE_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+#include <utility>
+
+#include "CContactManifold.h"
+
+A2DE_BEGIN
+
+class BodyHandle;
+
+/**************************************************************************************************
+ * <summary>A pair of bodies in contact and what is remembered about it between frames.</summary>
+ * <remarks>Casey Ugone, 8/5/2014.</remarks>
+ **************************************************************************************************/
+struct Contact {
+
+    /**************************************************************************************************
+     * <summary>Values that represent where a contact is in its lifetime.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     **************************************************************************************************/
+    enum STATE {
+        STATE_BEGIN,
+        STATE_PERSIST,
+        STATE_END,
+    };
+
+    Contact() {
+        first = nullptr;
+        second = nullptr;
+        first_id = 0;
+        second_id = 0;
+        state = STATE_BEGIN;
+        frame = 0;
+    }
+    /// <summary> The handle with the lower id </summary>
+    a2de::BodyHandle* first;
+    /// <summary> The handle with the higher id </summary>
+    a2de::BodyHandle* second;
+    /// <summary> The id of the first handle </summary>
+    unsigned long first_id;
+    /// <summary> The id of the second handle </summary>
+    unsigned long second_id;
+    /// <summary> Whether the pair started touching this frame, is still touching or stopped touching </summary>
+    STATE state;
+    /// <summary> The last contact points and their impulses, normal pointing from the first body to the second </summary>
+    a2de::ContactManifold manifold;
+    /// <summary> The last frame the pair was touched </summary>
+    unsigned long frame;
+};
+
+/**************************************************************************************************
+ * <summary>The contacts of a World kept from frame to frame in a vector sorted by handle ids. Each
+ * frame the broad phase touches the pairs it finds; pairs that were not touched end, and pairs that
+ * ended last frame are dropped.</summary>
+ * <remarks>Casey Ugone, 8/5/2014.</remarks>
+ **************************************************************************************************/
+class ContactCache {
+public:
+
+    typedef std::vector<a2de::Contact> Contacts;
+    typedef Contacts::iterator ContactsIter;
+    typedef Contacts::const_iterator ContactsConstIter;
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     **************************************************************************************************/
+    ContactCache();
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     **************************************************************************************************/
+    ~ContactCache();
+
+    /**************************************************************************************************
+     * <summary>Starts a frame. Drops the contacts that ended last frame.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     **************************************************************************************************/
+    void BeginFrame();
+
+    /**************************************************************************************************
+     * <summary>Marks a pair as touching this frame, adding it if it is new.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="first"> [in,out] One of the handles.</param>
+     * <param name="second">[in,out] The other handle.</param>
+     * <returns>The contact of the pair.</returns>
+     **************************************************************************************************/
+    a2de::Contact& Touch(a2de::BodyHandle* first, a2de::BodyHandle* second);
+
+    /**************************************************************************************************
+     * <summary>Ends the frame. Contacts that were not touched this frame end.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     **************************************************************************************************/
+    void EndFrame();
+
+    /**************************************************************************************************
+     * <summary>Searches for the contact between two handles.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="first_id"> The id of one of the handles.</param>
+     * <param name="second_id">The id of the other handle.</param>
+     * <returns>null if the handles are not in contact, else the contact.</returns>
+     **************************************************************************************************/
+    const a2de::Contact* Find(unsigned long first_id, unsigned long second_id) const;
+
+    /**************************************************************************************************
+     * <summary>Searches for the contact between two handles.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="first_id"> The id of one of the handles.</param>
+     * <param name="second_id">The id of the other handle.</param>
+     * <returns>null if the handles are not in contact, else the contact.</returns>
+     **************************************************************************************************/
+    a2de::Contact* Find(unsigned long first_id, unsigned long second_id);
+
+    /**************************************************************************************************
+     * <summary>Removes every contact of a handle. Call before the handle is destroyed or its id is
+     * reused.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="handle">The handle.</param>
+     **************************************************************************************************/
+    void Remove(const a2de::BodyHandle* handle);
+
+    /**************************************************************************************************
+     * <summary>Removes every contact.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Gets the contacts, sorted by handle ids.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <returns>The contacts.</returns>
+     **************************************************************************************************/
+    const Contacts& GetContacts() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the contacts, sorted by handle ids.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <returns>The contacts.</returns>
+     **************************************************************************************************/
+    Contacts& GetContacts();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of the current frame.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The frame.</returns>
+     **************************************************************************************************/
+    unsigned long GetFrame() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the number of the current frame, e.g. when contacts are restored from a
+     * snapshot.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="frame">The frame.</param>
+     **************************************************************************************************/
+    void SetFrame(unsigned long frame);
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Orders a contact before a pair of handle ids.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="lhs">The contact.</param>
+     * <param name="rhs">The lower and higher handle ids.</param>
+     * <returns>true if the contact sorts before the ids.</returns>
+     **************************************************************************************************/
+    static bool IsLess(const a2de::Contact& lhs, const std::pair<unsigned long, unsigned long>& rhs);
+
+    /// <summary> The contacts, sorted by first_id then second_id </summary>
+    Contacts _contacts;
+    /// <summary> The current frame </summary>
+    unsigned long _frame;
+
+    //DO NOT COPY!
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    ContactCache(const ContactCache& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    ContactCache& operator=(const ContactCache& rhs);
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,98 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CContactManifold.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the contact manifold class
+ **************************************************************************************************/
+#include "CContactManifold.h"
+
+A2DE_BEGIN
+
+const std::size_t ContactManifold::MAX_POINTS;
+
+ContactManifold::ContactManifold() : _normal_x(0.0), _normal_y(0.0), _point_count(0), _previous_count(0) {
+    /* DO NOTHING */
+}
+
+ContactManifold::~ContactManifold() {
+    _point_count = 0;
+    _previous_count = 0;
+}
+
+void ContactManifold::Reset() {
+    _previous_count = _point_count;
+    _point_count = 0;
+}
+
+void ContactManifold::Clear() {
+    _point_count = 0;
+    _previous_count = 0;
+}
+
+bool ContactManifold::AddPoint(const a2de::Vector2D& point, double penetration) {
+    return AddPoint(point.GetX(), point.GetY(), penetration);
+}
+
+bool ContactManifold::AddPoint(double x, double y, double penetration) {
+    if(_point_count == MAX_POINTS) return false;
+    a2de::ManifoldPoint& p = _points[_point_count];
+    p.x = x;
+    p.y = y;
+    p.penetration = penetration;
+    //A slot past last frame's points holds stale impulses from an older frame.
+    if(_point_count >= _previous_count) {
+        p.normal_impulse = 0.0;
+        p.tangent_impulse = 0.0;
+    }
+    ++_point_count;
+    return true;
+}
+
+a2de::Vector2D ContactManifold::GetNormal() const {
+    return a2de::Vector2D(_normal_x, _normal_y);
+}
+
+double ContactManifold::GetNormalX() const {
+    return _normal_x;
+}
+
+double ContactManifold::GetNormalY() const {
+    return _normal_y;
+}
+
+void ContactManifold::SetNormal(const a2de::Vector2D& normal) {
+    SetNormal(normal.GetX(), normal.GetY());
+}
+
+void ContactManifold::SetNormal(double x, double y) {
+    _normal_x = x;
+    _normal_y = y;
+}
+
+void ContactManifold::Flip() {
+    _normal_x = -_normal_x;
+    _normal_y = -_normal_y;
+}
+
+bool ContactManifold::IsEmpty() const {
+    return _point_count == 0;
+}
+
+bool ContactManifold::IsMatching() const {
+    return _point_count == _previous_count;
+}
+
+std::size_t ContactManifold::GetPointCount() const {
+    return _point_count;
+}
+
+const a2de::ManifoldPoint& ContactManifold::operator[](std::size_t index) const {
+    return _points[index];
+}
+
+a2de::ManifoldPoint& ContactManifold::operator[](std::size_t index) {
+    return const_cast<a2de::ManifoldPoint&>(static_cast<const ContactManifold&>(*this)[index]);
+}
+
+A2DE_END
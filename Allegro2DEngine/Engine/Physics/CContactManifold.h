@@ -0,0 +1,195 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CContactManifold.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the contact manifold class
+ **************************************************************************************************/
+#ifndef A2DE_CCONTACTMANIFOLD_H
+#define A2DE_CCONTACTMANIFOLD_H
+
+#include "../a2de_vals.h"
+
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>A point where two shapes touch.</summary>
+ * <remarks>Casey Ugone, 8/17/2014.</remarks>
+ **************************************************************************************************/
+struct ManifoldPoint {
+    ManifoldPoint() {
+        x = 0.0;
+        y = 0.0;
+        penetration = 0.0;
+        normal_impulse = 0.0;
+        tangent_impulse = 0.0;
+    }
+    /// <summary> The x-component of the point in world coordinates </summary>
+    double x;
+    /// <summary> The y-component of the point in world coordinates </summary>
+    double y;
+    /// <summary> The penetration depth at the point </summary>
+    double penetration;
+    /// <summary> The impulse applied along the normal, kept for warm starting </summary>
+    double normal_impulse;
+    /// <summary> The impulse applied along the tangent, kept for warm starting </summary>
+    double tangent_impulse;
+};
+
+/**************************************************************************************************
+ * <summary>The points where two shapes touch, sharing one normal. The points live inside the
+ * manifold, so filling one never allocates. Between frames the points keep their impulses: the
+ * narrow phase resets the manifold and writes the new points over the old ones in the same order,
+ * and a point only starts from zero when there were fewer points last frame.</summary>
+ * <remarks>Casey Ugone, 8/17/2014.</remarks>
+ **************************************************************************************************/
+class ContactManifold {
+public:
+
+    /// <summary> The most points a manifold holds </summary>
+    static const std::size_t MAX_POINTS = 2;
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     **************************************************************************************************/
+    ContactManifold();
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     **************************************************************************************************/
+    ~ContactManifold();
+
+    /**************************************************************************************************
+     * <summary>Starts a new set of points. The impulses of the old points stay behind for the new
+     * points written over them.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     **************************************************************************************************/
+    void Reset();
+
+    /**************************************************************************************************
+     * <summary>Removes every point and forgets their impulses.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Adds a point.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <param name="point">      The point in world coordinates.</param>
+     * <param name="penetration">The penetration depth at the point.</param>
+     * <returns>true if it succeeds, false if the manifold is full.</returns>
+     **************************************************************************************************/
+    bool AddPoint(const a2de::Vector2D& point, double penetration);
+
+    /**************************************************************************************************
+     * <summary>Adds a point.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <param name="x">          The x-component of the point in world coordinates.</param>
+     * <param name="y">          The y-component of the point in world coordinates.</param>
+     * <param name="penetration">The penetration depth at the point.</param>
+     * <returns>true if it succeeds, false if the manifold is full.</returns>
+     **************************************************************************************************/
+    bool AddPoint(double x, double y, double penetration);
+
+    /**************************************************************************************************
+     * <summary>Gets the normal, pointing from the first shape to the second.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <returns>The normal.</returns>
+     **************************************************************************************************/
+    a2de::Vector2D GetNormal() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the x-component of the normal.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <returns>The x-component of the normal.</returns>
+     **************************************************************************************************/
+    double GetNormalX() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the y-component of the normal.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <returns>The y-component of the normal.</returns>
+     **************************************************************************************************/
+    double GetNormalY() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the normal, pointing from the first shape to the second.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <param name="normal">The normal.</param>
+     **************************************************************************************************/
+    void SetNormal(const a2de::Vector2D& normal);
+
+    /**************************************************************************************************
+     * <summary>Sets the normal, pointing from the first shape to the second.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <param name="x">The x-component of the normal.</param>
+     * <param name="y">The y-component of the normal.</param>
+     **************************************************************************************************/
+    void SetNormal(double x, double y);
+
+    /**************************************************************************************************
+     * <summary>Reverses the normal, for when the shapes were collided in the other order.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     **************************************************************************************************/
+    void Flip();
+
+    /**************************************************************************************************
+     * <summary>Query if the manifold holds no points.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <returns>true if empty, false if not.</returns>
+     **************************************************************************************************/
+    bool IsEmpty() const;
+
+    /**************************************************************************************************
+     * <summary>Query if the points line up with the points before the last Reset, so their
+     * impulses may carry over.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <returns>true if the number of points did not change, false if it did.</returns>
+     **************************************************************************************************/
+    bool IsMatching() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of points.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <returns>The number of points.</returns>
+     **************************************************************************************************/
+    std::size_t GetPointCount() const;
+
+    /**************************************************************************************************
+     * <summary>Gets a point.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <param name="index">Zero-based index of the point, less than GetPointCount().</param>
+     * <returns>The point.</returns>
+     **************************************************************************************************/
+    const a2de::ManifoldPoint& operator[](std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets a point.</summary>
+     * <remarks>Casey Ugone, 8/17/2014.</remarks>
+     * <param name="index">Zero-based index of the point, less than GetPointCount().</param>
+     * <returns>The point.</returns>
+     **************************************************************************************************/
+    a2de::ManifoldPoint& operator[](std::size_t index);
+
+protected:
+private:
+
+    /// <summary> The points </summary>
+    a2de::ManifoldPoint _points[MAX_POINTS];
+    /// <summary> The x-component of the normal </summary>
+    double _normal_x;
+    /// <summary> The y-component of the normal </summary>
+    double _normal_y;
+    /// <summary> The number of points </summary>
+    std::size_t _point_count;
+    /// <summary> The number of points before the last Reset </summary>
+    std::size_t _previous_count;
+};
+
+A2DE_END
+
+#endif
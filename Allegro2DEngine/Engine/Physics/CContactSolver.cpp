@@ -0,0 +1,254 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CContactSolver.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the contact solver class
+ **************************************************************************************************/
+#include "CContactSolver.h"
+
+#include "CRigidBody.h"
+#include "CContactCache.h"
+#include "../Math/MiscMath.h"
+#include "../Math/MathConstants.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+A2DE_BEGIN
+
+const std::size_t ContactSolver::DEFAULT_VELOCITY_ITERATIONS = 8;
+const std::size_t ContactSolver::DEFAULT_POSITION_ITERATIONS = 3;
+const double ContactSolver::DEFAULT_POSITION_CORRECTION = 0.2;
+const double ContactSolver::DEFAULT_PENETRATION_SLOP = 0.005;
+const double ContactSolver::RESTITUTION_THRESHOLD = 1.0;
+const std::size_t ContactSolver::NO_BODY = std::numeric_limits<std::size_t>::max();
+
+ContactSolver::ContactSolver() : _bodies(), _solver_contacts(), _body_lookup(), _velocity_iterations(DEFAULT_VELOCITY_ITERATIONS), _position_iterations(DEFAULT_POSITION_ITERATIONS), _position_correction(DEFAULT_POSITION_CORRECTION), _penetration_slop(DEFAULT_PENETRATION_SLOP), _warm_starting(true) {
+    /* DO NOTHING */
+}
+
+ContactSolver::~ContactSolver() {
+    Clear();
+}
+
+void ContactSolver::Clear() {
+    //Only the entries that were used need resetting; the lookup keeps its size between frames.
+    for(std::vector<SolverBody>::const_iterator _iter = _bodies.begin(); _iter != _bodies.end(); ++_iter) {
+        _body_lookup[_iter->id] = NO_BODY;
+    }
+    _bodies.clear();
+    _solver_contacts.clear();
+}
+
+std::size_t ContactSolver::AddBody(unsigned long id, a2de::RigidBody* body) {
+    if(id >= _body_lookup.size()) _body_lookup.resize(id + 1, NO_BODY);
+    if(_body_lookup[id] != NO_BODY) return _body_lookup[id];
+
+    double mass = body->GetMass();
+    a2de::Vector2D velocity(body->GetVelocity());
+
+    SolverBody solver_body;
+    solver_body.body = body;
+    solver_body.id = id;
+    solver_body.inverse_mass = (a2de::Math::IsEqual(mass, 0.0) || a2de::Math::IsEqual(mass, a2de::Math::A2DE_INFINITY)) ? 0.0 : 1.0 / mass;
+    solver_body.velocity_x = velocity.GetX();
+    solver_body.velocity_y = velocity.GetY();
+    solver_body.pseudo_velocity_x = 0.0;
+    solver_body.pseudo_velocity_y = 0.0;
+
+    _body_lookup[id] = _bodies.size();
+    _bodies.push_back(solver_body);
+    return _bodies.size() - 1;
+}
+
+void ContactSolver::AddContact(a2de::Contact& contact, a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
+    a2de::ContactManifold& manifold = contact.manifold;
+    if(manifold.IsEmpty()) return;
+    double normal_x = manifold.GetNormalX();
+    double normal_y = manifold.GetNormalY();
+    double length = std::sqrt(normal_x * normal_x + normal_y * normal_y);
+    if(a2de::Math::IsEqual(length, 0.0)) return;
+
+    std::size_t first = AddBody(contact.first_id, first_body);
+    std::size_t second = AddBody(contact.second_id, second_body);
+    double friction = std::sqrt(first_body->GetKineticFriction() * second_body->GetKineticFriction());
+    double restitution = first_body->GetRestitution() * second_body->GetRestitution();
+    //A contact that just began, or whose points changed, has nothing worth carrying over.
+    bool warm = _warm_starting && contact.state == a2de::Contact::STATE_PERSIST && manifold.IsMatching();
+
+    for(std::size_t i = 0; i < manifold.GetPointCount(); ++i) {
+        a2de::ManifoldPoint& point = manifold[i];
+        SolverContact solver_contact;
+        solver_contact.point = &point;
+        solver_contact.first = first;
+        solver_contact.second = second;
+        solver_contact.normal_x = normal_x / length;
+        solver_contact.normal_y = normal_y / length;
+        solver_contact.penetration = point.penetration;
+        solver_contact.effective_mass = 0.0;
+        solver_contact.friction = friction;
+        solver_contact.restitution = restitution;
+        solver_contact.velocity_bias = 0.0;
+        solver_contact.normal_impulse = warm ? point.normal_impulse : 0.0;
+        solver_contact.tangent_impulse = warm ? point.tangent_impulse : 0.0;
+        solver_contact.position_impulse = 0.0;
+        _solver_contacts.push_back(solver_contact);
+    }
+}
+
+void ContactSolver::Solve(double deltaTime) {
+    if(_solver_contacts.empty()) return;
+
+    PrepareContacts();
+    for(std::size_t i = 0; i < _velocity_iterations; ++i) {
+        SolveVelocities();
+    }
+    if(deltaTime > 0.0) {
+        for(std::size_t i = 0; i < _position_iterations; ++i) {
+            SolvePositions(deltaTime);
+        }
+    }
+    StoreResults(deltaTime);
+}
+
+void ContactSolver::PrepareContacts() {
+    for(std::vector<SolverContact>::iterator _iter = _solver_contacts.begin(); _iter != _solver_contacts.end(); ++_iter) {
+        SolverBody& first = _bodies[_iter->first];
+        SolverBody& second = _bodies[_iter->second];
+        double inverse_mass_sum = first.inverse_mass + second.inverse_mass;
+        _iter->effective_mass = (inverse_mass_sum > 0.0) ? 1.0 / inverse_mass_sum : 0.0;
+
+        //Restitution aims for a separating speed taken from the closing speed before any impulse.
+        double relative_normal_speed = (second.velocity_x - first.velocity_x) * _iter->normal_x + (second.velocity_y - first.velocity_y) * _iter->normal_y;
+        _iter->velocity_bias = (relative_normal_speed < -RESTITUTION_THRESHOLD) ? -_iter->restitution * relative_normal_speed : 0.0;
+
+        //The tangent is the left normal of the normal: (-ny, nx).
+        double impulse_x = _iter->normal_impulse * _iter->normal_x - _iter->tangent_impulse * _iter->normal_y;
+        double impulse_y = _iter->normal_impulse * _iter->normal_y + _iter->tangent_impulse * _iter->normal_x;
+        first.velocity_x -= first.inverse_mass * impulse_x;
+        first.velocity_y -= first.inverse_mass * impulse_y;
+        second.velocity_x += second.inverse_mass * impulse_x;
+        second.velocity_y += second.inverse_mass * impulse_y;
+    }
+}
+
+void ContactSolver::SolveVelocities() {
+    for(std::vector<SolverContact>::iterator _iter = _solver_contacts.begin(); _iter != _solver_contacts.end(); ++_iter) {
+        if(_iter->effective_mass == 0.0) continue;
+        SolverBody& first = _bodies[_iter->first];
+        SolverBody& second = _bodies[_iter->second];
+        double nx = _iter->normal_x;
+        double ny = _iter->normal_y;
+        double tx = -ny;
+        double ty = nx;
+
+        //Friction first, bounded by the normal impulse accumulated so far.
+        double relative_x = second.velocity_x - first.velocity_x;
+        double relative_y = second.velocity_y - first.velocity_y;
+        double tangent_lambda = -_iter->effective_mass * (relative_x * tx + relative_y * ty);
+        double max_friction = _iter->friction * _iter->normal_impulse;
+        double old_tangent = _iter->tangent_impulse;
+        _iter->tangent_impulse = std::max(-max_friction, std::min(old_tangent + tangent_lambda, max_friction));
+        tangent_lambda = _iter->tangent_impulse - old_tangent;
+        first.velocity_x -= first.inverse_mass * tangent_lambda * tx;
+        first.velocity_y -= first.inverse_mass * tangent_lambda * ty;
+        second.velocity_x += second.inverse_mass * tangent_lambda * tx;
+        second.velocity_y += second.inverse_mass * tangent_lambda * ty;
+
+        //The bodies may push each other apart but never pull together.
+        relative_x = second.velocity_x - first.velocity_x;
+        relative_y = second.velocity_y - first.velocity_y;
+        double normal_lambda = -_iter->effective_mass * (relative_x * nx + relative_y * ny - _iter->velocity_bias);
+        double old_normal = _iter->normal_impulse;
+        _iter->normal_impulse = std::max(old_normal + normal_lambda, 0.0);
+        normal_lambda = _iter->normal_impulse - old_normal;
+        first.velocity_x -= first.inverse_mass * normal_lambda * nx;
+        first.velocity_y -= first.inverse_mass * normal_lambda * ny;
+        second.velocity_x += second.inverse_mass * normal_lambda * nx;
+        second.velocity_y += second.inverse_mass * normal_lambda * ny;
+    }
+}
+
+void ContactSolver::SolvePositions(double deltaTime) {
+    double bias_factor = _position_correction / deltaTime;
+    for(std::vector<SolverContact>::iterator _iter = _solver_contacts.begin(); _iter != _solver_contacts.end(); ++_iter) {
+        if(_iter->effective_mass == 0.0) continue;
+        SolverBody& first = _bodies[_iter->first];
+        SolverBody& second = _bodies[_iter->second];
+        double nx = _iter->normal_x;
+        double ny = _iter->normal_y;
+
+        //Split impulse: push apart with a pseudo velocity so the correction never turns into bounce.
+        double target = bias_factor * std::max(_iter->penetration - _penetration_slop, 0.0);
+        double relative_normal_speed = (second.pseudo_velocity_x - first.pseudo_velocity_x) * nx + (second.pseudo_velocity_y - first.pseudo_velocity_y) * ny;
+        double lambda = _iter->effective_mass * (target - relative_normal_speed);
+        double old_impulse = _iter->position_impulse;
+        _iter->position_impulse = std::max(old_impulse + lambda, 0.0);
+        lambda = _iter->position_impulse - old_impulse;
+        first.pseudo_velocity_x -= first.inverse_mass * lambda * nx;
+        first.pseudo_velocity_y -= first.inverse_mass * lambda * ny;
+        second.pseudo_velocity_x += second.inverse_mass * lambda * nx;
+        second.pseudo_velocity_y += second.inverse_mass * lambda * ny;
+    }
+}
+
+void ContactSolver::StoreResults(double deltaTime) {
+    for(std::vector<SolverBody>::iterator _iter = _bodies.begin(); _iter != _bodies.end(); ++_iter) {
+        if(_iter->inverse_mass == 0.0) continue;
+        _iter->body->SetVelocity(a2de::Vector2D(_iter->velocity_x, _iter->velocity_y));
+        if(_iter->pseudo_velocity_x == 0.0 && _iter->pseudo_velocity_y == 0.0) continue;
+        const a2de::Vector2D& position = _iter->body->GetPosition();
+        _iter->body->SetPosition(a2de::Vector2D(position.GetX() + _iter->pseudo_velocity_x * deltaTime, position.GetY() + _iter->pseudo_velocity_y * deltaTime));
+    }
+    for(std::vector<SolverContact>::const_iterator _iter = _solver_contacts.begin(); _iter != _solver_contacts.end(); ++_iter) {
+        _iter->point->normal_impulse = _iter->normal_impulse;
+        _iter->point->tangent_impulse = _iter->tangent_impulse;
+    }
+}
+
+std::size_t ContactSolver::GetVelocityIterations() const {
+    return _velocity_iterations;
+}
+
+void ContactSolver::SetVelocityIterations(std::size_t iterations) {
+    _velocity_iterations = iterations;
+}
+
+std::size_t ContactSolver::GetPositionIterations() const {
+    return _position_iterations;
+}
+
+void ContactSolver::SetPositionIterations(std::size_t iterations) {
+    _position_iterations = iterations;
+}
+
+double ContactSolver::GetPositionCorrection() const {
+    return _position_correction;
+}
+
+void ContactSolver::SetPositionCorrection(double fraction) {
+    if(fraction < 0.0) fraction = 0.0;
+    if(fraction > 1.0) fraction = 1.0;
+    _position_correction = fraction;
+}
+
+double ContactSolver::GetPenetrationSlop() const {
+    return _penetration_slop;
+}
+
+void ContactSolver::SetPenetrationSlop(double slop) {
+    if(slop < 0.0) slop = 0.0;
+    _penetration_slop = slop;
+}
+
+bool ContactSolver::IsWarmStarting() const {
+    return _warm_starting;
+}
+
+void ContactSolver::SetWarmStarting(bool warm_starting) {
+    _warm_starting = warm_starting;
+}
+
+A2DE_END
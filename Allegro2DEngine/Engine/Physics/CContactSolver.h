@@ -0,0 +1,289 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CContactSolver.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the contact solver class
+ **************************************************************************************************/
+#ifndef A2DE_CCONTACTSOLVER_H
+#define A2DE_CCONTACTSOLVER_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+class RigidBody;
+struct Contact;
+struct ManifoldPoint;
+
+/**************************************************************************************************
+ * <summary>A sequential impulse solver for the contacts of one frame. Every point of a contact's
+ * manifold is a non-penetration constraint along the normal plus a Coulomb friction constraint along
+ * the tangent.
+ * The solver sweeps over all of them a number of times, clamping the impulse each has accumulated,
+ * so stacks converge instead of being resolved one pair at a time. The impulses of the last frame
+ * are applied first (warm starting), and penetration is removed with split impulses: a separate
+ * pseudo velocity that moves the bodies apart without adding to their real velocity.</summary>
+ * <remarks>Casey Ugone, 8/15/2014.</remarks>
+ **************************************************************************************************/
+class ContactSolver {
+public:
+
+    /// <summary> The default number of sweeps over the velocity constraints </summary>
+    static const std::size_t DEFAULT_VELOCITY_ITERATIONS;
+    /// <summary> The default number of sweeps over the position constraints </summary>
+    static const std::size_t DEFAULT_POSITION_ITERATIONS;
+    /// <summary> The default fraction of the penetration removed each frame </summary>
+    static const double DEFAULT_POSITION_CORRECTION;
+    /// <summary> The default penetration in meters that is allowed to remain </summary>
+    static const double DEFAULT_PENETRATION_SLOP;
+    /// <summary> The closing speed in meters per second below which contacts do not bounce </summary>
+    static const double RESTITUTION_THRESHOLD;
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    ContactSolver();
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    ~ContactSolver();
+
+    /**************************************************************************************************
+     * <summary>Removes every contact and body from the last solve.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Adds the points of a contact's manifold to solve. The contact and bodies must stay
+     * alive until Solve returns.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="contact">     [in,out] The cached contact. The impulses of its manifold points warm
+     *                            start the solve and receive the result.</param>
+     * <param name="first_body">  [in,out] The body of the contact's first handle.</param>
+     * <param name="second_body"> [in,out] The body of the contact's second handle.</param>
+     **************************************************************************************************/
+    void AddContact(a2de::Contact& contact, a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+
+    /**************************************************************************************************
+     * <summary>Solves every contact added since the last Clear and writes the new velocities and
+     * corrected positions back to the bodies.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void Solve(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of sweeps over the velocity constraints.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <returns>The velocity iterations.</returns>
+     **************************************************************************************************/
+    std::size_t GetVelocityIterations() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the number of sweeps over the velocity constraints.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="iterations">The velocity iterations.</param>
+     **************************************************************************************************/
+    void SetVelocityIterations(std::size_t iterations);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of sweeps over the position constraints.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <returns>The position iterations.</returns>
+     **************************************************************************************************/
+    std::size_t GetPositionIterations() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the number of sweeps over the position constraints. Zero turns position
+     * correction off.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="iterations">The position iterations.</param>
+     **************************************************************************************************/
+    void SetPositionIterations(std::size_t iterations);
+
+    /**************************************************************************************************
+     * <summary>Gets the fraction of the penetration removed each frame.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <returns>The position correction.</returns>
+     **************************************************************************************************/
+    double GetPositionCorrection() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the fraction of the penetration removed each frame.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="fraction">The position correction, clamped to [0, 1].</param>
+     **************************************************************************************************/
+    void SetPositionCorrection(double fraction);
+
+    /**************************************************************************************************
+     * <summary>Gets the penetration that is allowed to remain.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <returns>The penetration slop in meters.</returns>
+     **************************************************************************************************/
+    double GetPenetrationSlop() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the penetration that is allowed to remain. A little slop keeps resting contacts
+     * touching from one frame to the next.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="slop">The penetration slop in meters.</param>
+     **************************************************************************************************/
+    void SetPenetrationSlop(double slop);
+
+    /**************************************************************************************************
+     * <summary>Query if the impulses of the last frame start the solve.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <returns>true if warm starting, false if not.</returns>
+     **************************************************************************************************/
+    bool IsWarmStarting() const;
+
+    /**************************************************************************************************
+     * <summary>Sets whether the impulses of the last frame start the solve.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="warm_starting">true to warm start.</param>
+     **************************************************************************************************/
+    void SetWarmStarting(bool warm_starting);
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>A body taking part in the solve, with its velocity copied out of the body.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    struct SolverBody {
+        /// <summary> The body </summary>
+        a2de::RigidBody* body;
+        /// <summary> The handle id of the body </summary>
+        unsigned long id;
+        /// <summary> The inverse mass, zero for static and infinite mass </summary>
+        double inverse_mass;
+        /// <summary> The x-component of the velocity </summary>
+        double velocity_x;
+        /// <summary> The y-component of the velocity </summary>
+        double velocity_y;
+        /// <summary> The x-component of the pseudo velocity that removes penetration </summary>
+        double pseudo_velocity_x;
+        /// <summary> The y-component of the pseudo velocity that removes penetration </summary>
+        double pseudo_velocity_y;
+    };
+
+    /**************************************************************************************************
+     * <summary>A manifold point prepared for the solve.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    struct SolverContact {
+        /// <summary> The manifold point that receives the impulses </summary>
+        a2de::ManifoldPoint* point;
+        /// <summary> The index of the first body </summary>
+        std::size_t first;
+        /// <summary> The index of the second body </summary>
+        std::size_t second;
+        /// <summary> The x-component of the normal, pointing from the first body to the second </summary>
+        double normal_x;
+        /// <summary> The y-component of the normal, pointing from the first body to the second </summary>
+        double normal_y;
+        /// <summary> The penetration depth at the point </summary>
+        double penetration;
+        /// <summary> One over the sum of the inverse masses </summary>
+        double effective_mass;
+        /// <summary> The combined friction coefficient </summary>
+        double friction;
+        /// <summary> The combined restitution </summary>
+        double restitution;
+        /// <summary> The separating speed restitution aims for </summary>
+        double velocity_bias;
+        /// <summary> The accumulated impulse along the normal </summary>
+        double normal_impulse;
+        /// <summary> The accumulated impulse along the tangent, the left normal of the normal </summary>
+        double tangent_impulse;
+        /// <summary> The accumulated pseudo impulse along the normal </summary>
+        double position_impulse;
+    };
+
+    /**************************************************************************************************
+     * <summary>Finds or adds the solver body of a body.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="id">  The handle id of the body.</param>
+     * <param name="body">[in,out] The body.</param>
+     * <returns>The index of the solver body.</returns>
+     **************************************************************************************************/
+    std::size_t AddBody(unsigned long id, a2de::RigidBody* body);
+
+    /**************************************************************************************************
+     * <summary>Computes the effective masses and restitution targets and applies the warm starting
+     * impulses.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    void PrepareContacts();
+
+    /**************************************************************************************************
+     * <summary>Sweeps once over the velocity constraints.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     **************************************************************************************************/
+    void SolveVelocities();
+
+    /**************************************************************************************************
+     * <summary>Sweeps once over the position constraints.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void SolvePositions(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Writes the velocities, corrected positions and impulses back.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void StoreResults(double deltaTime);
+
+    /// <summary> The bodies taking part in the solve </summary>
+    std::vector<SolverBody> _bodies;
+    /// <summary> The manifold points to solve </summary>
+    std::vector<SolverContact> _solver_contacts;
+    /// <summary> The solver body index of each handle id, or NO_BODY </summary>
+    std::vector<std::size_t> _body_lookup;
+    /// <summary> The number of sweeps over the velocity constraints </summary>
+    std::size_t _velocity_iterations;
+    /// <summary> The number of sweeps over the position constraints </summary>
+    std::size_t _position_iterations;
+    /// <summary> The fraction of the penetration removed each frame </summary>
+    double _position_correction;
+    /// <summary> The penetration that is allowed to remain </summary>
+    double _penetration_slop;
+    /// <summary> Whether the impulses of the last frame start the solve </summary>
+    bool _warm_starting;
+
+    /// <summary> Marks a handle id with no solver body </summary>
+    static const std::size_t NO_BODY;
+
+    //DO NOT COPY!
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    ContactSolver(const ContactSolver& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 8/15/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    ContactSolver& operator=(const ContactSolver& rhs);
+};
+
+A2DE_END
+
+#endif
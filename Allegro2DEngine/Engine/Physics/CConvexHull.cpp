@@ -0,0 +1,266 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CConvexHull.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the convex hull class
+ **************************************************************************************************/
+#include "CConvexHull.h"
+
+#include "CContactManifold.h"
+#include "OBB.h"
+#include "../Math/CPolygon.h"
+#include "../Math/CTriangle.h"
+#include "../Math/CRectangle.h"
+#include "../Math/CLine.h"
+#include "../Math/CVector3D.h"
+
+#include <cmath>
+#include <limits>
+
+A2DE_BEGIN
+
+const std::size_t ConvexHull::INLINE_CAPACITY;
+
+ConvexHull::ConvexHull(const a2de::Polygon& polygon) : _vertices(nullptr), _normals(nullptr), _count(polygon.GetVertices().size()), _convex(polygon.IsConvex()) {
+    if(_count == 0 || polygon.GetNormals().size() != _count) {
+        _count = 0;
+        _convex = false;
+        return;
+    }
+    _vertices = &polygon.GetVertices()[0];
+    _normals = &polygon.GetNormals()[0];
+}
+
+ConvexHull::ConvexHull(const a2de::Triangle& triangle) : _vertices(nullptr), _normals(nullptr), _count(3), _convex(true) {
+    SetVertex(0, triangle.GetPointA().GetX(), triangle.GetPointA().GetY());
+    SetVertex(1, triangle.GetPointB().GetX(), triangle.GetPointB().GetY());
+    SetVertex(2, triangle.GetPointC().GetX(), triangle.GetPointC().GetY());
+    CalculateNormals();
+}
+
+ConvexHull::ConvexHull(const a2de::Rectangle& rectangle) : _vertices(nullptr), _normals(nullptr), _count(4), _convex(true) {
+    double x = rectangle.GetX();
+    double y = rectangle.GetY();
+    double w = rectangle.GetWidth();
+    double h = rectangle.GetHeight();
+    SetVertex(0, x - w, y - h);
+    SetVertex(1, x + w, y - h);
+    SetVertex(2, x + w, y + h);
+    SetVertex(3, x - w, y + h);
+    _normal_x[0] = 0.0;  _normal_y[0] = -1.0;
+    _normal_x[1] = 1.0;  _normal_y[1] = 0.0;
+    _normal_x[2] = 0.0;  _normal_y[2] = 1.0;
+    _normal_x[3] = -1.0; _normal_y[3] = 0.0;
+}
+
+ConvexHull::ConvexHull(const a2de::Line& line) : _vertices(nullptr), _normals(nullptr), _count(2), _convex(true) {
+    const a2de::Vector2D& a = line.GetPointOne();
+    const a2de::Vector2D& b = line.GetPointTwo();
+    SetVertex(0, a.GetX(), a.GetY());
+    SetVertex(1, b.GetX(), b.GetY());
+    double dx = b.GetX() - a.GetX();
+    double dy = b.GetY() - a.GetY();
+    double length = std::sqrt(dx * dx + dy * dy);
+    if(length == 0.0) {
+        _count = 0;
+        _convex = false;
+        return;
+    }
+    _normal_x[0] = dy / length;
+    _normal_y[0] = -dx / length;
+    _normal_x[1] = -_normal_x[0];
+    _normal_y[1] = -_normal_y[0];
+}
+
+ConvexHull::ConvexHull(const a2de::OBB& obb) : _vertices(nullptr), _normals(nullptr), _count(4), _convex(true) {
+    const a2de::Vector3D& position = obb.GetTransform().GetPosition();
+    double angle = obb.GetTransform().GetRotation().GetZ();
+    double ux = std::cos(angle);
+    double uy = std::sin(angle);
+    double vx = -uy;
+    double vy = ux;
+    double w = obb.GetHalfExtents().GetX();
+    double h = obb.GetHalfExtents().GetY();
+    double x = position.GetX();
+    double y = position.GetY();
+    SetVertex(0, x - w * ux - h * vx, y - w * uy - h * vy);
+    SetVertex(1, x + w * ux - h * vx, y + w * uy - h * vy);
+    SetVertex(2, x + w * ux + h * vx, y + w * uy + h * vy);
+    SetVertex(3, x - w * ux + h * vx, y - w * uy + h * vy);
+    _normal_x[0] = -vx; _normal_y[0] = -vy;
+    _normal_x[1] = ux;  _normal_y[1] = uy;
+    _normal_x[2] = vx;  _normal_y[2] = vy;
+    _normal_x[3] = -ux; _normal_y[3] = -uy;
+}
+
+ConvexHull::~ConvexHull() {
+    _vertices = nullptr;
+    _normals = nullptr;
+    _count = 0;
+}
+
+std::size_t ConvexHull::GetVertexCount() const {
+    return _count;
+}
+
+double ConvexHull::GetVertexX(std::size_t index) const {
+    return _vertices ? _vertices[index].GetX() : _vertex_x[index];
+}
+
+double ConvexHull::GetVertexY(std::size_t index) const {
+    return _vertices ? _vertices[index].GetY() : _vertex_y[index];
+}
+
+double ConvexHull::GetNormalX(std::size_t index) const {
+    return _normals ? _normals[index].GetX() : _normal_x[index];
+}
+
+double ConvexHull::GetNormalY(std::size_t index) const {
+    return _normals ? _normals[index].GetY() : _normal_y[index];
+}
+
+bool ConvexHull::IsConvex() const {
+    return _convex;
+}
+
+void ConvexHull::SetVertex(std::size_t index, double x, double y) {
+    _vertex_x[index] = x;
+    _vertex_y[index] = y;
+}
+
+void ConvexHull::CalculateNormals() {
+    double twice_area = 0.0;
+    for(std::size_t i = 0; i < _count; ++i) {
+        std::size_t j = (i + 1) % _count;
+        twice_area += _vertex_x[i] * _vertex_y[j] - _vertex_x[j] * _vertex_y[i];
+    }
+    double winding = twice_area < 0.0 ? -1.0 : 1.0;
+    for(std::size_t i = 0; i < _count; ++i) {
+        std::size_t j = (i + 1) % _count;
+        double dx = _vertex_x[j] - _vertex_x[i];
+        double dy = _vertex_y[j] - _vertex_y[i];
+        double length = std::sqrt(dx * dx + dy * dy);
+        _normal_x[i] = length > 0.0 ? winding * dy / length : 0.0;
+        _normal_y[i] = length > 0.0 ? -winding * dx / length : 0.0;
+    }
+}
+
+double ConvexHull::FindMaxSeparation(const ConvexHull& hull, const ConvexHull& other, std::size_t& side) {
+    double max_separation = -std::numeric_limits<double>::max();
+    side = 0;
+    for(std::size_t i = 0; i < hull._count; ++i) {
+        double nx = hull.GetNormalX(i);
+        double ny = hull.GetNormalY(i);
+        double face = nx * hull.GetVertexX(i) + ny * hull.GetVertexY(i);
+
+        //How far the deepest vertex of the other hull is in front of this side.
+        double separation = std::numeric_limits<double>::max();
+        for(std::size_t j = 0; j < other._count; ++j) {
+            double d = nx * other.GetVertexX(j) + ny * other.GetVertexY(j) - face;
+            if(d < separation) separation = d;
+        }
+        if(separation > max_separation) {
+            max_separation = separation;
+            side = i;
+        }
+        if(max_separation > 0.0) break;
+    }
+    return max_separation;
+}
+
+std::size_t ConvexHull::ClipSegment(double xs[2], double ys[2], double nx, double ny, double offset) {
+    double d0 = nx * xs[0] + ny * ys[0] - offset;
+    double d1 = nx * xs[1] + ny * ys[1] - offset;
+    double out_x[2];
+    double out_y[2];
+    std::size_t count = 0;
+    if(d0 <= 0.0) {
+        out_x[count] = xs[0];
+        out_y[count] = ys[0];
+        ++count;
+    }
+    if(d1 <= 0.0) {
+        out_x[count] = xs[1];
+        out_y[count] = ys[1];
+        ++count;
+    }
+    if(d0 * d1 < 0.0) {
+        double t = d0 / (d0 - d1);
+        out_x[count] = xs[0] + t * (xs[1] - xs[0]);
+        out_y[count] = ys[0] + t * (ys[1] - ys[0]);
+        ++count;
+    }
+    for(std::size_t i = 0; i < count; ++i) {
+        xs[i] = out_x[i];
+        ys[i] = out_y[i];
+    }
+    return count;
+}
+
+bool ConvexHull::Collide(const ConvexHull& other, a2de::ContactManifold& manifold) const {
+    if(_convex == false || other._convex == false) return false;
+    if(_count < 2 || other._count < 2) return false;
+
+    std::size_t side_a = 0;
+    double separation_a = FindMaxSeparation(*this, other, side_a);
+    if(separation_a > 0.0) return false;
+    std::size_t side_b = 0;
+    double separation_b = FindMaxSeparation(other, *this, side_b);
+    if(separation_b > 0.0) return false;
+
+    //Favour this hull's side unless the other's is clearly better, so resting contacts do not flip
+    //their reference face from frame to frame.
+    const ConvexHull* reference = this;
+    const ConvexHull* incident = &other;
+    std::size_t reference_side = side_a;
+    bool flip = false;
+    if(separation_b > 0.98 * separation_a + 0.001) {
+        reference = &other;
+        incident = this;
+        reference_side = side_b;
+        flip = true;
+    }
+
+    double nx = reference->GetNormalX(reference_side);
+    double ny = reference->GetNormalY(reference_side);
+
+    //The incident side is the one facing most against the reference normal.
+    std::size_t incident_side = 0;
+    double min_dot = std::numeric_limits<double>::max();
+    for(std::size_t i = 0; i < incident->_count; ++i) {
+        double dot = nx * incident->GetNormalX(i) + ny * incident->GetNormalY(i);
+        if(dot < min_dot) {
+            min_dot = dot;
+            incident_side = i;
+        }
+    }
+    std::size_t incident_next = (incident_side + 1) % incident->_count;
+    double xs[2] = { incident->GetVertexX(incident_side), incident->GetVertexX(incident_next) };
+    double ys[2] = { incident->GetVertexY(incident_side), incident->GetVertexY(incident_next) };
+
+    //Clip the incident side to the ends of the reference side.
+    std::size_t reference_next = (reference_side + 1) % reference->_count;
+    double r1x = reference->GetVertexX(reference_side);
+    double r1y = reference->GetVertexY(reference_side);
+    double r2x = reference->GetVertexX(reference_next);
+    double r2y = reference->GetVertexY(reference_next);
+    double tx = r2x - r1x;
+    double ty = r2y - r1y;
+    double length = std::sqrt(tx * tx + ty * ty);
+    if(length == 0.0) return false;
+    tx /= length;
+    ty /= length;
+    if(ClipSegment(xs, ys, -tx, -ty, -(tx * r1x + ty * r1y)) < 2) return false;
+    if(ClipSegment(xs, ys, tx, ty, tx * r2x + ty * r2y) < 2) return false;
+
+    manifold.SetNormal(flip ? -nx : nx, flip ? -ny : ny);
+    double face = nx * r1x + ny * r1y;
+    for(std::size_t i = 0; i < 2; ++i) {
+        double separation = nx * xs[i] + ny * ys[i] - face;
+        if(separation <= 0.0) manifold.AddPoint(xs[i], ys[i], -separation);
+    }
+    return manifold.IsEmpty() == false;
+}
+
+A2DE_END
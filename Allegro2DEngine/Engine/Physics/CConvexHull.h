@@ -0,0 +1,197 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CConvexHull.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the convex hull class
+ **************************************************************************************************/
+#ifndef A2DE_CCONVEXHULL_H
+#define A2DE_CCONVEXHULL_H
+
+#include "../a2de_vals.h"
+
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+class Polygon;
+class Triangle;
+class Rectangle;
+class Line;
+class OBB;
+class ContactManifold;
+
+/**************************************************************************************************
+ * <summary>The vertices and outward side normals of a convex shape, for separating axis tests. A
+ * polygon's hull reads the vertices and cached normals of the polygon itself; the hulls of the
+ * small shapes keep theirs inline. Either way building a hull does not allocate, and the hull must
+ * not outlive the shape it was built from. A line is a hull of two sides facing opposite ways.</summary>
+ * <remarks>Casey Ugone, 8/18/2014.</remarks>
+ **************************************************************************************************/
+class ConvexHull {
+public:
+
+    /// <summary> The most vertices a hull keeps inline </summary>
+    static const std::size_t INLINE_CAPACITY = 4;
+
+    /**************************************************************************************************
+     * <summary>Constructor. A concave polygon gives a hull that never collides.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="polygon">The polygon.</param>
+     **************************************************************************************************/
+    explicit ConvexHull(const a2de::Polygon& polygon);
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="triangle">The triangle.</param>
+     **************************************************************************************************/
+    explicit ConvexHull(const a2de::Triangle& triangle);
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="rectangle">The rectangle.</param>
+     **************************************************************************************************/
+    explicit ConvexHull(const a2de::Rectangle& rectangle);
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="line">The line.</param>
+     **************************************************************************************************/
+    explicit ConvexHull(const a2de::Line& line);
+
+    /**************************************************************************************************
+     * <summary>Constructor. The box is turned by the z rotation of its transform.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="obb">The oriented bounding box.</param>
+     **************************************************************************************************/
+    explicit ConvexHull(const a2de::OBB& obb);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     **************************************************************************************************/
+    ~ConvexHull();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of vertices, which is also the number of sides.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <returns>The number of vertices.</returns>
+     **************************************************************************************************/
+    std::size_t GetVertexCount() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the x-component of a vertex.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="index">Zero-based index of the vertex.</param>
+     * <returns>The x-component.</returns>
+     **************************************************************************************************/
+    double GetVertexX(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the y-component of a vertex.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="index">Zero-based index of the vertex.</param>
+     * <returns>The y-component.</returns>
+     **************************************************************************************************/
+    double GetVertexY(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the x-component of the outward normal of a side, side i running from vertex i to
+     * vertex i + 1.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="index">Zero-based index of the side.</param>
+     * <returns>The x-component.</returns>
+     **************************************************************************************************/
+    double GetNormalX(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the y-component of the outward normal of a side.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="index">Zero-based index of the side.</param>
+     * <returns>The y-component.</returns>
+     **************************************************************************************************/
+    double GetNormalY(std::size_t index) const;
+
+    /**************************************************************************************************
+     * <summary>Query if the hull is convex.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <returns>true if convex, false if built from a concave polygon.</returns>
+     **************************************************************************************************/
+    bool IsConvex() const;
+
+    /**************************************************************************************************
+     * <summary>Collides two hulls. Stops at the first side normal of either hull that separates them;
+     * otherwise the side of least penetration is the reference face and the nearest side of the other
+     * hull, clipped to the reference face, gives up to two points.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="other">   The other hull.</param>
+     * <param name="manifold">[in,out] The manifold that receives the points, normal pointing from this
+     *                        hull to the other. Points are added, it is not reset.</param>
+     * <returns>true if the hulls touch, false if not.</returns>
+     **************************************************************************************************/
+    bool Collide(const ConvexHull& other, a2de::ContactManifold& manifold) const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Finds the side of a hull that the other hull penetrates least.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="hull"> The hull whose sides are tried.</param>
+     * <param name="other">The other hull.</param>
+     * <param name="side"> [out] The side found.</param>
+     * <returns>The separation along the side's normal, positive as soon as a side separates them.</returns>
+     **************************************************************************************************/
+    static double FindMaxSeparation(const ConvexHull& hull, const ConvexHull& other, std::size_t& side);
+
+    /**************************************************************************************************
+     * <summary>Clips a segment to the half plane where n·p is at most offset.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="xs">    [in,out] The x-components of the two ends.</param>
+     * <param name="ys">    [in,out] The y-components of the two ends.</param>
+     * <param name="nx">    The x-component of the plane normal.</param>
+     * <param name="ny">    The y-component of the plane normal.</param>
+     * <param name="offset">The plane offset.</param>
+     * <returns>The number of ends left, two if the segment survives.</returns>
+     **************************************************************************************************/
+    static std::size_t ClipSegment(double xs[2], double ys[2], double nx, double ny, double offset);
+
+    /**************************************************************************************************
+     * <summary>Sets an inline vertex.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     * <param name="index">Zero-based index of the vertex.</param>
+     * <param name="x">    The x-component.</param>
+     * <param name="y">    The y-component.</param>
+     **************************************************************************************************/
+    void SetVertex(std::size_t index, double x, double y);
+
+    /**************************************************************************************************
+     * <summary>Calculates the normals of the inline vertices from their winding.</summary>
+     * <remarks>Casey Ugone, 8/18/2014.</remarks>
+     **************************************************************************************************/
+    void CalculateNormals();
+
+    /// <summary> The vertices of the polygon, null when they are inline </summary>
+    const a2de::Vector2D* _vertices;
+    /// <summary> The side normals of the polygon, null when they are inline </summary>
+    const a2de::Vector2D* _normals;
+    /// <summary> The x-components of the inline vertices </summary>
+    double _vertex_x[INLINE_CAPACITY];
+    /// <summary> The y-components of the inline vertices </summary>
+    double _vertex_y[INLINE_CAPACITY];
+    /// <summary> The x-components of the inline normals </summary>
+    double _normal_x[INLINE_CAPACITY];
+    /// <summary> The y-components of the inline normals </summary>
+    double _normal_y[INLINE_CAPACITY];
+    /// <summary> The number of vertices </summary>
+    std::size_t _count;
+    /// <summary> Whether the hull is convex </summary>
+    bool _convex;
+};
+
+A2DE_END
+
+#endif
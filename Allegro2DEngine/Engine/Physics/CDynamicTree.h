@@ -0,0 +1,874 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CDynamicTree.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the dynamic bounding volume tree class
+ **************************************************************************************************/
+#ifndef A2DE_CDYNAMICTREE_H
+#define A2DE_CDYNAMICTREE_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <utility>
+
+#include "../a2de_vals.h"
+#include "../a2de_graphics.h"
+#include "../a2de_math.h"
+#include "IBroadPhase.h"
+
+A2DE_BEGIN
+
+class a2de::Shape;
+
+/**************************************************************************************************
+ * <summary>A dynamic bounding volume tree. Each element is a leaf holding the extents it is stored
+ * under and every internal node holds the union of its two children. Nodes live in a pool and refer
+ * to each other by index. Leaves are inserted next to the sibling that grows the tree's perimeter the
+ * least and every node on the path back to the root is refit and rebalanced with rotations, so the
+ * tree stays shallow for elements of any size.</summary>
+ * <remarks>Casey Ugone, 7/28/2014.</remarks>
+ **************************************************************************************************/
+template<typename T>
+class DynamicTree : public IBroadPhase<T> {
+
+public:
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="bounds">The bounds. Only used when drawing.</param>
+     **************************************************************************************************/
+    DynamicTree(const a2de::Rectangle& bounds);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     **************************************************************************************************/
+    ~DynamicTree();
+
+    /**************************************************************************************************
+     * <summary>Adds an element.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elem">The const T& to add.</param>
+     * <returns>true if it succeeds, false if it fails or the element was already added.</returns>
+     **************************************************************************************************/
+    bool Add(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Adds an element.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elem">The const T* to add.</param>
+     * <returns>true if it succeeds, false if it fails or the element was already added.</returns>
+     **************************************************************************************************/
+    bool Add(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Removes the given element.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elem">The const T& to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Remove(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Removes the given element.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elem">The const T* to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Remove(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Refits the given element and reinserts its leaf. The leaf keeps its node.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Update(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Refits the given element and reinserts its leaf. The leaf keeps its node.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Update(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Adds a range of elements.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elems">[in,out] The std::vector<T>& to add.</param>
+     **************************************************************************************************/
+    void Add(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Removes the given elements.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elems">[in,out] The std::vector<T>& to remove.</param>
+     **************************************************************************************************/
+    void Remove(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Updates the given elements.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="elems">[in,out] The elems.</param>
+     **************************************************************************************************/
+    void Update(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Clears this object to its blank/initial state. The node pool is kept for reuse.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    const a2de::Rectangle& GetBounds() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    a2de::Rectangle& GetBounds();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of elements in tree.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <returns>The total number of elements in tree.</returns>
+     **************************************************************************************************/
+    unsigned long NumberOfElementsInTree();
+
+    /**************************************************************************************************
+     * <summary>Gets the height of the tree.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <returns>The height of the root. Zero if empty or a single leaf.</returns>
+     **************************************************************************************************/
+    int GetHeight() const;
+
+    /**************************************************************************************************
+     * <summary>Queries a given area. Each element is reported once.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="area">The area.</param>
+     * <returns>The elements whose extents overlap the extents of the area.</returns>
+     **************************************************************************************************/
+    std::vector<T> Query(const a2de::Shape& area);
+
+    /**************************************************************************************************
+     * <summary>Queries the segment from start to end. Each element is reported once.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="start">The start of the ray.</param>
+     * <param name="end">  The end of the ray.</param>
+     * <returns>The elements whose extents the segment crosses.</returns>
+     **************************************************************************************************/
+    std::vector<T> QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end);
+
+    /**************************************************************************************************
+     * <summary>Gets every pair of elements whose extents overlap. Each pair is reported once.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="pairs">[in,out] The candidate pairs are appended here.</param>
+     **************************************************************************************************/
+    void QueryPairs(std::vector<std::pair<T, T> >& pairs);
+
+    /**************************************************************************************************
+     * <summary>Gets all elements.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <returns>all elements.</returns>
+     **************************************************************************************************/
+    std::vector<T> GetAllElements();
+
+    /**************************************************************************************************
+     * <summary>Draws the extents of every node.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     **************************************************************************************************/
+    void Draw(BITMAP* dest);
+
+protected:
+private:
+
+    /// <summary> The index of no node </summary>
+    static const int NULL_NODE = -1;
+
+    /// <summary> Axis-aligned extents </summary>
+    struct Extents {
+        /// <summary> The left side </summary>
+        double min_x;
+        /// <summary> The top side </summary>
+        double min_y;
+        /// <summary> The right side </summary>
+        double max_x;
+        /// <summary> The bottom side </summary>
+        double max_y;
+    };
+
+    /// <summary> A node in the pool </summary>
+    struct Node {
+        /// <summary> The extents of the leaf or the union of the children </summary>
+        Extents extents;
+        /// <summary> The element of a leaf </summary>
+        T elem;
+        /// <summary> The parent or NULL_NODE for the root </summary>
+        int parent;
+        /// <summary> The first child or NULL_NODE for a leaf </summary>
+        int child1;
+        /// <summary> The second child or NULL_NODE for a leaf </summary>
+        int child2;
+        /// <summary> The height, zero for a leaf </summary>
+        int height;
+    };
+
+    /**************************************************************************************************
+     * <summary>Gets the extents of a point.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="point">The point.</param>
+     * <returns>The extents.</returns>
+     **************************************************************************************************/
+    static Extents GetExtents(const a2de::Vector2D& point);
+
+    /**************************************************************************************************
+     * <summary>Gets the extents of a shape.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="shape">The shape.</param>
+     * <returns>The extents.</returns>
+     **************************************************************************************************/
+    static Extents GetExtents(const a2de::Shape& shape);
+
+    /**************************************************************************************************
+     * <summary>Gets the smallest extents enclosing both.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="first"> The first extents.</param>
+     * <param name="second">The second extents.</param>
+     * <returns>The union.</returns>
+     **************************************************************************************************/
+    static Extents Combine(const Extents& first, const Extents& second);
+
+    /**************************************************************************************************
+     * <summary>Gets the perimeter. Used as the insertion cost.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="extents">The extents.</param>
+     * <returns>The perimeter.</returns>
+     **************************************************************************************************/
+    static double GetPerimeter(const Extents& extents);
+
+    /**************************************************************************************************
+     * <summary>Query if two extents overlap.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="first"> The first extents.</param>
+     * <param name="second">The second extents.</param>
+     * <returns>true if they overlap, false if they do not.</returns>
+     **************************************************************************************************/
+    static bool Overlaps(const Extents& first, const Extents& second);
+
+    /**************************************************************************************************
+     * <summary>Query if the segment from start to end crosses the extents.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="extents">The extents.</param>
+     * <param name="start">  The start of the segment.</param>
+     * <param name="end">    The end of the segment.</param>
+     * <returns>true if it crosses, false if it does not.</returns>
+     **************************************************************************************************/
+    static bool Crosses(const Extents& extents, const a2de::Vector2D& start, const a2de::Vector2D& end);
+
+    /**************************************************************************************************
+     * <summary>Query if a node is a leaf.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="index">The index of the node.</param>
+     * <returns>true if a leaf, false if not.</returns>
+     **************************************************************************************************/
+    bool IsLeaf(int index) const;
+
+    /**************************************************************************************************
+     * <summary>Takes a node from the pool, growing it if needed.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <returns>The index of the node.</returns>
+     **************************************************************************************************/
+    int AllocateNode();
+
+    /**************************************************************************************************
+     * <summary>Returns a node to the pool.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="index">The index of the node.</param>
+     **************************************************************************************************/
+    void FreeNode(int index);
+
+    /**************************************************************************************************
+     * <summary>Links a leaf into the tree.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="leaf">The index of the leaf.</param>
+     **************************************************************************************************/
+    void InsertLeaf(int leaf);
+
+    /**************************************************************************************************
+     * <summary>Unlinks a leaf from the tree. The leaf itself is not freed.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="leaf">The index of the leaf.</param>
+     **************************************************************************************************/
+    void RemoveLeaf(int leaf);
+
+    /**************************************************************************************************
+     * <summary>Refits and rebalances every node from index to the root.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="index">The index of the first node.</param>
+     **************************************************************************************************/
+    void RefitAncestors(int index);
+
+    /**************************************************************************************************
+     * <summary>Rotates the taller grandchild of a node up if its children differ in height by more
+     * than one.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="index">The index of the node.</param>
+     * <returns>The index of the node now in its place.</returns>
+     **************************************************************************************************/
+    int Balance(int index);
+
+    /// <summary> The node pool </summary>
+    std::vector<Node> _nodes;
+    /// <summary> The indices of unused nodes </summary>
+    std::vector<int> _free_nodes;
+    /// <summary> The root or NULL_NODE if empty </summary>
+    int _root;
+    /// <summary> The leaf of each element </summary>
+    std::map<T, int> _lookup;
+    /// <summary> The traversal stack, kept to avoid allocating per query </summary>
+    std::vector<int> _stack;
+    /// <summary> The bounds </summary>
+    a2de::Rectangle _bounds;
+
+    //DO NOT COPY!
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    DynamicTree(const DynamicTree<T>& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 7/28/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    DynamicTree<T>& operator=(const DynamicTree<T>& rhs);
+
+};
+
+template<typename T>
+DynamicTree<T>::DynamicTree(const a2de::Rectangle& bounds) : _nodes(), _free_nodes(), _root(NULL_NODE), _lookup(), _stack(), _bounds(bounds) {
+    _bounds.SetFill(false);
+}
+
+template<typename T>
+DynamicTree<T>::~DynamicTree() {
+    _nodes.clear();
+    _lookup.clear();
+}
+
+template<typename T>
+const a2de::Rectangle& DynamicTree<T>::GetBounds() const {
+    return _bounds;
+}
+
+template<typename T>
+a2de::Rectangle& DynamicTree<T>::GetBounds() {
+    return const_cast<a2de::Rectangle&>(static_cast<const DynamicTree<T>&>(*this).GetBounds());
+}
+
+template<typename T>
+typename DynamicTree<T>::Extents DynamicTree<T>::GetExtents(const a2de::Vector2D& point) {
+    Extents result = { point.GetX(), point.GetY(), point.GetX(), point.GetY() };
+    return result;
+}
+
+template<typename T>
+typename DynamicTree<T>::Extents DynamicTree<T>::GetExtents(const a2de::Shape& shape) {
+    //Shape dimensions are half-extents about the position.
+    Extents result = { shape.GetX() - shape.GetWidth(), shape.GetY() - shape.GetHeight(), shape.GetX() + shape.GetWidth(), shape.GetY() + shape.GetHeight() };
+    return result;
+}
+
+template<typename T>
+typename DynamicTree<T>::Extents DynamicTree<T>::Combine(const Extents& first, const Extents& second) {
+    Extents result = { std::min(first.min_x, second.min_x), std::min(first.min_y, second.min_y), std::max(first.max_x, second.max_x), std::max(first.max_y, second.max_y) };
+    return result;
+}
+
+template<typename T>
+double DynamicTree<T>::GetPerimeter(const Extents& extents) {
+    return 2.0 * ((extents.max_x - extents.min_x) + (extents.max_y - extents.min_y));
+}
+
+template<typename T>
+bool DynamicTree<T>::Overlaps(const Extents& first, const Extents& second) {
+    if(first.max_x < second.min_x || second.max_x < first.min_x) return false;
+    if(first.max_y < second.min_y || second.max_y < first.min_y) return false;
+    return true;
+}
+
+template<typename T>
+bool DynamicTree<T>::Crosses(const Extents& extents, const a2de::Vector2D& start, const a2de::Vector2D& end) {
+    //Slab test: clip the segment's parameter range against each axis in turn.
+    double t_min = 0.0;
+    double t_max = 1.0;
+    double origin[2] = { start.GetX(), start.GetY() };
+    double direction[2] = { end.GetX() - start.GetX(), end.GetY() - start.GetY() };
+    double slab_min[2] = { extents.min_x, extents.min_y };
+    double slab_max[2] = { extents.max_x, extents.max_y };
+    for(std::size_t axis = 0; axis < 2; ++axis) {
+        if(a2de::Math::IsEqual(direction[axis], 0.0)) {
+            if(origin[axis] < slab_min[axis] || slab_max[axis] < origin[axis]) return false;
+            continue;
+        }
+        double t1 = (slab_min[axis] - origin[axis]) / direction[axis];
+        double t2 = (slab_max[axis] - origin[axis]) / direction[axis];
+        if(t2 < t1) std::swap(t1, t2);
+        t_min = std::max(t_min, t1);
+        t_max = std::min(t_max, t2);
+        if(t_max < t_min) return false;
+    }
+    return true;
+}
+
+template<typename T>
+bool DynamicTree<T>::IsLeaf(int index) const {
+    return _nodes[index].child1 == NULL_NODE;
+}
+
+template<typename T>
+int DynamicTree<T>::AllocateNode() {
+    int index = 0;
+    if(_free_nodes.empty()) {
+        index = static_cast<int>(_nodes.size());
+        _nodes.push_back(Node());
+    } else {
+        index = _free_nodes.back();
+        _free_nodes.pop_back();
+    }
+    Node& node = _nodes[index];
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    return index;
+}
+
+template<typename T>
+void DynamicTree<T>::FreeNode(int index) {
+    _nodes[index].height = -1;
+    _free_nodes.push_back(index);
+}
+
+template<typename T>
+void DynamicTree<T>::InsertLeaf(int leaf) {
+
+    if(_root == NULL_NODE) {
+        _root = leaf;
+        _nodes[_root].parent = NULL_NODE;
+        return;
+    }
+
+    //Descend toward the sibling that costs the least perimeter to pair with.
+    Extents leaf_extents = _nodes[leaf].extents;
+    int index = _root;
+    while(IsLeaf(index) == false) {
+        int child1 = _nodes[index].child1;
+        int child2 = _nodes[index].child2;
+
+        double perimeter = GetPerimeter(_nodes[index].extents);
+        double combined_perimeter = GetPerimeter(Combine(_nodes[index].extents, leaf_extents));
+
+        //Cost of pairing the leaf with this node.
+        double cost = 2.0 * combined_perimeter;
+
+        //Minimum cost pushed down to the children.
+        double inheritance_cost = 2.0 * (combined_perimeter - perimeter);
+
+        double cost1 = GetPerimeter(Combine(leaf_extents, _nodes[child1].extents)) + inheritance_cost;
+        if(IsLeaf(child1) == false) {
+            cost1 -= GetPerimeter(_nodes[child1].extents);
+        }
+
+        double cost2 = GetPerimeter(Combine(leaf_extents, _nodes[child2].extents)) + inheritance_cost;
+        if(IsLeaf(child2) == false) {
+            cost2 -= GetPerimeter(_nodes[child2].extents);
+        }
+
+        if(cost < cost1 && cost < cost2) break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    int sibling = index;
+    int old_parent = _nodes[sibling].parent;
+    int new_parent = AllocateNode();
+    _nodes[new_parent].parent = old_parent;
+    _nodes[new_parent].extents = Combine(leaf_extents, _nodes[sibling].extents);
+    _nodes[new_parent].height = _nodes[sibling].height + 1;
+    _nodes[new_parent].child1 = sibling;
+    _nodes[new_parent].child2 = leaf;
+    _nodes[sibling].parent = new_parent;
+    _nodes[leaf].parent = new_parent;
+
+    if(old_parent == NULL_NODE) {
+        _root = new_parent;
+    } else if(_nodes[old_parent].child1 == sibling) {
+        _nodes[old_parent].child1 = new_parent;
+    } else {
+        _nodes[old_parent].child2 = new_parent;
+    }
+
+    RefitAncestors(_nodes[leaf].parent);
+}
+
+template<typename T>
+void DynamicTree<T>::RemoveLeaf(int leaf) {
+
+    if(leaf == _root) {
+        _root = NULL_NODE;
+        return;
+    }
+
+    int parent = _nodes[leaf].parent;
+    int grand_parent = _nodes[parent].parent;
+    int sibling = _nodes[parent].child1 == leaf ? _nodes[parent].child2 : _nodes[parent].child1;
+
+    //The sibling takes the parent's place.
+    _nodes[sibling].parent = grand_parent;
+    FreeNode(parent);
+    _nodes[leaf].parent = NULL_NODE;
+
+    if(grand_parent == NULL_NODE) {
+        _root = sibling;
+        return;
+    }
+
+    if(_nodes[grand_parent].child1 == parent) {
+        _nodes[grand_parent].child1 = sibling;
+    } else {
+        _nodes[grand_parent].child2 = sibling;
+    }
+    RefitAncestors(grand_parent);
+}
+
+template<typename T>
+void DynamicTree<T>::RefitAncestors(int index) {
+    while(index != NULL_NODE) {
+        index = Balance(index);
+
+        int child1 = _nodes[index].child1;
+        int child2 = _nodes[index].child2;
+        _nodes[index].height = 1 + std::max(_nodes[child1].height, _nodes[child2].height);
+        _nodes[index].extents = Combine(_nodes[child1].extents, _nodes[child2].extents);
+
+        index = _nodes[index].parent;
+    }
+}
+
+template<typename T>
+int DynamicTree<T>::Balance(int index_a) {
+
+    Node& a = _nodes[index_a];
+    if(IsLeaf(index_a) || a.height < 2) return index_a;
+
+    int index_b = a.child1;
+    int index_c = a.child2;
+    Node& b = _nodes[index_b];
+    Node& c = _nodes[index_c];
+
+    int balance = c.height - b.height;
+
+    //Rotate c up.
+    if(balance > 1) {
+        int index_f = c.child1;
+        int index_g = c.child2;
+        Node& f = _nodes[index_f];
+        Node& g = _nodes[index_g];
+
+        c.child1 = index_a;
+        c.parent = a.parent;
+        a.parent = index_c;
+
+        if(c.parent == NULL_NODE) {
+            _root = index_c;
+        } else if(_nodes[c.parent].child1 == index_a) {
+            _nodes[c.parent].child1 = index_c;
+        } else {
+            _nodes[c.parent].child2 = index_c;
+        }
+
+        if(f.height > g.height) {
+            c.child2 = index_f;
+            a.child2 = index_g;
+            g.parent = index_a;
+            a.extents = Combine(b.extents, g.extents);
+            c.extents = Combine(a.extents, f.extents);
+            a.height = 1 + std::max(b.height, g.height);
+            c.height = 1 + std::max(a.height, f.height);
+        } else {
+            c.child2 = index_g;
+            a.child2 = index_f;
+            f.parent = index_a;
+            a.extents = Combine(b.extents, f.extents);
+            c.extents = Combine(a.extents, g.extents);
+            a.height = 1 + std::max(b.height, f.height);
+            c.height = 1 + std::max(a.height, g.height);
+        }
+        return index_c;
+    }
+
+    //Rotate b up.
+    if(balance < -1) {
+        int index_d = b.child1;
+        int index_e = b.child2;
+        Node& d = _nodes[index_d];
+        Node& e = _nodes[index_e];
+
+        b.child1 = index_a;
+        b.parent = a.parent;
+        a.parent = index_b;
+
+        if(b.parent == NULL_NODE) {
+            _root = index_b;
+        } else if(_nodes[b.parent].child1 == index_a) {
+            _nodes[b.parent].child1 = index_b;
+        } else {
+            _nodes[b.parent].child2 = index_b;
+        }
+
+        if(d.height > e.height) {
+            b.child2 = index_d;
+            a.child1 = index_e;
+            e.parent = index_a;
+            a.extents = Combine(c.extents, e.extents);
+            b.extents = Combine(a.extents, d.extents);
+            a.height = 1 + std::max(c.height, e.height);
+            b.height = 1 + std::max(a.height, d.height);
+        } else {
+            b.child2 = index_e;
+            a.child1 = index_d;
+            d.parent = index_a;
+            a.extents = Combine(c.extents, d.extents);
+            b.extents = Combine(a.extents, e.extents);
+            a.height = 1 + std::max(c.height, d.height);
+            b.height = 1 + std::max(a.height, e.height);
+        }
+        return index_b;
+    }
+
+    return index_a;
+}
+
+template<typename T>
+bool DynamicTree<T>::Add(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    if(_lookup.find(elem) != _lookup.end()) return false;
+
+    int leaf = AllocateNode();
+    _nodes[leaf].elem = elem;
+    _nodes[leaf].extents = GetExtents(bounds_of(elem));
+    _lookup.insert(std::make_pair(elem, leaf));
+    InsertLeaf(leaf);
+    return true;
+}
+
+template<typename T>
+bool DynamicTree<T>::Add(const T* elem) {
+    return Add(*elem);
+}
+
+template<typename T>
+bool DynamicTree<T>::Remove(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    typename std::map<T, int>::iterator _iter = _lookup.find(elem);
+    if(_iter == _lookup.end()) return false;
+
+    int leaf = _iter->second;
+    _lookup.erase(_iter);
+    RemoveLeaf(leaf);
+    FreeNode(leaf);
+    return true;
+}
+
+template<typename T>
+bool DynamicTree<T>::Remove(const T* elem) {
+    return Remove(*elem);
+}
+
+template<typename T>
+bool DynamicTree<T>::Update(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    typename std::map<T, int>::iterator _iter = _lookup.find(elem);
+    if(_iter == _lookup.end()) return false;
+
+    int leaf = _iter->second;
+    RemoveLeaf(leaf);
+    refit(elem);
+    _nodes[leaf].extents = GetExtents(bounds_of(elem));
+    InsertLeaf(leaf);
+    return true;
+}
+
+template<typename T>
+bool DynamicTree<T>::Update(const T* elem) {
+    return Update(*elem);
+}
+
+template<typename T>
+void DynamicTree<T>::Add(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Add(*_iter);
+    }
+}
+
+template<typename T>
+void DynamicTree<T>::Remove(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Remove(*_iter);
+    }
+}
+
+template<typename T>
+void DynamicTree<T>::Update(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Update(*_iter);
+    }
+}
+
+template<typename T>
+void DynamicTree<T>::Clear() {
+    _free_nodes.clear();
+    _free_nodes.reserve(_nodes.size());
+    for(int i = static_cast<int>(_nodes.size()) - 1; i >= 0; --i) {
+        FreeNode(i);
+    }
+    _root = NULL_NODE;
+    _lookup.clear();
+}
+
+template<typename T>
+unsigned long DynamicTree<T>::NumberOfElementsInTree() {
+    return _lookup.size();
+}
+
+template<typename T>
+int DynamicTree<T>::GetHeight() const {
+    if(_root == NULL_NODE) return 0;
+    return _nodes[_root].height;
+}
+
+template<typename T>
+std::vector<T> DynamicTree<T>::Query(const a2de::Shape& area) {
+    std::vector<T> selected_elements;
+    if(_root == NULL_NODE) return selected_elements;
+
+    Extents area_extents = GetExtents(area);
+    _stack.clear();
+    _stack.push_back(_root);
+    while(_stack.empty() == false) {
+        int index = _stack.back();
+        _stack.pop_back();
+        const Node& node = _nodes[index];
+        if(Overlaps(node.extents, area_extents) == false) continue;
+        if(IsLeaf(index)) {
+            selected_elements.push_back(node.elem);
+            continue;
+        }
+        _stack.push_back(node.child1);
+        _stack.push_back(node.child2);
+    }
+    return selected_elements;
+}
+
+template<typename T>
+std::vector<T> DynamicTree<T>::QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end) {
+    std::vector<T> selected_elements;
+    if(_root == NULL_NODE) return selected_elements;
+
+    _stack.clear();
+    _stack.push_back(_root);
+    while(_stack.empty() == false) {
+        int index = _stack.back();
+        _stack.pop_back();
+        const Node& node = _nodes[index];
+        if(Crosses(node.extents, start, end) == false) continue;
+        if(IsLeaf(index)) {
+            selected_elements.push_back(node.elem);
+            continue;
+        }
+        _stack.push_back(node.child1);
+        _stack.push_back(node.child2);
+    }
+    return selected_elements;
+}
+
+template<typename T>
+void DynamicTree<T>::QueryPairs(std::vector<std::pair<T, T> >& pairs) {
+    //Query the tree with each leaf and keep only partners with a higher index so each pair is reported once.
+    for(typename std::map<T, int>::iterator _iter = _lookup.begin(); _iter != _lookup.end(); ++_iter) {
+        int leaf = _iter->second;
+        const Extents& leaf_extents = _nodes[leaf].extents;
+        _stack.clear();
+        _stack.push_back(_root);
+        while(_stack.empty() == false) {
+            int index = _stack.back();
+            _stack.pop_back();
+            const Node& node = _nodes[index];
+            if(Overlaps(node.extents, leaf_extents) == false) continue;
+            if(IsLeaf(index)) {
+                if(index > leaf) {
+                    pairs.push_back(std::make_pair(_nodes[leaf].elem, node.elem));
+                }
+                continue;
+            }
+            _stack.push_back(node.child1);
+            _stack.push_back(node.child2);
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> DynamicTree<T>::GetAllElements() {
+    std::vector<T> total_elements;
+    total_elements.reserve(_lookup.size());
+    for(typename std::map<T, int>::iterator _iter = _lookup.begin(); _iter != _lookup.end(); ++_iter) {
+        total_elements.push_back(_iter->first);
+    }
+    return total_elements;
+}
+
+template<typename T>
+void DynamicTree<T>::Draw(BITMAP* dest) {
+    if(dest == nullptr) return;
+
+    a2de::Color color = _bounds.GetColor();
+    if(_root != NULL_NODE) {
+        _stack.clear();
+        _stack.push_back(_root);
+        while(_stack.empty() == false) {
+            int index = _stack.back();
+            _stack.pop_back();
+            const Node& node = _nodes[index];
+            double half_width = (node.extents.max_x - node.extents.min_x) / 2.0;
+            double half_height = (node.extents.max_y - node.extents.min_y) / 2.0;
+            a2de::Rectangle extents(node.extents.min_x + half_width, node.extents.min_y + half_height, half_width, half_height, color, false);
+            extents.Draw(dest, color, false);
+            if(IsLeaf(index)) continue;
+            _stack.push_back(node.child1);
+            _stack.push_back(node.child2);
+        }
+    }
+    _bounds.Draw(dest, color, false);
+}
+
+A2DE_END
+
+#endif
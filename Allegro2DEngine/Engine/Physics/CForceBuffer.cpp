@@ -0,0 +1,106 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CForceBuffer.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the force buffer class
+ **************************************************************************************************/
+#include "CForceBuffer.h"
+
+A2DE_BEGIN
+
+const std::size_t ForceBuffer::INLINE_CAPACITY;
+
+ForceBuffer::ForceBuffer() : _overflow(), _count(0) {
+    /* DO NOTHING */
+}
+
+ForceBuffer::ForceBuffer(const ForceBuffer& other) : _overflow(), _count(0) {
+    for(std::size_t i = 0; i < other._count; ++i) {
+        PushBack(other[i]);
+    }
+}
+
+ForceBuffer& ForceBuffer::operator=(const ForceBuffer& rhs) {
+    if(this == &rhs) return *this;
+
+    Clear();
+    for(std::size_t i = 0; i < rhs._count; ++i) {
+        PushBack(rhs[i]);
+    }
+    return *this;
+}
+
+ForceBuffer::~ForceBuffer() {
+    _overflow.clear();
+    _count = 0;
+}
+
+void ForceBuffer::Add(const a2de::Vector2D& force, double duration) {
+    if(duration < 0.0) return;
+    a2de::TimedForce f;
+    f.x = force.GetX();
+    f.y = force.GetY();
+    f.duration = duration;
+    PushBack(f);
+}
+
+void ForceBuffer::PushBack(const a2de::TimedForce& force) {
+    if(_count < INLINE_CAPACITY) {
+        _inline[_count++] = force;
+        return;
+    }
+    std::size_t overflow_index = _count - INLINE_CAPACITY;
+    if(overflow_index < _overflow.size()) {
+        _overflow[overflow_index] = force;
+    } else {
+        _overflow.push_back(force);
+    }
+    ++_count;
+}
+
+void ForceBuffer::Clear() {
+    _count = 0;
+}
+
+a2de::Vector2D ForceBuffer::Sum() const {
+    double x = 0.0;
+    double y = 0.0;
+    for(std::size_t i = 0; i < _count; ++i) {
+        const a2de::TimedForce& f = (*this)[i];
+        x += f.x;
+        y += f.y;
+    }
+    return a2de::Vector2D(x, y);
+}
+
+void ForceBuffer::Age(double deltaTime) {
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < _count; ++i) {
+        a2de::TimedForce& f = At(i);
+        f.duration -= deltaTime;
+        if(f.duration < 0.0) continue;
+        if(kept != i) At(kept) = f;
+        ++kept;
+    }
+    _count = kept;
+}
+
+bool ForceBuffer::IsEmpty() const {
+    return _count == 0;
+}
+
+std::size_t ForceBuffer::GetSize() const {
+    return _count;
+}
+
+const a2de::TimedForce& ForceBuffer::operator[](std::size_t index) const {
+    if(index < INLINE_CAPACITY) return _inline[index];
+    return _overflow[index - INLINE_CAPACITY];
+}
+
+a2de::TimedForce& ForceBuffer::At(std::size_t index) {
+    return const_cast<a2de::TimedForce&>(static_cast<const ForceBuffer&>(*this)[index]);
+}
+
+A2DE_END
@@ -0,0 +1,155 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CForceBuffer.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the force buffer class
+ **************************************************************************************************/
+#ifndef A2DE_CFORCEBUFFER_H
+#define A2DE_CFORCEBUFFER_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>A force that keeps acting on a body until its duration runs out.</summary>
+ * <remarks>Casey Ugone, 8/12/2014.</remarks>
+ **************************************************************************************************/
+struct TimedForce {
+    TimedForce() {
+        x = 0.0;
+        y = 0.0;
+        duration = 0.0;
+    }
+    /// <summary> The x component of the force </summary>
+    double x;
+    /// <summary> The y component of the force </summary>
+    double y;
+    /// <summary> The time left before the force stops acting </summary>
+    double duration;
+};
+
+/**************************************************************************************************
+ * <summary>The timed forces of a body. The first few live inside the buffer itself and the rest
+ * spill into an overflow vector that is kept between frames, so adding a force only allocates when
+ * a body holds more forces than it ever has before. Clearing only resets the count.</summary>
+ * <remarks>Casey Ugone, 8/12/2014.</remarks>
+ **************************************************************************************************/
+class ForceBuffer {
+public:
+
+    /// <summary> The number of forces held without touching the overflow vector </summary>
+    static const std::size_t INLINE_CAPACITY = 4;
+
+    /**************************************************************************************************
+     * <summary>Default constructor.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     **************************************************************************************************/
+    ForceBuffer();
+
+    /**************************************************************************************************
+     * <summary>Copy constructor. Copies only the forces still held.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    ForceBuffer(const ForceBuffer& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator. Copies only the forces still held.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    ForceBuffer& operator=(const ForceBuffer& rhs);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     **************************************************************************************************/
+    ~ForceBuffer();
+
+    /**************************************************************************************************
+     * <summary>Adds a force.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="force">   The force.</param>
+     * <param name="duration">How long the force acts.</param>
+     **************************************************************************************************/
+    void Add(const a2de::Vector2D& force, double duration);
+
+    /**************************************************************************************************
+     * <summary>Removes every force. Keeps the overflow vector's memory.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Sums the forces.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <returns>The total force.</returns>
+     **************************************************************************************************/
+    a2de::Vector2D Sum() const;
+
+    /**************************************************************************************************
+     * <summary>Shortens the duration of every force and removes, in place, those that ran out. The
+     * order of the remaining forces is kept.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void Age(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Query if the buffer holds no forces.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <returns>true if empty, false if not.</returns>
+     **************************************************************************************************/
+    bool IsEmpty() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the number of forces.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <returns>The number of forces.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+    /**************************************************************************************************
+     * <summary>Gets a force.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="index">Zero-based index of the force, less than GetSize().</param>
+     * <returns>The force.</returns>
+     **************************************************************************************************/
+    const a2de::TimedForce& operator[](std::size_t index) const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Gets a force.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="index">Zero-based index of the force, less than GetSize().</param>
+     * <returns>The force.</returns>
+     **************************************************************************************************/
+    a2de::TimedForce& At(std::size_t index);
+
+    /**************************************************************************************************
+     * <summary>Appends a force without checking its duration.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <param name="force">The force.</param>
+     **************************************************************************************************/
+    void PushBack(const a2de::TimedForce& force);
+
+    /// <summary> The first INLINE_CAPACITY forces </summary>
+    a2de::TimedForce _inline[INLINE_CAPACITY];
+    /// <summary> The forces past INLINE_CAPACITY. Entries at or past _count - INLINE_CAPACITY are stale and get overwritten </summary>
+    std::vector<a2de::TimedForce> _overflow;
+    /// <summary> The number of forces held </summary>
+    std::size_t _count;
+};
+
+A2DE_END
+
+#endif
@@ -3,54 +3,70 @@
 // A2DE
 // Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
 // Contact cugone@gmail.com for questions or support.
-// summary:	Declares the quad tree class
+// summary:	Declares the uniform grid class
  **************************************************************************************************/
 #ifndef A2DE_CGRID_H
 #define A2DE_CGRID_H
 
 #include <vector>
-#include <list>
 #include <algorithm>
 #include <iterator>
+#include <utility>
+#include <cmath>
 
 #include "../a2de_vals.h"
 #include "../a2de_graphics.h"
 #include "../a2de_math.h"
+#include "IBroadPhase.h"
 
 A2DE_BEGIN
 
 class a2de::Shape;
 class a2de::Color;
 
+/**************************************************************************************************
+ * <summary>A uniform grid stored as a spatial hash. Every element is placed in each cell its extents
+ * overlap and cells are hashed into a fixed number of buckets, so the grid is unbounded and insertion
+ * and queries cost time proportional to the number of cells touched.</summary>
+ * <remarks>Casey Ugone, 7/22/2014.</remarks>
+ **************************************************************************************************/
 template<typename T>
-class Grid {
+class Grid : public IBroadPhase<T> {
 
 public:
 
     /**************************************************************************************************
      * <summary>Constructor.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="bounds">The bounds.</param>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="bounds">The bounds. Cells are aligned to the top-left corner.</param>
      **************************************************************************************************/
     Grid(const a2de::Rectangle& bounds);
 
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="bounds">   The bounds. Cells are aligned to the top-left corner.</param>
+     * <param name="cell_size">Size of each cell in meters.</param>
+     **************************************************************************************************/
+    Grid(const a2de::Rectangle& bounds, double cell_size);
+
     /**************************************************************************************************
      * <summary>Destructor.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      **************************************************************************************************/
     ~Grid();
 
     /**************************************************************************************************
-     * <summary>Adds an element to the tree.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Adds an element to the grid.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elem">The const T& to add.</param>
      * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
     bool Add(const T& elem);
 
     /**************************************************************************************************
-     * <summary>Adds an element to the tree.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Adds an element to the grid.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elem">The const T* to add.</param>
      * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
@@ -58,7 +74,7 @@ public:
 
     /**************************************************************************************************
      * <summary>Removes the given element.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elem">The const T& to remove.</param>
      * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
@@ -66,7 +82,7 @@ public:
 
     /**************************************************************************************************
      * <summary>Removes the given element.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elem">The const T* to remove.</param>
      * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
@@ -74,7 +90,7 @@ public:
 
     /**************************************************************************************************
      * <summary>Updates the given element.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elem">The element.</param>
      * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
@@ -82,7 +98,7 @@ public:
 
     /**************************************************************************************************
      * <summary>Updates the given element.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elem">The element.</param>
      * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
@@ -90,204 +106,209 @@ public:
 
     /**************************************************************************************************
      * <summary>Adds a range of elements.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elems">[in,out] The std::vector<T>& to add.</param>
      **************************************************************************************************/
     void Add(std::vector<T>& elems);
 
     /**************************************************************************************************
      * <summary>Removes the given elements.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elems">[in,out] The std::vector<T>& to remove.</param>
      **************************************************************************************************/
     void Remove(std::vector<T>& elems);
 
     /**************************************************************************************************
      * <summary>Updates the given elements.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="elems">[in,out] The elems.</param>
      **************************************************************************************************/
     void Update(std::vector<T>& elems);
 
     /**************************************************************************************************
-     * <summary>Clears this object to its blank/initial state.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Clears this object to its blank/initial state. Bucket storage is kept for reuse.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      **************************************************************************************************/
     void Clear();
 
     /**************************************************************************************************
-     * <summary>Clears the node to its blank/initial state.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
-     **************************************************************************************************/
-    void Clear(Grid<T>* node);
-
-    /**************************************************************************************************
-     * <summary>Gets the node bounds.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Gets the bounds.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <returns>The bounds.</returns>
      **************************************************************************************************/
     const a2de::Rectangle& GetBounds() const;
 
     /**************************************************************************************************
      * <summary>Gets the bounds.</summary>
-     * <remarks>Casey Ugone, 8/22/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <returns>The bounds.</returns>
      **************************************************************************************************/
     a2de::Rectangle& GetBounds();
 
     /**************************************************************************************************
-     * <summary>Gets the tree height.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>.</returns>
+     * <summary>Gets the cell size.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <returns>The cell size in meters.</returns>
      **************************************************************************************************/
-    unsigned long Height();
+    double GetCellSize() const;
 
     /**************************************************************************************************
-     * <summary>Gets the tree divisions.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>.</returns>
+     * <summary>Sets the cell size and rehashes every element.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="cell_size">Size of each cell in meters. Values less than or equal to zero are ignored.</param>
      **************************************************************************************************/
-    unsigned long Divisions();
+    void SetCellSize(double cell_size);
 
     /**************************************************************************************************
-     * <summary>Gets the number of elements in tree.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>The total number of elements in tree.</returns>
+     * <summary>Gets the number of elements in grid.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <returns>The total number of elements in grid.</returns>
      **************************************************************************************************/
-    unsigned long NumberOfElementsInTree();
+    unsigned long NumberOfElementsInGrid();
 
     /**************************************************************************************************
-     * <summary>Queries a given area.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Queries a given area. Each element is reported once.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="area">The area.</param>
-     * <returns>.</returns>
+     * <returns>The elements whose extents overlap the extents of the area.</returns>
      **************************************************************************************************/
     std::vector<T> Query(const a2de::Shape& area);
 
     /**************************************************************************************************
-     * <summary>Gets the nodes by element.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="elem">[in,out] The element.</param>
-     * <returns>null if it fails, else the nodes by element.</returns>
+     * <summary>Gets every pair of elements whose extents overlap. Each pair is reported once.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="pairs">[in,out] The candidate pairs are appended here.</param>
      **************************************************************************************************/
-    std::vector<Grid<T>*> GetNodesByElement(T& elem);
+    void QueryPairs(std::vector<std::pair<T, T> >& pairs);
 
     /**************************************************************************************************
-     * <summary>Gets the nodes by location.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="loc">[in,out] The location.</param>
-     * <returns>null if it fails, else the nodes by location.</returns>
+     * <summary>Gets all elements.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <returns>all elements.</returns>
      **************************************************************************************************/
-    std::vector<Grid<T>*> GetNodesByLocation(a2de::Vector2D& loc);
+    std::vector<T> GetAllElements();
 
     /**************************************************************************************************
-     * <summary>Gets the sibling nodes.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
-     * <returns>null if it fails, else the siblings.</returns>
+     * <summary>Draws the cells that cover the bounds.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="dest">[in,out] If non-null, destination for the.</param>
      **************************************************************************************************/
-    std::vector<Grid<T>*> GetSiblings(Grid<T>* node);
+    void Draw(BITMAP* dest);
 
     /**************************************************************************************************
-     * <summary>Gets all elements.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>all elements.</returns>
+     * <summary>Sets the cell color.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="color">The color.</param>
      **************************************************************************************************/
-    std::vector<T> GetAllElements();
+    void SetCellColor(const a2de::Color& color);
 
     /**************************************************************************************************
-     * <summary>Draws the tree.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="dest">         [in,out] If non-null, destination for the.</param>
-     * <param name="top_to_bottom">true to top to bottom.</param>
+     * <summary>Gets the cell color.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <returns>The cell color.</returns>
      **************************************************************************************************/
-    void Draw(BITMAP* dest, bool top_to_bottom);
+    const a2de::Color& GetCellColor();
 
     /**************************************************************************************************
-     * <summary>Gets the maximum elements per node.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>The maximum elements per node.</returns>
+     * <summary>Resets the cell color.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      **************************************************************************************************/
-    static unsigned long GetMaxElementsPerNode();
+    void ResetCellColor();
+
+    /// <summary> The default cell size in meters </summary>
+    static double DEFAULT_CELL_SIZE;
+
+protected:
+private:
+
+    /// <summary> The number of hash buckets. Must be a power of two. </summary>
+    static std::size_t BUCKET_COUNT;
+    /// <summary> The default cell color </summary>
+    a2de::Color DEFAULT_CELL_COLOR;
 
     /**************************************************************************************************
-     * <summary>Sets the maximum elements per node.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="max_elements">The maximum elements.</param>
+     * <summary>Gets the extents of a point.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="point">The point.</param>
+     * <param name="min">  [out] The top-left corner.</param>
+     * <param name="max">  [out] The bottom-right corner.</param>
      **************************************************************************************************/
-    static void SetMaxElementsPerNode(unsigned long max_elements);
+    static void GetExtents(const a2de::Vector2D& point, a2de::Vector2D& min, a2de::Vector2D& max);
 
     /**************************************************************************************************
-     * <summary>Sets the node color.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="color">The color.</param>
+     * <summary>Gets the extents of a shape.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="shape">The shape.</param>
+     * <param name="min">  [out] The top-left corner.</param>
+     * <param name="max">  [out] The bottom-right corner.</param>
      **************************************************************************************************/
-    void SetNodeColor(const a2de::Color& color);
+    static void GetExtents(const a2de::Shape& shape, a2de::Vector2D& min, a2de::Vector2D& max);
 
     /**************************************************************************************************
-     * <summary>Gets the node color.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>The node color.</returns>
+     * <summary>Gets the cell a coordinate falls in along one axis.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="coordinate">The coordinate.</param>
+     * <param name="origin">    The coordinate of the first cell's edge.</param>
+     * <returns>The cell index. May be negative.</returns>
      **************************************************************************************************/
-    const a2de::Color& GetNodeColor();
-    
-    void ResetNodeColor();
+    long GetCell(double coordinate, double origin) const;
 
-protected:
-private:
-
-    /// <summary> The default node color </summary>
-    a2de::Color DEFAULT_NODE_COLOR;
-    
     /**************************************************************************************************
-     * <summary>Queries a node.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">             [in,out] If non-null, the node.</param>
-     * <param name="area">             The area.</param>
-     * <param name="selected_elements">[in,out] The selected elements.</param>
+     * <summary>Gets the bucket a cell hashes to.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="x">The cell column.</param>
+     * <param name="y">The cell row.</param>
+     * <returns>The bucket index.</returns>
      **************************************************************************************************/
-    void QueryNode(Grid<T>* node, const a2de::Shape& area, std::vector<T>& selected_elements);
+    std::size_t GetBucket(long x, long y) const;
 
     /**************************************************************************************************
-     * <summary>Removes the element described by elem.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="elem">The element.</param>
-     * <returns>true if it succeeds, false if it fails.</returns>
+     * <summary>Gets the range of cells covered by the extents.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="min">  The top-left corner.</param>
+     * <param name="max">  The bottom-right corner.</param>
+     * <param name="min_x">[out] The first column.</param>
+     * <param name="min_y">[out] The first row.</param>
+     * <param name="max_x">[out] The last column.</param>
+     * <param name="max_y">[out] The last row.</param>
      **************************************************************************************************/
-    bool RemoveElement(const T& elem);
+    void GetCellRange(const a2de::Vector2D& min, const a2de::Vector2D& max, long& min_x, long& min_y, long& max_x, long& max_y) const;
 
     /**************************************************************************************************
-     * <summary>Gets the elements.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
-     * <returns>The elements.</returns>
+     * <summary>Gets the cell that owns the overlap of two extents. Reporting results only from this
+     * cell keeps an element or pair that spans several cells from being reported more than once.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="first_min"> The top-left corner of the first extents.</param>
+     * <param name="first_max"> The bottom-right corner of the first extents.</param>
+     * <param name="second_min">The top-left corner of the second extents.</param>
+     * <param name="second_max">The bottom-right corner of the second extents.</param>
+     * <param name="x">         [out] The owning column.</param>
+     * <param name="y">         [out] The owning row.</param>
+     * <returns>true if the extents overlap, false if they do not.</returns>
      **************************************************************************************************/
-    std::vector<T> GetElements(Grid<T>* node);
-    
-    /// <summary> The elements </summary>
-    std::vector<T> _elements;
+    bool GetOwningCell(const a2de::Vector2D& first_min, const a2de::Vector2D& first_max, const a2de::Vector2D& second_min, const a2de::Vector2D& second_max, long& x, long& y) const;
+
+    /// <summary> The buckets </summary>
+    std::vector<std::vector<T> > _buckets;
     /// <summary> The bounds </summary>
     a2de::Rectangle _bounds;
-
-    /// <summary> The grid of rectangles </summary>
-    std::vector<a2de::Rectangle> _grid;
-
-    /// <summary> The dimensions of each cell </summary>
-    a2de::Vector2D _cell_dimensions;
+    /// <summary> The size of each cell </summary>
+    double _cell_size;
+    /// <summary> The number of elements </summary>
+    unsigned long _element_count;
 
     //DO NOT COPY!
 
     /**************************************************************************************************
      * <summary>Copy constructor.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="other">The other.</param>
      **************************************************************************************************/
     Grid(const Grid<T>& other);
 
     /**************************************************************************************************
      * <summary>Assignment operator.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
      * <param name="rhs">The right hand side.</param>
      * <returns>A shallow copy of this object.</returns>
      **************************************************************************************************/
@@ -295,59 +316,29 @@ private:
 
 };
 
-
-template<typename T>
-T* ptr(T& obj) {
-    //turn reference into pointer!
-    return &obj;
-}
-
-template<typename T>
-T* ptr(T* obj) {
-    //obj is already pointer, return it!
-    return obj;
-}
-
 template<typename T>
-unsigned long Grid<T>::MAX_ELEMENTS = 2;
+double Grid<T>::DEFAULT_CELL_SIZE = 1.0;
 
 template<typename T>
-std::size_t Grid<T>::MAX_CHILDREN = 4;
-
+std::size_t Grid<T>::BUCKET_COUNT = 4096;
 
 template<typename T>
-Grid<T>::Grid(const a2de::Rectangle& bounds) : _elements(), _bounds(bounds), _parent(nullptr), _children(4) {
-    DEFAULT_NODE_COLOR = a2de::Color::WHITE();
-    _bounds.SetColor(_bounds.GetColor());
+Grid<T>::Grid(const a2de::Rectangle& bounds) : _buckets(BUCKET_COUNT), _bounds(bounds), _cell_size(DEFAULT_CELL_SIZE), _element_count(0) {
+    DEFAULT_CELL_COLOR = a2de::Color::WHITE();
     _bounds.SetFill(false);
 }
 
 template<typename T>
-Grid<T>::Grid(Grid<T>* parent_node, const a2de::Rectangle& bounds) : _elements(), _bounds(bounds), _parent(parent_node), _children(4) {
-    DEFAULT_NODE_COLOR = a2de::Color::WHITE();
-    _bounds.SetColor(_bounds.GetColor());
+Grid<T>::Grid(const a2de::Rectangle& bounds, double cell_size) : _buckets(BUCKET_COUNT), _bounds(bounds), _cell_size(cell_size > 0.0 ? cell_size : DEFAULT_CELL_SIZE), _element_count(0) {
+    DEFAULT_CELL_COLOR = a2de::Color::WHITE();
     _bounds.SetFill(false);
 }
 
-template<typename T>
-Grid<T>::Grid(Grid<T>* parent_node, const a2de::Rectangle& bounds, std::vector<T>& elems) : _elements(elems), _bounds(bounds), _parent(parent_node), _children(4) {
-    DEFAULT_NODE_COLOR = a2de::Color::WHITE();
-    _bounds.SetColor(_bounds.GetColor());
-    _bounds.SetFill(false);
-    Add(elems);
-}
-
 template<typename T>
 Grid<T>::~Grid() {
-    this->_elements.clear();
-    this->_parent = nullptr;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        delete this->_children[i];
-        this->_children[i] = nullptr;
-    }
+    _buckets.clear();
 }
 
-
 template<typename T>
 const a2de::Rectangle& Grid<T>::GetBounds() const {
     return _bounds;
@@ -359,411 +350,298 @@ a2de::Rectangle& Grid<T>::GetBounds() {
 }
 
 template<typename T>
-std::vector<Grid<T>*> Grid<T>::GetNodesByElement(T& elem) {
-
-    std::vector<Grid<T>*> result;
-    if(IsLeaf(this) == false) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            std::vector<Grid<T>*> child_result = _children[i]->GetNodesByElement(elem);
-        }
-    } else {
-        std::vector<T>::iterator _iter;
-        if((_iter = std::find(_elements.begin(), _elements.end(), elem)) != _elements.end()) {
-            result.push_back(this);
-        }
-    }
-    return result;
+double Grid<T>::GetCellSize() const {
+    return _cell_size;
 }
 
 template<typename T>
-void Grid<T>::Remove(std::vector<T>& elems) {
-    std::vector<T>::iterator b = elems.begin();
-    std::vector<T>::iterator e = elems.end();
-    for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
-        this->Remove(*_iter);
-    }
+void Grid<T>::SetCellSize(double cell_size) {
+    if(cell_size < 0.0 || a2de::Math::IsEqual(cell_size, 0.0)) return;
+    if(a2de::Math::IsEqual(cell_size, _cell_size)) return;
+    //Gather under the old cell size before the buckets move.
+    std::vector<T> elems(GetAllElements());
+    Clear();
+    _cell_size = cell_size;
+    Add(elems);
 }
 
 template<typename T>
-std::vector<Grid<T>*> Grid<T>::GetNodesByLocation(a2de::Vector2D& loc) {
-    std::vector<Grid<T>*> results;
-    if(_bounds.Intersects(loc)) {
-        if(IsLeaf(this) == false) {
-            std::vector<Grid<T>*> child_results;
-            for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-                child_results = _children[i]->GetNodesByLocation(loc);
-                std::vector<Grid<T>*>::iterator b = child_results.begin();
-                std::vector<Grid<T>*>::iterator e = child_results.end();
-                for(std::vector<Grid<T>*>::iterator _iter = b; _iter != e; ++_iter) {
-                    results.push_back(*_iter);
-                }
-                child_results.clear();
-            }
-        } else {
-            results.push_back(this);
-        }
-    }
-    return results;
+void Grid<T>::GetExtents(const a2de::Vector2D& point, a2de::Vector2D& min, a2de::Vector2D& max) {
+    min = point;
+    max = point;
 }
 
 template<typename T>
-void Grid<T>::Add(std::vector<T>& elems) {
-    std::vector<T>::iterator b = elems.begin();
-    std::vector<T>::iterator e = elems.end();
-    for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
-        this->Add(*_iter);
-    }
+void Grid<T>::GetExtents(const a2de::Shape& shape, a2de::Vector2D& min, a2de::Vector2D& max) {
+    //Shape dimensions are half-extents about the position.
+    a2de::Vector2D half_extents(shape.GetWidth(), shape.GetHeight());
+    min = shape.GetPosition() - half_extents;
+    max = shape.GetPosition() + half_extents;
 }
 
 template<typename T>
-std::vector<Grid<T>*> Grid<T>::GetSiblings(Grid<T>* node) {
-    std::vector<Grid<T>*> siblings;
-    if(node == nullptr) return siblings;
-    if(node->_parent == nullptr) {
-        siblings.push_back(node);
-        return siblings;
-    }
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        siblings.push_back(_parent->_children[i]);
-    }
-    return siblings;
-
+long Grid<T>::GetCell(double coordinate, double origin) const {
+    return static_cast<long>(std::floor((coordinate - origin) / _cell_size));
 }
 
 template<typename T>
-std::vector<T> Grid<T>::GetAllElements() {
-    return this->GetElements(this);
+std::size_t Grid<T>::GetBucket(long x, long y) const {
+    std::size_t h = (static_cast<std::size_t>(x) * 73856093u) ^ (static_cast<std::size_t>(y) * 19349663u);
+    return h & (BUCKET_COUNT - 1);
 }
 
 template<typename T>
-std::vector<T> Grid<T>::GetElements(Grid<T>* node) {
-    class IsInTotal {
-    public:
-        IsInTotal(std::vector<T>* total_elements) : _total_elements(total_elements) { }
-        bool operator()(T& elem) {
-            return std::find(_total_elements->begin(), _total_elements->end(), elem) == _total_elements->end();
-        }
-    private:
-        std::vector<T>* _total_elements;
-    };
-    std::vector<T> total_elements;
-    if(node == nullptr) return total_elements;
-    if(IsLeaf(node)) return node->_elements;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        std::vector<T> c_elems(node->GetElements(node->_children[i]));
-        std::size_t c_s = c_elems.size();
-        for(std::size_t c = 0; c < c_s; ++c) {
-            std::copy_if(c_elems.begin(), c_elems.end(), std::back_inserter(total_elements), IsInTotal(&total_elements));
-        }
-    }
-    return total_elements;
-}
-template<typename T>
-void Grid<T>::QueryNode(Grid<T>* node, const a2de::Shape& area, std::vector<T>& selected_elements) {
-
-    if(node == nullptr) return;
-
-    if(node->_bounds.Intersects(area) == false) return;
-
-    if(IsLeaf(node)) {
-        std::vector<T>::iterator b = node->_elements.begin();
-        std::vector<T>::iterator e = node->_elements.end();
-        for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
-            selected_elements.push_back(*_iter);
-        }
-        return;
-    }
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        QueryNode(node->_children[i], area, selected_elements);
-    }
-}
-
-template<typename T>
-std::vector<T> Grid<T>::Query(const a2de::Shape& area) {
-    std::vector<T> selected_elements;
-    QueryNode(this, area, selected_elements);
-    return selected_elements;
+void Grid<T>::GetCellRange(const a2de::Vector2D& min, const a2de::Vector2D& max, long& min_x, long& min_y, long& max_x, long& max_y) const {
+    double origin_x = _bounds.GetX() - _bounds.GetWidth();
+    double origin_y = _bounds.GetY() - _bounds.GetHeight();
+    min_x = GetCell(min.GetX(), origin_x);
+    min_y = GetCell(min.GetY(), origin_y);
+    max_x = GetCell(max.GetX(), origin_x);
+    max_y = GetCell(max.GetY(), origin_y);
 }
 
 template<typename T>
-unsigned long Grid<T>::GetMaxElementsPerNode() {
-    return MAX_ELEMENTS;
+bool Grid<T>::GetOwningCell(const a2de::Vector2D& first_min, const a2de::Vector2D& first_max, const a2de::Vector2D& second_min, const a2de::Vector2D& second_max, long& x, long& y) const {
+    if(first_max.GetX() < second_min.GetX() || second_max.GetX() < first_min.GetX()) return false;
+    if(first_max.GetY() < second_min.GetY() || second_max.GetY() < first_min.GetY()) return false;
+    double origin_x = _bounds.GetX() - _bounds.GetWidth();
+    double origin_y = _bounds.GetY() - _bounds.GetHeight();
+    x = GetCell(std::max(first_min.GetX(), second_min.GetX()), origin_x);
+    y = GetCell(std::max(first_min.GetY(), second_min.GetY()), origin_y);
+    return true;
 }
 
 template<typename T>
-void Grid<T>::SetMaxElementsPerNode(unsigned long max_elements) {
-    MAX_ELEMENTS = max_elements;
-}
+bool Grid<T>::Add(const T& elem) {
 
-template<typename T>
-const a2de::Color& Grid<T>::GetNodeColor() {
-    return _bounds.GetColor();
-}
+    if(ptr(elem) == nullptr) return false;
 
-template<typename T>
-void Grid<T>::SetNodeColor(const a2de::Color& color) {
-    _bounds.SetColor(color);
-}
+    a2de::Vector2D min;
+    a2de::Vector2D max;
+    GetExtents(bounds_of(elem), min, max);
 
-template<typename T>
-void Grid<T>::ResetNodeColor() {
-    _bounds.SetColor(DEFAULT_NODE_COLOR);
-}
+    long min_x = 0;
+    long min_y = 0;
+    long max_x = 0;
+    long max_y = 0;
+    GetCellRange(min, max, min_x, min_y, max_x, max_y);
 
-template<typename T>
-unsigned long Grid<T>::NumberOfElementsInTree() {
-    if(IsLeaf(this)) return _elements.size();
-    unsigned long num_elements = 0;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        num_elements += _children[i]->NumberOfElementsInTree();
+    for(long y = min_y; y <= max_y; ++y) {
+        for(long x = min_x; x <= max_x; ++x) {
+            std::vector<T>& bucket = _buckets[GetBucket(x, y)];
+            //Distinct cells may share a bucket; keep one entry per bucket.
+            if(std::find(bucket.begin(), bucket.end(), elem) != bucket.end()) continue;
+            bucket.push_back(elem);
+        }
     }
-    return num_elements;
+    ++_element_count;
+    return true;
 }
 
 template<typename T>
-unsigned long Grid<T>::Divisions() {
-    if(IsLeaf(this)) return 0;
-    unsigned long num_divisions = MAX_CHILDREN;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        num_divisions += _children[i]->Divisions();
-    }
-    return num_divisions;
+bool Grid<T>::Add(const T* elem) {
+    return Add(*elem);
 }
 
 template<typename T>
-unsigned long Grid<T>::Height() {
+bool Grid<T>::Remove(const T& elem) {
 
-    if(IsLeaf(this)) return 0;
-    unsigned long height = 1;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        height += _children[i]->Height();
+    if(ptr(elem) == nullptr) return false;
+
+    a2de::Vector2D min;
+    a2de::Vector2D max;
+    GetExtents(bounds_of(elem), min, max);
+
+    long min_x = 0;
+    long min_y = 0;
+    long max_x = 0;
+    long max_y = 0;
+    GetCellRange(min, max, min_x, min_y, max_x, max_y);
+
+    bool result = false;
+    for(long y = min_y; y <= max_y; ++y) {
+        for(long x = min_x; x <= max_x; ++x) {
+            std::vector<T>& bucket = _buckets[GetBucket(x, y)];
+            typename std::vector<T>::iterator _iter = std::find(bucket.begin(), bucket.end(), elem);
+            if(_iter == bucket.end()) continue;
+            //Order within a bucket does not matter.
+            *_iter = bucket.back();
+            bucket.pop_back();
+            result = true;
+        }
     }
-    return height;
+    if(result) --_element_count;
+    return result;
 }
 
 template<typename T>
-bool Grid<T>::IsLeaf(Grid<T>* node) {
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        if(node->_children[i] == nullptr) continue;
-        return false;
-    }
-    return true;
+bool Grid<T>::Remove(const T* elem) {
+    return Remove(*elem);
 }
 
 template<typename T>
-void Grid<T>::DrawTopToBottom(BITMAP* dest) {
-    _bounds.Draw(dest, _bounds.GetColor(), _bounds.IsFilled());
-    if(IsLeaf(this) == false) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            _children[i]->DrawTopToBottom(dest);
+bool Grid<T>::Update(const T& elem) {
+    //Remove under the extents elem was stored with, then store it under its new ones.
+    if(Remove(elem)) {
+        refit(elem);
+        if(Add(elem)) {
+            return true;
         }
     }
+    return false;
 }
 
 template<typename T>
-void Grid<T>::DrawBottomToTop(BITMAP* dest) {
-    if(IsLeaf(this) == false) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            _children[i]->DrawBottomToTop(dest);
-        }
-    }
-    _bounds.Draw(dest, _bounds.GetColor(), _bounds.IsFilled());
+bool Grid<T>::Update(const T* elem) {
+    return Update(*elem);
 }
 
 template<typename T>
-void Grid<T>::Draw(BITMAP* dest, bool top_to_bottom) {
-    top_to_bottom ? DrawTopToBottom(dest) : DrawBottomToTop(dest);
+void Grid<T>::Add(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Add(*_iter);
+    }
 }
 
 template<typename T>
-void Grid<T>::SubDivide() {
-    try {
-        //Define 
-        double half_width = _bounds.GetWidth();
-        double half_height = _bounds.GetHeight();
-        if(a2de::Math::ToScreenScale(half_width) <= 1.0 || a2de::Math::ToScreenScale(half_height) <= 1.0) return;
-
-        a2de::Vector2D dimensions(half_width, half_height);
-        a2de::Vector2D ul_pos(this->_bounds.GetPosition() - (a2de::Vector2D(half_width, half_height) / 2.0));
-        a2de::Vector2D ur_pos(ul_pos + a2de::Vector2D(half_width, 0.0));
-        a2de::Vector2D ll_pos(ul_pos + a2de::Vector2D(0.0, half_height));
-        a2de::Vector2D lr_pos(ul_pos + a2de::Vector2D(half_width, half_height));
-        a2de::Color color = _bounds.GetColor();
-        bool filled = _bounds.IsFilled();
-
-        a2de::Rectangle ul(ul_pos, dimensions, color, filled);
-        a2de::Rectangle ur(ur_pos, dimensions, color, filled);
-        a2de::Rectangle ll(ll_pos, dimensions, color, filled);
-        a2de::Rectangle lr(lr_pos, dimensions, color, filled);
-
-        _children[CHILD_UPPER_LEFT] = new Grid(this, ul);
-        _children[CHILD_UPPER_RIGHT] = new Grid(this, ur);
-        _children[CHILD_LOWER_LEFT] = new Grid(this, ll);
-        _children[CHILD_LOWER_RIGHT] = new Grid(this, lr);
-
-        //Give elements of mine to children, may or may not accept them.
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            std::vector<T>::iterator b = _elements.begin();
-            std::vector<T>::iterator e = _elements.end();
-            for(std::vector<T>::iterator _iter = b; _iter != e; /** DO NOTHING **/) {
-                if(_children[i]->Add(*_iter)) {
-                    _elements.erase(_iter++);
-                } else {
-                    ++_iter;
-                }
-            }
-        }
-
-    } catch(...) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            if(_children[i]) {
-                delete _children[i];
-                _children[i] = nullptr;
-            }
-        }
+void Grid<T>::Remove(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Remove(*_iter);
     }
 }
 
 template<typename T>
-void Grid<T>::UnSubDivide() {
-
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        Grid<T>* curNode = _children[i];
-        Grid<T>* curNodeParent = curNode->_parent;
-        for(std::vector<T>::iterator _iter = curNode->_elements.begin(); _iter != curNode->_elements.end(); ++_iter) {
-            curNodeParent->_elements.push_back(*_iter);
-        }
-        delete _children[i];
-        _children[i] = nullptr;
+void Grid<T>::Update(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Update(*_iter);
     }
 }
 
 template<typename T>
-bool Grid<T>::Add(const T& elem) {
-
-    if(ptr(elem)) {
-        bool intersects_result = _bounds.Intersects(*ptr(elem));
-        if(intersects_result == false) {
-            return false;
-        }
-    }
-
-    if(IsLeaf(this) == false) {
-        bool result = false;
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            result |= _children[i]->Add(elem);
-        }
-        return result;
-    }
-    _elements.push_back(elem);
-    if(_elements.size() > MAX_ELEMENTS) {
-        SubDivide();
+void Grid<T>::Clear() {
+    for(typename std::vector<std::vector<T> >::iterator _iter = _buckets.begin(); _iter != _buckets.end(); ++_iter) {
+        _iter->clear();
     }
-    return true;
+    _element_count = 0;
 }
 
 template<typename T>
-bool Grid<T>::Add(const T* elem) {
-    return Add(*elem);
+unsigned long Grid<T>::NumberOfElementsInGrid() {
+    return _element_count;
 }
 
 template<typename T>
-bool Grid<T>::Remove(const T& elem) {
-
-    if(ptr(elem) && _bounds.Intersects(*ptr(elem)) == false) return false;
-
-    if(IsLeaf(this)) {
-        return RemoveElement(elem);
-    }
-
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        _children[i]->Remove(elem);
-    }
-
-    bool all_children_are_leaves = true;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        if(IsLeaf(_children[i])) continue;
-        all_children_are_leaves = false;
-        break;
-    }
+std::vector<T> Grid<T>::Query(const a2de::Shape& area) {
+    std::vector<T> selected_elements;
 
-    if(all_children_are_leaves) {
-        unsigned long elements_in_children = 0;
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            elements_in_children += _children[i]->NumberOfElementsInTree();
-        }
-        if(elements_in_children < MAX_ELEMENTS) {
-            UnSubDivide();
+    a2de::Vector2D area_min;
+    a2de::Vector2D area_max;
+    GetExtents(area, area_min, area_max);
+
+    long min_x = 0;
+    long min_y = 0;
+    long max_x = 0;
+    long max_y = 0;
+    GetCellRange(area_min, area_max, min_x, min_y, max_x, max_y);
+
+    for(long y = min_y; y <= max_y; ++y) {
+        for(long x = min_x; x <= max_x; ++x) {
+            std::vector<T>& bucket = _buckets[GetBucket(x, y)];
+            for(typename std::vector<T>::iterator _iter = bucket.begin(); _iter != bucket.end(); ++_iter) {
+                a2de::Vector2D min;
+                a2de::Vector2D max;
+                GetExtents(bounds_of(*_iter), min, max);
+                long owner_x = 0;
+                long owner_y = 0;
+                if(GetOwningCell(min, max, area_min, area_max, owner_x, owner_y) == false) continue;
+                if(owner_x != x || owner_y != y) continue;
+                selected_elements.push_back(*_iter);
+            }
         }
     }
-    return true;
+    return selected_elements;
 }
 
 template<typename T>
-bool Grid<T>::Remove(const T* elem) {
-    return Remove(*elem);
+void Grid<T>::QueryPairs(std::vector<std::pair<T, T> >& pairs) {
+    std::size_t bucket_count = _buckets.size();
+    for(std::size_t b = 0; b < bucket_count; ++b) {
+        std::vector<T>& bucket = _buckets[b];
+        std::size_t s = bucket.size();
+        if(s < 2) continue;
+        for(std::size_t i = 0; i < s - 1; ++i) {
+            a2de::Vector2D first_min;
+            a2de::Vector2D first_max;
+            GetExtents(bounds_of(bucket[i]), first_min, first_max);
+            for(std::size_t j = i + 1; j < s; ++j) {
+                a2de::Vector2D second_min;
+                a2de::Vector2D second_max;
+                GetExtents(bounds_of(bucket[j]), second_min, second_max);
+                long owner_x = 0;
+                long owner_y = 0;
+                if(GetOwningCell(first_min, first_max, second_min, second_max, owner_x, owner_y) == false) continue;
+                if(GetBucket(owner_x, owner_y) != b) continue;
+                pairs.push_back(std::make_pair(bucket[i], bucket[j]));
+            }
+        }
+    }
 }
 
 template<typename T>
-bool Grid<T>::Update(const T& elem) {
-    if(Remove(elem)) {
-        if(Add(elem)) {
-            return true;
+std::vector<T> Grid<T>::GetAllElements() {
+    std::vector<T> total_elements;
+    total_elements.reserve(_element_count);
+    std::size_t bucket_count = _buckets.size();
+    for(std::size_t b = 0; b < bucket_count; ++b) {
+        std::vector<T>& bucket = _buckets[b];
+        for(typename std::vector<T>::iterator _iter = bucket.begin(); _iter != bucket.end(); ++_iter) {
+            a2de::Vector2D min;
+            a2de::Vector2D max;
+            GetExtents(bounds_of(*_iter), min, max);
+            long owner_x = 0;
+            long owner_y = 0;
+            GetOwningCell(min, max, min, max, owner_x, owner_y);
+            if(GetBucket(owner_x, owner_y) != b) continue;
+            total_elements.push_back(*_iter);
         }
     }
-    return false;
+    return total_elements;
 }
 
 template<typename T>
-bool Grid<T>::Update(const T* elem) {
-    return Update(*elem);
+const a2de::Color& Grid<T>::GetCellColor() {
+    return _bounds.GetColor();
 }
 
 template<typename T>
-void Grid<T>::Update(std::vector<T>& elem) {
-    std::vector<T>::iterator b = elem.begin();
-    std::vector<T>::iterator e = elem.end();
-    for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
-        Update(*_iter);
-    }
+void Grid<T>::SetCellColor(const a2de::Color& color) {
+    _bounds.SetColor(color);
 }
 
-
 template<typename T>
-bool Grid<T>::RemoveElement(const T& elem) {
-
-    std::vector<T>::iterator b = _elements.begin();
-    std::vector<T>::iterator e = _elements.end();
-    std::vector<T>::iterator _iter = b;
-    _iter = std::find(b, e, elem);
-    if(_iter != _elements.end()) {
-        _elements.erase(_iter);
-        return true;
-    }
-    return false;
+void Grid<T>::ResetCellColor() {
+    _bounds.SetColor(DEFAULT_CELL_COLOR);
 }
 
 template<typename T>
-void Grid<T>::Clear() {
-    Clear(this);
-}
+void Grid<T>::Draw(BITMAP* dest) {
+    if(dest == nullptr) return;
 
-template<typename T>
-void Grid<T>::Clear(Grid<T>* node) {
+    double left = _bounds.GetX() - _bounds.GetWidth();
+    double top = _bounds.GetY() - _bounds.GetHeight();
+    double right = _bounds.GetX() + _bounds.GetWidth();
+    double bottom = _bounds.GetY() + _bounds.GetHeight();
+    a2de::Color color = _bounds.GetColor();
 
-    if(IsLeaf(node)) {
-        node->_elements.clear();
-        return;
+    for(double x = left; x < right; x += _cell_size) {
+        a2de::Line(x, top, x, bottom).Draw(dest, color, false);
     }
-    
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        node->_children[i]->Clear();
+    for(double y = top; y < bottom; y += _cell_size) {
+        a2de::Line(left, y, right, y).Draw(dest, color, false);
     }
-    node->UnSubDivide();
-    node->_elements.clear();
-
+    _bounds.Draw(dest, color, false);
 }
 
 A2DE_END
 
-#endif
\ No newline at end of file
+#endif
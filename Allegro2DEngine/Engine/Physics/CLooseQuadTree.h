@@ -0,0 +1,680 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CLooseQuadTree.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the loose quad tree class
+ **************************************************************************************************/
+#ifndef A2DE_CLOOSEQUADTREE_H
+#define A2DE_CLOOSEQUADTREE_H
+
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <utility>
+
+#include "../a2de_vals.h"
+#include "../a2de_graphics.h"
+#include "../a2de_math.h"
+#include "IBroadPhase.h"
+
+A2DE_BEGIN
+
+class a2de::Shape;
+class a2de::Color;
+
+/**************************************************************************************************
+ * <summary>A loose quad tree. Each node's loose bounds are twice the size of its bounds, so an
+ * element can be stored exactly once: at the deepest node whose loose bounds contain its extents.
+ * Queries and pair tests never see an element twice and need no de-duplication.</summary>
+ * <remarks>Casey Ugone, 7/30/2014.</remarks>
+ **************************************************************************************************/
+template<typename T>
+class LooseQuadTree : public IBroadPhase<T> {
+
+public:
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="bounds">The bounds of the root. Elements outside of it are kept in the root.</param>
+     **************************************************************************************************/
+    LooseQuadTree(const a2de::Rectangle& bounds);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     **************************************************************************************************/
+    ~LooseQuadTree();
+
+    /**************************************************************************************************
+     * <summary>Adds an element to the tree.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elem">The const T& to add.</param>
+     * <returns>true if it succeeds, false if it fails or the element was already added.</returns>
+     **************************************************************************************************/
+    bool Add(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Adds an element to the tree.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elem">The const T* to add.</param>
+     * <returns>true if it succeeds, false if it fails or the element was already added.</returns>
+     **************************************************************************************************/
+    bool Add(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Removes the given element.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elem">The const T& to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Remove(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Removes the given element.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elem">The const T* to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Remove(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Updates the given element.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Update(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Updates the given element.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Update(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Adds a range of elements.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elems">[in,out] The std::vector<T>& to add.</param>
+     **************************************************************************************************/
+    void Add(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Removes the given elements.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elems">[in,out] The std::vector<T>& to remove.</param>
+     **************************************************************************************************/
+    void Remove(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Updates the given elements.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="elems">[in,out] The elems.</param>
+     **************************************************************************************************/
+    void Update(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Clears this object to its blank/initial state. Only the root is kept.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds of the root.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    const a2de::Rectangle& GetBounds() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds of the root.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    a2de::Rectangle& GetBounds();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of elements in tree.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <returns>The total number of elements in tree.</returns>
+     **************************************************************************************************/
+    unsigned long NumberOfElementsInTree();
+
+    /**************************************************************************************************
+     * <summary>Queries a given area. Each element is reported once.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="area">The area.</param>
+     * <returns>The elements whose extents overlap the extents of the area.</returns>
+     **************************************************************************************************/
+    std::vector<T> Query(const a2de::Shape& area);
+
+    /**************************************************************************************************
+     * <summary>Gets every pair of elements whose extents overlap. Each pair is reported once.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="pairs">[in,out] The candidate pairs are appended here.</param>
+     **************************************************************************************************/
+    void QueryPairs(std::vector<std::pair<T, T> >& pairs);
+
+    /**************************************************************************************************
+     * <summary>Gets all elements.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <returns>all elements.</returns>
+     **************************************************************************************************/
+    std::vector<T> GetAllElements();
+
+    /**************************************************************************************************
+     * <summary>Draws the bounds of every node.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     **************************************************************************************************/
+    void Draw(BITMAP* dest);
+
+    /**************************************************************************************************
+     * <summary>Gets the maximum elements per node before it is subdivided.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <returns>The maximum elements per node.</returns>
+     **************************************************************************************************/
+    static std::size_t GetMaxElementsPerNode();
+
+    /**************************************************************************************************
+     * <summary>Sets the maximum elements per node before it is subdivided.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="max_elements">The maximum elements.</param>
+     **************************************************************************************************/
+    static void SetMaxElementsPerNode(std::size_t max_elements);
+
+    /**************************************************************************************************
+     * <summary>Gets the maximum depth.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <returns>The maximum depth. The root is depth zero.</returns>
+     **************************************************************************************************/
+    static std::size_t GetMaxDepth();
+
+    /**************************************************************************************************
+     * <summary>Sets the maximum depth. Takes effect as nodes are subdivided.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="max_depth">The maximum depth. The root is depth zero.</param>
+     **************************************************************************************************/
+    static void SetMaxDepth(std::size_t max_depth);
+
+protected:
+private:
+
+    /// <summary> The index of no node </summary>
+    static const int NULL_NODE = -1;
+    /// <summary> The number of children of a subdivided node </summary>
+    static const int MAX_CHILDREN = 4;
+    /// <summary> The maximum elements per node </summary>
+    static std::size_t MAX_ELEMENTS;
+    /// <summary> The maximum depth </summary>
+    static std::size_t MAX_DEPTH;
+
+    /// <summary> Axis-aligned extents </summary>
+    struct Extents {
+        /// <summary> The left side </summary>
+        double min_x;
+        /// <summary> The top side </summary>
+        double min_y;
+        /// <summary> The right side </summary>
+        double max_x;
+        /// <summary> The bottom side </summary>
+        double max_y;
+    };
+
+    /// <summary> An element and the extents it was added with </summary>
+    struct Entry {
+        /// <summary> The element </summary>
+        T elem;
+        /// <summary> The extents </summary>
+        Extents extents;
+    };
+
+    /// <summary> A node in the pool </summary>
+    struct Node {
+        /// <summary> The center </summary>
+        double x;
+        /// <summary> The center </summary>
+        double y;
+        /// <summary> Half of the width of the tight bounds </summary>
+        double half_width;
+        /// <summary> Half of the height of the tight bounds </summary>
+        double half_height;
+        /// <summary> The depth, zero for the root </summary>
+        std::size_t depth;
+        /// <summary> The first of four contiguous children or NULL_NODE for a leaf </summary>
+        int first_child;
+        /// <summary> The elements stored at this node </summary>
+        std::vector<Entry> entries;
+    };
+
+    /**************************************************************************************************
+     * <summary>Gets the extents of a point.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="point">The point.</param>
+     * <returns>The extents.</returns>
+     **************************************************************************************************/
+    static Extents GetExtents(const a2de::Vector2D& point);
+
+    /**************************************************************************************************
+     * <summary>Gets the extents of a shape.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="shape">The shape.</param>
+     * <returns>The extents.</returns>
+     **************************************************************************************************/
+    static Extents GetExtents(const a2de::Shape& shape);
+
+    /**************************************************************************************************
+     * <summary>Query if two extents overlap.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="first"> The first extents.</param>
+     * <param name="second">The second extents.</param>
+     * <returns>true if they overlap, false if they do not.</returns>
+     **************************************************************************************************/
+    static bool Overlaps(const Extents& first, const Extents& second);
+
+    /**************************************************************************************************
+     * <summary>Gets the loose bounds of a node, twice the size of its bounds about the same
+     * center.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="node">The node.</param>
+     * <returns>The loose bounds.</returns>
+     **************************************************************************************************/
+    static Extents GetLooseExtents(const Node& node);
+
+    /**************************************************************************************************
+     * <summary>Query if the loose bounds of a node contain the extents.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="node">   The node.</param>
+     * <param name="extents">The extents.</param>
+     * <returns>true if they are contained, false if not.</returns>
+     **************************************************************************************************/
+    static bool Fits(const Node& node, const Extents& extents);
+
+    /**************************************************************************************************
+     * <summary>Gets the child of a subdivided node whose bounds hold the center of the extents.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="index">  The index of the node.</param>
+     * <param name="extents">The extents.</param>
+     * <returns>The index of the child.</returns>
+     **************************************************************************************************/
+    int GetChild(int index, const Extents& extents) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the deepest existing node an element with the extents belongs in.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="extents">The extents.</param>
+     * <returns>The index of the node.</returns>
+     **************************************************************************************************/
+    int FindNode(const Extents& extents) const;
+
+    /**************************************************************************************************
+     * <summary>Stores an entry at a node, subdividing it if it holds too many.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="index">The index of the node.</param>
+     * <param name="entry">The entry.</param>
+     **************************************************************************************************/
+    void Insert(int index, const Entry& entry);
+
+    /**************************************************************************************************
+     * <summary>Creates the children of a leaf and pushes down every entry that fits in one.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="index">The index of the node.</param>
+     **************************************************************************************************/
+    void SubDivide(int index);
+
+    /// <summary> The node pool. The root is always the first node. </summary>
+    std::vector<Node> _nodes;
+    /// <summary> The node each element is stored at </summary>
+    std::map<T, int> _lookup;
+    /// <summary> The traversal stack, kept to avoid allocating per query </summary>
+    std::vector<int> _stack;
+    /// <summary> The bounds of the root </summary>
+    a2de::Rectangle _bounds;
+
+    //DO NOT COPY!
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    LooseQuadTree(const LooseQuadTree<T>& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 7/30/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    LooseQuadTree<T>& operator=(const LooseQuadTree<T>& rhs);
+
+};
+
+template<typename T>
+std::size_t LooseQuadTree<T>::MAX_ELEMENTS = 8;
+
+template<typename T>
+std::size_t LooseQuadTree<T>::MAX_DEPTH = 8;
+
+template<typename T>
+LooseQuadTree<T>::LooseQuadTree(const a2de::Rectangle& bounds) : _nodes(), _lookup(), _stack(), _bounds(bounds) {
+    _bounds.SetFill(false);
+    Clear();
+}
+
+template<typename T>
+LooseQuadTree<T>::~LooseQuadTree() {
+    _nodes.clear();
+    _lookup.clear();
+}
+
+template<typename T>
+std::size_t LooseQuadTree<T>::GetMaxElementsPerNode() {
+    return MAX_ELEMENTS;
+}
+
+template<typename T>
+void LooseQuadTree<T>::SetMaxElementsPerNode(std::size_t max_elements) {
+    if(max_elements == 0) return;
+    MAX_ELEMENTS = max_elements;
+}
+
+template<typename T>
+std::size_t LooseQuadTree<T>::GetMaxDepth() {
+    return MAX_DEPTH;
+}
+
+template<typename T>
+void LooseQuadTree<T>::SetMaxDepth(std::size_t max_depth) {
+    MAX_DEPTH = max_depth;
+}
+
+template<typename T>
+const a2de::Rectangle& LooseQuadTree<T>::GetBounds() const {
+    return _bounds;
+}
+
+template<typename T>
+a2de::Rectangle& LooseQuadTree<T>::GetBounds() {
+    return const_cast<a2de::Rectangle&>(static_cast<const LooseQuadTree<T>&>(*this).GetBounds());
+}
+
+template<typename T>
+typename LooseQuadTree<T>::Extents LooseQuadTree<T>::GetExtents(const a2de::Vector2D& point) {
+    Extents result = { point.GetX(), point.GetY(), point.GetX(), point.GetY() };
+    return result;
+}
+
+template<typename T>
+typename LooseQuadTree<T>::Extents LooseQuadTree<T>::GetExtents(const a2de::Shape& shape) {
+    //Shape dimensions are half-extents about the position.
+    Extents result = { shape.GetX() - shape.GetWidth(), shape.GetY() - shape.GetHeight(), shape.GetX() + shape.GetWidth(), shape.GetY() + shape.GetHeight() };
+    return result;
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Overlaps(const Extents& first, const Extents& second) {
+    if(first.max_x < second.min_x || second.max_x < first.min_x) return false;
+    if(first.max_y < second.min_y || second.max_y < first.min_y) return false;
+    return true;
+}
+
+template<typename T>
+typename LooseQuadTree<T>::Extents LooseQuadTree<T>::GetLooseExtents(const Node& node) {
+    Extents result = { node.x - 2.0 * node.half_width, node.y - 2.0 * node.half_height, node.x + 2.0 * node.half_width, node.y + 2.0 * node.half_height };
+    return result;
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Fits(const Node& node, const Extents& extents) {
+    Extents loose = GetLooseExtents(node);
+    return loose.min_x <= extents.min_x && extents.max_x <= loose.max_x && loose.min_y <= extents.min_y && extents.max_y <= loose.max_y;
+}
+
+template<typename T>
+int LooseQuadTree<T>::GetChild(int index, const Extents& extents) const {
+    const Node& node = _nodes[index];
+    double center_x = (extents.min_x + extents.max_x) / 2.0;
+    double center_y = (extents.min_y + extents.max_y) / 2.0;
+    int quadrant = 0;
+    if(node.x <= center_x) quadrant |= 1;
+    if(node.y <= center_y) quadrant |= 2;
+    return node.first_child + quadrant;
+}
+
+template<typename T>
+int LooseQuadTree<T>::FindNode(const Extents& extents) const {
+    //Elements the root cannot hold stay at the root.
+    int index = 0;
+    while(_nodes[index].first_child != NULL_NODE) {
+        int child = GetChild(index, extents);
+        if(Fits(_nodes[child], extents) == false) break;
+        index = child;
+    }
+    return index;
+}
+
+template<typename T>
+void LooseQuadTree<T>::Insert(int index, const Entry& entry) {
+    _nodes[index].entries.push_back(entry);
+    _lookup[entry.elem] = index;
+    if(_nodes[index].first_child != NULL_NODE) return;
+    if(_nodes[index].entries.size() <= MAX_ELEMENTS) return;
+    if(_nodes[index].depth >= MAX_DEPTH) return;
+    SubDivide(index);
+}
+
+template<typename T>
+void LooseQuadTree<T>::SubDivide(int index) {
+
+    int first_child = static_cast<int>(_nodes.size());
+    _nodes.resize(_nodes.size() + MAX_CHILDREN);
+
+    //Resizing may move the parent; index into the pool from here on.
+    _nodes[index].first_child = first_child;
+    double half_width = _nodes[index].half_width / 2.0;
+    double half_height = _nodes[index].half_height / 2.0;
+    for(int i = 0; i < MAX_CHILDREN; ++i) {
+        Node& child = _nodes[first_child + i];
+        child.x = _nodes[index].x + ((i & 1) ? half_width : -half_width);
+        child.y = _nodes[index].y + ((i & 2) ? half_height : -half_height);
+        child.half_width = half_width;
+        child.half_height = half_height;
+        child.depth = _nodes[index].depth + 1;
+        child.first_child = NULL_NODE;
+        child.entries.clear();
+    }
+
+    std::vector<Entry> entries;
+    entries.swap(_nodes[index].entries);
+    for(typename std::vector<Entry>::iterator _iter = entries.begin(); _iter != entries.end(); ++_iter) {
+        int child = GetChild(index, _iter->extents);
+        if(Fits(_nodes[child], _iter->extents)) {
+            Insert(child, *_iter);
+        } else {
+            _nodes[index].entries.push_back(*_iter);
+        }
+    }
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Add(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    if(_lookup.find(elem) != _lookup.end()) return false;
+
+    Entry entry;
+    entry.elem = elem;
+    entry.extents = GetExtents(bounds_of(elem));
+    Insert(FindNode(entry.extents), entry);
+    return true;
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Add(const T* elem) {
+    return Add(*elem);
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Remove(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    typename std::map<T, int>::iterator _lookup_iter = _lookup.find(elem);
+    if(_lookup_iter == _lookup.end()) return false;
+
+    std::vector<Entry>& entries = _nodes[_lookup_iter->second].entries;
+    _lookup.erase(_lookup_iter);
+    for(typename std::vector<Entry>::iterator _iter = entries.begin(); _iter != entries.end(); ++_iter) {
+        if(_iter->elem != elem) continue;
+        //Order within a node does not matter.
+        *_iter = entries.back();
+        entries.pop_back();
+        return true;
+    }
+    return false;
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Remove(const T* elem) {
+    return Remove(*elem);
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Update(const T& elem) {
+    if(Remove(elem)) {
+        refit(elem);
+        if(Add(elem)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<typename T>
+bool LooseQuadTree<T>::Update(const T* elem) {
+    return Update(*elem);
+}
+
+template<typename T>
+void LooseQuadTree<T>::Add(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Add(*_iter);
+    }
+}
+
+template<typename T>
+void LooseQuadTree<T>::Remove(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Remove(*_iter);
+    }
+}
+
+template<typename T>
+void LooseQuadTree<T>::Update(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Update(*_iter);
+    }
+}
+
+template<typename T>
+void LooseQuadTree<T>::Clear() {
+    _nodes.resize(1);
+    Node& root = _nodes[0];
+    root.x = _bounds.GetX();
+    root.y = _bounds.GetY();
+    root.half_width = _bounds.GetWidth();
+    root.half_height = _bounds.GetHeight();
+    root.depth = 0;
+    root.first_child = NULL_NODE;
+    root.entries.clear();
+    _lookup.clear();
+}
+
+template<typename T>
+unsigned long LooseQuadTree<T>::NumberOfElementsInTree() {
+    return _lookup.size();
+}
+
+template<typename T>
+std::vector<T> LooseQuadTree<T>::Query(const a2de::Shape& area) {
+    std::vector<T> selected_elements;
+
+    Extents area_extents = GetExtents(area);
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        int index = _stack.back();
+        _stack.pop_back();
+        const Node& node = _nodes[index];
+        //The root also holds whatever lies outside of it.
+        if(index != 0 && Overlaps(GetLooseExtents(node), area_extents) == false) continue;
+        for(typename std::vector<Entry>::const_iterator _iter = node.entries.begin(); _iter != node.entries.end(); ++_iter) {
+            if(Overlaps(_iter->extents, area_extents) == false) continue;
+            selected_elements.push_back(_iter->elem);
+        }
+        if(node.first_child == NULL_NODE) continue;
+        for(int i = 0; i < MAX_CHILDREN; ++i) {
+            _stack.push_back(node.first_child + i);
+        }
+    }
+    return selected_elements;
+}
+
+template<typename T>
+void LooseQuadTree<T>::QueryPairs(std::vector<std::pair<T, T> >& pairs) {
+    //Loose bounds of neighboring nodes overlap, so partners are found by querying with each entry
+    //rather than by walking down from it. Only the partner that sorts after an entry is reported.
+    std::size_t node_count = _nodes.size();
+    for(std::size_t n = 0; n < node_count; ++n) {
+        const std::vector<Entry>& entries = _nodes[n].entries;
+        for(typename std::vector<Entry>::const_iterator _entry = entries.begin(); _entry != entries.end(); ++_entry) {
+            _stack.clear();
+            _stack.push_back(0);
+            while(_stack.empty() == false) {
+                int index = _stack.back();
+                _stack.pop_back();
+                const Node& node = _nodes[index];
+                if(index != 0 && Overlaps(GetLooseExtents(node), _entry->extents) == false) continue;
+                for(typename std::vector<Entry>::const_iterator _iter = node.entries.begin(); _iter != node.entries.end(); ++_iter) {
+                    if((_entry->elem < _iter->elem) == false) continue;
+                    if(Overlaps(_iter->extents, _entry->extents) == false) continue;
+                    pairs.push_back(std::make_pair(_entry->elem, _iter->elem));
+                }
+                if(node.first_child == NULL_NODE) continue;
+                for(int i = 0; i < MAX_CHILDREN; ++i) {
+                    _stack.push_back(node.first_child + i);
+                }
+            }
+        }
+    }
+}
+
+template<typename T>
+std::vector<T> LooseQuadTree<T>::GetAllElements() {
+    std::vector<T> total_elements;
+    total_elements.reserve(_lookup.size());
+    for(typename std::vector<Node>::iterator _iter = _nodes.begin(); _iter != _nodes.end(); ++_iter) {
+        for(typename std::vector<Entry>::iterator _entry = _iter->entries.begin(); _entry != _iter->entries.end(); ++_entry) {
+            total_elements.push_back(_entry->elem);
+        }
+    }
+    return total_elements;
+}
+
+template<typename T>
+void LooseQuadTree<T>::Draw(BITMAP* dest) {
+    if(dest == nullptr) return;
+
+    a2de::Color color = _bounds.GetColor();
+    for(typename std::vector<Node>::iterator _iter = _nodes.begin(); _iter != _nodes.end(); ++_iter) {
+        a2de::Rectangle bounds(_iter->x, _iter->y, _iter->half_width, _iter->half_height, color, false);
+        bounds.Draw(dest, color, false);
+    }
+}
+
+A2DE_END
+
+#endif
@@ -17,7 +17,6 @@ A2DE_BEGIN
 void PhysicsArea::OnEnter(Object* entered_object) {
     if(_gravity) _gravity->RegisterBody(entered_object);
     if(_drag) _drag->RegisterBody(entered_object);
-    Trigger<Object*>::RegisterObject(entered_object);
 }
 
 void PhysicsArea::OnTick(Object* object) {
@@ -27,7 +26,6 @@ void PhysicsArea::OnTick(Object* object) {
 void PhysicsArea::OnExit(Object* exited_object) {
     if(_gravity) _gravity->UnregisterBody(exited_object);
     if(_drag) _drag->UnregisterBody(exited_object);
-    Trigger<Object*>::UnregisterObject(exited_object);
 }
 
 void PhysicsArea::Update(double deltaTime) {
@@ -12,21 +12,35 @@
 #include <list>
 #include <algorithm>
 #include <iterator>
+#include <utility>
 
 #include "../a2de_vals.h"
 #include "../a2de_graphics.h"
 #include "../a2de_math.h"
+#include "IBroadPhase.h"
 
 A2DE_BEGIN
 
 class a2de::Shape;
 class a2de::Color;
 
+/**************************************************************************************************
+ * <summary>A quad tree whose nodes live in a pool. The four children of a node are allocated as one
+ * contiguous block and every node, element and element-to-leaf link is addressed by a 32-bit index.
+ * Each element is stored once in a shared array; leaves hold linked lists of links into it.</summary>
+ * <remarks>Casey Ugone, 5/20/2013.</remarks>
+ **************************************************************************************************/
 template<typename T>
-class QuadTree {
+class QuadTree : public IBroadPhase<T> {
 
 public:
 
+    /// <summary> The index of a node, element or link </summary>
+    typedef unsigned int NodeIndex;
+
+    /// <summary> The index of no node, element or link </summary>
+    static const NodeIndex NULL_INDEX = 0xFFFFFFFFu;
+
     /**************************************************************************************************
      * <summary>Constructor.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -110,18 +124,12 @@ public:
     void Update(std::vector<T>& elems);
 
     /**************************************************************************************************
-     * <summary>Clears this object to its blank/initial state.</summary>
+     * <summary>Clears this object to its blank/initial state. The pools are reset, not freed, so this
+     * does not touch the nodes.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
      **************************************************************************************************/
     void Clear();
 
-    /**************************************************************************************************
-     * <summary>Clears the node to its blank/initial state.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
-     **************************************************************************************************/
-    void Clear(QuadTree<T>* node);
-
     /**************************************************************************************************
      * <summary>Gets the node bounds.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -136,24 +144,32 @@ public:
      **************************************************************************************************/
     a2de::Rectangle& GetBounds();
 
+    /**************************************************************************************************
+     * <summary>Gets the bounds of a node.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="node">The index of the node.</param>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    a2de::Rectangle GetNodeBounds(NodeIndex node) const;
+
     /**************************************************************************************************
      * <summary>Gets the tree height.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>.</returns>
+     * <returns>The depth of the deepest leaf. Zero if the root is a leaf.</returns>
      **************************************************************************************************/
     unsigned long Height();
 
     /**************************************************************************************************
      * <summary>Gets the tree divisions.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>.</returns>
+     * <returns>The number of nodes below the root.</returns>
      **************************************************************************************************/
     unsigned long Divisions();
 
     /**************************************************************************************************
      * <summary>Gets the number of elements in tree.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>The total number of elements in tree.</returns>
+     * <returns>The total number of elements in tree. Each element is counted once.</returns>
      **************************************************************************************************/
     unsigned long NumberOfElementsInTree();
 
@@ -161,33 +177,42 @@ public:
      * <summary>Queries a given area.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
      * <param name="area">The area.</param>
-     * <returns>.</returns>
+     * <returns>The elements of every leaf the area overlaps. Each element is reported once.</returns>
      **************************************************************************************************/
     std::vector<T> Query(const a2de::Shape& area);
 
+    /**************************************************************************************************
+     * <summary>Gets every pair of elements that share a leaf. Elements stored in more than one leaf
+     * may be reported more than once.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="pairs">[in,out] The candidate pairs are appended here.</param>
+     **************************************************************************************************/
+    void QueryPairs(std::vector<std::pair<T, T> >& pairs);
+
     /**************************************************************************************************
      * <summary>Gets the nodes by element.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
      * <param name="elem">[in,out] The element.</param>
-     * <returns>null if it fails, else the nodes by element.</returns>
+     * <returns>The indices of the leaves holding the element.</returns>
      **************************************************************************************************/
-    std::vector<QuadTree<T>*> GetNodesByElement(T& elem);
+    std::vector<NodeIndex> GetNodesByElement(T& elem);
 
     /**************************************************************************************************
      * <summary>Gets the nodes by location.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
      * <param name="loc">[in,out] The location.</param>
-     * <returns>null if it fails, else the nodes by location.</returns>
+     * <returns>The indices of the leaves containing the location.</returns>
      **************************************************************************************************/
-    std::vector<QuadTree<T>*> GetNodesByLocation(a2de::Vector2D& loc);
+    std::vector<NodeIndex> GetNodesByLocation(a2de::Vector2D& loc);
 
     /**************************************************************************************************
      * <summary>Gets the sibling nodes.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
-     * <returns>null if it fails, else the siblings.</returns>
+     * <param name="node">The index of the node.</param>
+     * <returns>The indices of the node's block of children, or the node itself if it is the
+     * root.</returns>
      **************************************************************************************************/
-    std::vector<QuadTree<T>*> GetSiblings(QuadTree<T>* node);
+    std::vector<NodeIndex> GetSiblings(NodeIndex node);
 
     /**************************************************************************************************
      * <summary>Gets all elements.</summary>
@@ -196,6 +221,145 @@ public:
      **************************************************************************************************/
     std::vector<T> GetAllElements();
 
+    /**************************************************************************************************
+     * <summary>Queries the segment from start to end. Each element is reported once.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="start">The start of the ray.</param>
+     * <param name="end">  The end of the ray.</param>
+     * <returns>The elements whose extents the segment crosses.</returns>
+     **************************************************************************************************/
+    std::vector<T> QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end);
+
+    /**************************************************************************************************
+     * <summary>Queries a given area without allocating.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="area">The area.</param>
+     * <param name="out"> The output iterator the elements are written to.</param>
+     * <returns>The output iterator one past the last element written.</returns>
+     **************************************************************************************************/
+    template<typename OutputIterator>
+    OutputIterator Query(const a2de::Shape& area, OutputIterator out);
+
+    /**************************************************************************************************
+     * <summary>Queries the segment from start to end without allocating.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="start">The start of the ray.</param>
+     * <param name="end">  The end of the ray.</param>
+     * <param name="out">  The output iterator the elements are written to.</param>
+     * <returns>The output iterator one past the last element written.</returns>
+     **************************************************************************************************/
+    template<typename OutputIterator>
+    OutputIterator QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end, OutputIterator out);
+
+    /**************************************************************************************************
+     * <summary>Gets the k elements nearest a point, nearest first.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="point">The point.</param>
+     * <param name="k">    The number of elements to find.</param>
+     * <param name="out">  The output iterator the elements are written to.</param>
+     * <returns>The output iterator one past the last element written.</returns>
+     **************************************************************************************************/
+    template<typename OutputIterator>
+    OutputIterator QueryNearest(const a2de::Vector2D& point, std::size_t k, OutputIterator out);
+
+    /**************************************************************************************************
+     * <summary>Gets the nodes by element without allocating.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <param name="out"> The output iterator the node indices are written to.</param>
+     * <returns>The output iterator one past the last index written.</returns>
+     **************************************************************************************************/
+    template<typename OutputIterator>
+    OutputIterator GetNodesByElement(const T& elem, OutputIterator out);
+
+    /**************************************************************************************************
+     * <summary>Gets the nodes by location without allocating.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="loc">The location.</param>
+     * <param name="out">The output iterator the node indices are written to.</param>
+     * <returns>The output iterator one past the last index written.</returns>
+     **************************************************************************************************/
+    template<typename OutputIterator>
+    OutputIterator GetNodesByLocation(const a2de::Vector2D& loc, OutputIterator out);
+
+    /**************************************************************************************************
+     * <summary>Gets all elements without allocating.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="out">The output iterator the elements are written to.</param>
+     * <returns>The output iterator one past the last element written.</returns>
+     **************************************************************************************************/
+    template<typename OutputIterator>
+    OutputIterator GetAllElements(OutputIterator out);
+
+    /**************************************************************************************************
+     * <summary>Calls visitor with each element in the leaves the area overlaps. Each element is visited
+     * once. The visitor returns false to stop early and must not modify or query this tree.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="area">   The area.</param>
+     * <param name="visitor">A callable taking const T& and returning bool.</param>
+     * <returns>false if the visitor stopped the query, true otherwise.</returns>
+     **************************************************************************************************/
+    template<typename Visitor>
+    bool Visit(const a2de::Shape& area, Visitor visitor);
+
+    /**************************************************************************************************
+     * <summary>Calls visitor with each element whose extents the segment from start to end crosses.
+     * Leaves are walked from start to end, so elements nearer the start tend to come first; elements
+     * within one leaf are in no particular order. The visitor returns false to stop early and must
+     * not modify or query this tree.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="start">  The start of the ray.</param>
+     * <param name="end">    The end of the ray.</param>
+     * <param name="visitor">A callable taking const T& and returning bool.</param>
+     * <returns>false if the visitor stopped the query, true otherwise.</returns>
+     **************************************************************************************************/
+    template<typename Visitor>
+    bool VisitRay(const a2de::Vector2D& start, const a2de::Vector2D& end, Visitor visitor);
+
+    /**************************************************************************************************
+     * <summary>Calls visitor with every element in order of the distance from point to its extents,
+     * nearest first. The visitor returns false to stop early and must not modify or query this
+     * tree.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="point">  The point.</param>
+     * <param name="visitor">A callable taking const T& and returning bool.</param>
+     * <returns>false if the visitor stopped the query, true otherwise.</returns>
+     **************************************************************************************************/
+    template<typename Visitor>
+    bool VisitNearest(const a2de::Vector2D& point, Visitor visitor);
+
+    /**************************************************************************************************
+     * <summary>Calls visitor with each leaf holding the element. The visitor returns false to stop
+     * early and must not modify or query this tree.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="elem">   The element.</param>
+     * <param name="visitor">A callable taking NodeIndex and returning bool.</param>
+     * <returns>false if the visitor stopped the query, true otherwise.</returns>
+     **************************************************************************************************/
+    template<typename Visitor>
+    bool VisitNodesByElement(const T& elem, Visitor visitor);
+
+    /**************************************************************************************************
+     * <summary>Calls visitor with each leaf containing the location. The visitor returns false to stop
+     * early and must not modify or query this tree.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="loc">    The location.</param>
+     * <param name="visitor">A callable taking NodeIndex and returning bool.</param>
+     * <returns>false if the visitor stopped the query, true otherwise.</returns>
+     **************************************************************************************************/
+    template<typename Visitor>
+    bool VisitNodesByLocation(const a2de::Vector2D& loc, Visitor visitor);
+
+    /**************************************************************************************************
+     * <summary>Calls visitor with every element. The visitor returns false to stop early and must not
+     * modify this tree.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="visitor">A callable taking const T& and returning bool.</param>
+     * <returns>false if the visitor stopped the query, true otherwise.</returns>
+     **************************************************************************************************/
+    template<typename Visitor>
+    bool VisitAllElements(Visitor visitor);
+
     /**************************************************************************************************
      * <summary>Draws the tree.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -204,6 +368,13 @@ public:
      **************************************************************************************************/
     void Draw(BITMAP* dest, bool top_to_bottom);
 
+    /**************************************************************************************************
+     * <summary>Draws the tree from the top down.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     **************************************************************************************************/
+    void Draw(BITMAP* dest);
+
     /**************************************************************************************************
      * <summary>Gets the maximum elements per node.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -231,7 +402,7 @@ public:
      * <returns>The node color.</returns>
      **************************************************************************************************/
     const a2de::Color& GetNodeColor();
-    
+
     void ResetNodeColor();
 
 protected:
@@ -256,91 +427,220 @@ private:
     /// <summary> The default node color </summary>
     a2de::Color DEFAULT_NODE_COLOR;
 
+    /// <summary> Axis-aligned extents </summary>
+    struct Extents {
+        /// <summary> The left side </summary>
+        double min_x;
+        /// <summary> The top side </summary>
+        double min_y;
+        /// <summary> The right side </summary>
+        double max_x;
+        /// <summary> The bottom side </summary>
+        double max_y;
+    };
+
+    /// <summary> A node in the pool </summary>
+    struct Node {
+        /// <summary> The center </summary>
+        double x;
+        /// <summary> The center </summary>
+        double y;
+        /// <summary> Half of the width </summary>
+        double half_width;
+        /// <summary> Half of the height </summary>
+        double half_height;
+        /// <summary> The parent or NULL_INDEX for the root </summary>
+        NodeIndex parent;
+        /// <summary> The first of four contiguous children or NULL_INDEX for a leaf </summary>
+        NodeIndex first_child;
+        /// <summary> The first link of a leaf or NULL_INDEX if empty </summary>
+        NodeIndex first_link;
+        /// <summary> The number of links of a leaf </summary>
+        unsigned long element_count;
+    };
+
+    /// <summary> A link from a leaf to one of its elements </summary>
+    struct Link {
+        /// <summary> The index of the element </summary>
+        NodeIndex element;
+        /// <summary> The next link of the leaf or the next free link </summary>
+        NodeIndex next;
+    };
+
+    /// <summary> A node or element waiting to be visited by VisitNearest </summary>
+    struct Candidate {
+        /// <summary> The squared distance from the query point </summary>
+        double distance;
+        /// <summary> The index of the node or element </summary>
+        NodeIndex index;
+        /// <summary> true if index is an element, false if it is a node </summary>
+        bool is_element;
+        /// <summary> Reversed so the standard heap functions keep the nearest candidate on top </summary>
+        bool operator<(const Candidate& rhs) const { return rhs.distance < distance; }
+    };
+
+    /// <summary> A visitor that writes what it visits to an output iterator and stops after a count </summary>
+    template<typename OutputIterator>
+    struct OutputVisitor {
+        OutputVisitor(OutputIterator& out, std::size_t count) : out(&out), remaining(count) { /* DO NOTHING */ }
+        template<typename U>
+        bool operator()(const U& value) {
+            *(*out)++ = value;
+            return --remaining != 0;
+        }
+        /// <summary> The caller's iterator, shared so copies of the visitor advance it too </summary>
+        OutputIterator* out;
+        /// <summary> The number of values still wanted </summary>
+        std::size_t remaining;
+    };
+
     /**************************************************************************************************
-     * <summary>Constructor.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="parent_node">[in,out] If non-null, the parent node.</param>
-     * <param name="bounds">     The bounds.</param>
+     * <summary>Gets the extents of a node.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="node">The node.</param>
+     * <returns>The extents.</returns>
      **************************************************************************************************/
-    QuadTree(QuadTree<T>* parent_node, const a2de::Rectangle& bounds);
+    static Extents GetExtents(const Node& node);
 
     /**************************************************************************************************
-     * <summary>Constructor.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="parent_node">[in,out] If non-null, the parent node.</param>
-     * <param name="bounds">     The bounds.</param>
-     * <param name="elems">      [in,out] The elems.</param>
+     * <summary>Gets the extents of a point.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="point">The point.</param>
+     * <returns>The extents.</returns>
      **************************************************************************************************/
-    QuadTree(QuadTree<T>* parent_node, const a2de::Rectangle& bounds, std::vector<T>& elems);
+    static Extents GetExtents(const a2de::Vector2D& point);
 
     /**************************************************************************************************
-     * <summary>Subdivide.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Gets the extents of a shape.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="shape">The shape.</param>
+     * <returns>The extents.</returns>
      **************************************************************************************************/
-    void SubDivide();
+    static Extents GetExtents(const a2de::Shape& shape);
 
     /**************************************************************************************************
-     * <summary>Unsubdivide.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Query if a node's bounds overlap the extents.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="node">   The node.</param>
+     * <param name="extents">The extents.</param>
+     * <returns>true if they overlap, false if they do not.</returns>
+     **************************************************************************************************/
+    static bool Overlaps(const Node& node, const Extents& extents);
+
+    /**************************************************************************************************
+     * <summary>Query if the segment from start to end crosses the extents.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="extents">The extents.</param>
+     * <param name="start">  The start of the segment.</param>
+     * <param name="end">    The end of the segment.</param>
+     * <param name="t_enter">[out] The fraction of the segment at which it enters the extents.</param>
+     * <returns>true if it crosses, false if it does not.</returns>
+     **************************************************************************************************/
+    static bool Crosses(const Extents& extents, const a2de::Vector2D& start, const a2de::Vector2D& end, double& t_enter);
+
+    /**************************************************************************************************
+     * <summary>Gets the squared distance from a point to the extents.</summary>
+     * <remarks>Casey Ugone, 8/3/2014.</remarks>
+     * <param name="extents">The extents.</param>
+     * <param name="point">  The point.</param>
+     * <returns>The squared distance, zero if the point is inside.</returns>
      **************************************************************************************************/
-    void UnSubDivide();
+    static double DistanceSquared(const Extents& extents, const a2de::Vector2D& point);
 
     /**************************************************************************************************
      * <summary>Query if 'node' is leaf.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
+     * <param name="node">The index of the node.</param>
      * <returns>true if leaf, false if not.</returns>
      **************************************************************************************************/
-    bool IsLeaf(QuadTree<T>* node);
+    bool IsLeaf(NodeIndex node) const;
 
     /**************************************************************************************************
-     * <summary>Queries a node.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">             [in,out] If non-null, the node.</param>
-     * <param name="area">             The area.</param>
-     * <param name="selected_elements">[in,out] The selected elements.</param>
+     * <summary>Takes a block of four children from the pool, growing it if needed.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <returns>The index of the first child.</returns>
      **************************************************************************************************/
-    void QueryNode(QuadTree<T>* node, const a2de::Shape& area, std::vector<T>& selected_elements);
+    NodeIndex AllocateBlock();
 
     /**************************************************************************************************
-     * <summary>Removes the element described by elem.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="elem">The element.</param>
-     * <returns>true if it succeeds, false if it fails.</returns>
+     * <summary>Links an element to a leaf.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="node">   The index of the leaf.</param>
+     * <param name="element">The index of the element.</param>
      **************************************************************************************************/
-    bool RemoveElement(const T& elem);
+    void LinkElement(NodeIndex node, NodeIndex element);
 
     /**************************************************************************************************
-     * <summary>Gets the elements.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="node">[in,out] If non-null, the node.</param>
-     * <returns>The elements.</returns>
+     * <summary>Returns a link to the pool and frees its element once no leaf links to it.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="link">The index of the link.</param>
      **************************************************************************************************/
-    std::vector<T> GetElements(QuadTree<T>* node);
+    void ReleaseLink(NodeIndex link);
 
     /**************************************************************************************************
-     * <summary>Draw top to bottom.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     * <summary>Starts a query that reports each element once.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     **************************************************************************************************/
+    void NextStamp();
+
+    /**************************************************************************************************
+     * <summary>Links an element to every leaf below a node that its extents overlap.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="node">   The index of the node.</param>
+     * <param name="element">The index of the element.</param>
+     * <param name="extents">The extents of the element.</param>
+     * <returns>true if any leaf accepted it, false if none did.</returns>
+     **************************************************************************************************/
+    bool InsertElement(NodeIndex node, NodeIndex element, const Extents& extents);
+
+    /**************************************************************************************************
+     * <summary>Unlinks an element from every leaf below a node that its extents overlap.</summary>
+     * <remarks>Casey Ugone, 8/1/2014.</remarks>
+     * <param name="node">   The index of the node.</param>
+     * <param name="elem">   The element.</param>
+     * <param name="extents">The extents of the element.</param>
+     * <returns>true if any leaf held it, false if none did.</returns>
      **************************************************************************************************/
-    void DrawTopToBottom(BITMAP* dest);
+    bool RemoveElement(NodeIndex node, const T& elem, const Extents& extents);
 
     /**************************************************************************************************
-     * <summary>Draw bottom to top.</summary>
+     * <summary>Subdivide.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     * <param name="node">The index of the leaf.</param>
      **************************************************************************************************/
-    void DrawBottomToTop(BITMAP* dest);
+    void SubDivide(NodeIndex node);
 
+    /**************************************************************************************************
+     * <summary>Unsubdivide.</summary>
+     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <param name="node">The index of the node whose children are all leaves.</param>
+     **************************************************************************************************/
+    void UnSubDivide(NodeIndex node);
 
-    /// <summary> The elements </summary>
-    std::vector<T> _elements;
     /// <summary> The bounds </summary>
     a2de::Rectangle _bounds;
-    /// <summary> The parent </summary>
-    QuadTree<T>* _parent;
-    /// <summary> The children </summary>
-    std::vector<QuadTree<T>*> _children;
+    /// <summary> The node pool. The root is always the first node. </summary>
+    std::vector<Node> _nodes;
+    /// <summary> The first indices of unused blocks of children </summary>
+    std::vector<NodeIndex> _free_blocks;
+    /// <summary> The link pool </summary>
+    std::vector<Link> _links;
+    /// <summary> The first unused link </summary>
+    NodeIndex _free_link;
+    /// <summary> The elements, each stored once </summary>
+    std::vector<T> _elements;
+    /// <summary> The number of leaves linked to each element </summary>
+    std::vector<unsigned long> _element_refs;
+    /// <summary> The query that last reported each element </summary>
+    std::vector<unsigned long> _element_stamps;
+    /// <summary> The indices of unused elements </summary>
+    std::vector<NodeIndex> _free_elements;
+    /// <summary> The current query </summary>
+    unsigned long _stamp;
+    /// <summary> The traversal stack, kept to avoid allocating per query </summary>
+    std::vector<NodeIndex> _stack;
+    /// <summary> The VisitNearest heap, kept to avoid allocating per query </summary>
+    std::vector<Candidate> _nearest;
 
     //DO NOT COPY!
 
@@ -362,18 +662,6 @@ private:
 };
 
 
-template<typename T>
-T* ptr(T& obj) {
-    //turn reference into pointer!
-    return &obj;
-}
-
-template<typename T>
-T* ptr(T* obj) {
-    //obj is already pointer, return it!
-    return obj;
-}
-
 template<typename T>
 unsigned long QuadTree<T>::MAX_ELEMENTS = 2;
 
@@ -382,119 +670,190 @@ std::size_t QuadTree<T>::MAX_CHILDREN = 4;
 
 
 template<typename T>
-QuadTree<T>::QuadTree(const a2de::Rectangle& bounds) : _elements(), _bounds(bounds), _parent(nullptr), _children(4) {
+QuadTree<T>::QuadTree(const a2de::Rectangle& bounds) : _bounds(bounds), _nodes(), _free_blocks(), _links(), _free_link(NULL_INDEX), _elements(), _element_refs(), _element_stamps(), _free_elements(), _stamp(0), _stack(), _nearest() {
     DEFAULT_NODE_COLOR = a2de::Color::WHITE();
     _bounds.SetColor(_bounds.GetColor());
     _bounds.SetFill(false);
+    Clear();
 }
 
 template<typename T>
-QuadTree<T>::QuadTree(QuadTree<T>* parent_node, const a2de::Rectangle& bounds) : _elements(), _bounds(bounds), _parent(parent_node), _children(4) {
-    DEFAULT_NODE_COLOR = a2de::Color::WHITE();
-    _bounds.SetColor(_bounds.GetColor());
-    _bounds.SetFill(false);
+QuadTree<T>::~QuadTree() {
+    _nodes.clear();
+    _links.clear();
+    _elements.clear();
 }
 
+
 template<typename T>
-QuadTree<T>::QuadTree(QuadTree<T>* parent_node, const a2de::Rectangle& bounds, std::vector<T>& elems) : _elements(elems), _bounds(bounds), _parent(parent_node), _children(4) {
-    DEFAULT_NODE_COLOR = a2de::Color::WHITE();
-    _bounds.SetColor(_bounds.GetColor());
-    _bounds.SetFill(false);
-    Add(elems);
+const a2de::Rectangle& QuadTree<T>::GetBounds() const {
+    return _bounds;
 }
 
 template<typename T>
-QuadTree<T>::~QuadTree() {
-    this->_elements.clear();
-    this->_parent = nullptr;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        delete this->_children[i];
-        this->_children[i] = nullptr;
-    }
+a2de::Rectangle& QuadTree<T>::GetBounds() {
+    return const_cast<a2de::Rectangle&>(static_cast<const QuadTree<T>&>(*this).GetBounds());
 }
 
+template<typename T>
+a2de::Rectangle QuadTree<T>::GetNodeBounds(NodeIndex node) const {
+    const Node& n = _nodes[node];
+    return a2de::Rectangle(n.x, n.y, n.half_width, n.half_height, _bounds.GetColor(), _bounds.IsFilled());
+}
 
 template<typename T>
-const a2de::Rectangle& QuadTree<T>::GetBounds() const {
-    return _bounds;
+typename QuadTree<T>::Extents QuadTree<T>::GetExtents(const a2de::Vector2D& point) {
+    Extents result = { point.GetX(), point.GetY(), point.GetX(), point.GetY() };
+    return result;
 }
 
 template<typename T>
-a2de::Rectangle& QuadTree<T>::GetBounds() {
-    return const_cast<a2de::Rectangle&>(static_cast<const QuadTree<T>&>(*this).GetBounds());
+typename QuadTree<T>::Extents QuadTree<T>::GetExtents(const a2de::Shape& shape) {
+    //Shape dimensions are half-extents about the position.
+    Extents result = { shape.GetX() - shape.GetWidth(), shape.GetY() - shape.GetHeight(), shape.GetX() + shape.GetWidth(), shape.GetY() + shape.GetHeight() };
+    return result;
 }
 
 template<typename T>
-std::vector<QuadTree<T>*> QuadTree<T>::GetNodesByElement(T& elem) {
+bool QuadTree<T>::Overlaps(const Node& node, const Extents& extents) {
+    if(node.x + node.half_width < extents.min_x || extents.max_x < node.x - node.half_width) return false;
+    if(node.y + node.half_height < extents.min_y || extents.max_y < node.y - node.half_height) return false;
+    return true;
+}
 
-    std::vector<QuadTree<T>*> result;
-    if(IsLeaf(this) == false) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            std::vector<QuadTree<T>*> child_result = _children[i]->GetNodesByElement(elem);
-            for(std::vector<QuadTree<T>*>::iterator _iter = child_result.begin(); _iter != child_result.end(); ++_iter) {
-                result.push_back((*_iter));
-            }
+template<typename T>
+typename QuadTree<T>::Extents QuadTree<T>::GetExtents(const Node& node) {
+    Extents result = { node.x - node.half_width, node.y - node.half_height, node.x + node.half_width, node.y + node.half_height };
+    return result;
+}
+
+template<typename T>
+bool QuadTree<T>::Crosses(const Extents& extents, const a2de::Vector2D& start, const a2de::Vector2D& end, double& t_enter) {
+    //Slab test: clip the segment's parameter range against each axis in turn.
+    double t_min = 0.0;
+    double t_max = 1.0;
+    double origin[2] = { start.GetX(), start.GetY() };
+    double direction[2] = { end.GetX() - start.GetX(), end.GetY() - start.GetY() };
+    double slab_min[2] = { extents.min_x, extents.min_y };
+    double slab_max[2] = { extents.max_x, extents.max_y };
+    for(std::size_t axis = 0; axis < 2; ++axis) {
+        if(a2de::Math::IsEqual(direction[axis], 0.0)) {
+            if(origin[axis] < slab_min[axis] || slab_max[axis] < origin[axis]) return false;
+            continue;
         }
-        result.shrink_to_fit();
+        double t1 = (slab_min[axis] - origin[axis]) / direction[axis];
+        double t2 = (slab_max[axis] - origin[axis]) / direction[axis];
+        if(t2 < t1) std::swap(t1, t2);
+        t_min = std::max(t_min, t1);
+        t_max = std::min(t_max, t2);
+        if(t_max < t_min) return false;
+    }
+    t_enter = t_min;
+    return true;
+}
+
+template<typename T>
+double QuadTree<T>::DistanceSquared(const Extents& extents, const a2de::Vector2D& point) {
+    double dx = std::max(0.0, std::max(extents.min_x - point.GetX(), point.GetX() - extents.max_x));
+    double dy = std::max(0.0, std::max(extents.min_y - point.GetY(), point.GetY() - extents.max_y));
+    return dx * dx + dy * dy;
+}
+
+template<typename T>
+bool QuadTree<T>::IsLeaf(NodeIndex node) const {
+    return _nodes[node].first_child == NULL_INDEX;
+}
+
+template<typename T>
+typename QuadTree<T>::NodeIndex QuadTree<T>::AllocateBlock() {
+    if(_free_blocks.empty() == false) {
+        NodeIndex first = _free_blocks.back();
+        _free_blocks.pop_back();
+        return first;
+    }
+    NodeIndex first = static_cast<NodeIndex>(_nodes.size());
+    _nodes.resize(_nodes.size() + MAX_CHILDREN);
+    return first;
+}
+
+template<typename T>
+void QuadTree<T>::LinkElement(NodeIndex node, NodeIndex element) {
+    NodeIndex link = _free_link;
+    if(link == NULL_INDEX) {
+        link = static_cast<NodeIndex>(_links.size());
+        _links.push_back(Link());
     } else {
-        std::vector<T>::iterator _iter;
-        if((_iter = std::find(_elements.begin(), _elements.end(), elem)) != _elements.end()) {
-            result.push_back(this);
-        }
+        _free_link = _links[link].next;
     }
+    _links[link].element = element;
+    _links[link].next = _nodes[node].first_link;
+    _nodes[node].first_link = link;
+    ++_nodes[node].element_count;
+    ++_element_refs[element];
+}
+
+template<typename T>
+void QuadTree<T>::ReleaseLink(NodeIndex link) {
+    NodeIndex element = _links[link].element;
+    _links[link].next = _free_link;
+    _free_link = link;
+    if(--_element_refs[element] == 0) {
+        _free_elements.push_back(element);
+    }
+}
+
+template<typename T>
+void QuadTree<T>::NextStamp() {
+    ++_stamp;
+    if(_stamp != 0) return;
+    //Wrapped around; no element may keep a stamp that could match again.
+    std::fill(_element_stamps.begin(), _element_stamps.end(), 0);
+    _stamp = 1;
+}
+
+template<typename T>
+std::vector<typename QuadTree<T>::NodeIndex> QuadTree<T>::GetNodesByElement(T& elem) {
+    std::vector<NodeIndex> result;
+    GetNodesByElement(elem, std::back_inserter(result));
     return result;
 }
 
 template<typename T>
 void QuadTree<T>::Remove(std::vector<T>& elems) {
-    std::vector<T>::iterator b = elems.begin();
-    std::vector<T>::iterator e = elems.end();
-    for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
+    typename std::vector<T>::iterator b = elems.begin();
+    typename std::vector<T>::iterator e = elems.end();
+    for(typename std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
         this->Remove(*_iter);
     }
 }
 
 template<typename T>
-std::vector<QuadTree<T>*> QuadTree<T>::GetNodesByLocation(a2de::Vector2D& loc) {
-    std::vector<QuadTree<T>*> results;
-    if(_bounds.Intersects(loc)) {
-        if(IsLeaf(this) == false) {
-            std::vector<QuadTree<T>*> child_results;
-            for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-                child_results = _children[i]->GetNodesByLocation(loc);
-                std::vector<QuadTree<T>*>::iterator b = child_results.begin();
-                std::vector<QuadTree<T>*>::iterator e = child_results.end();
-                for(std::vector<QuadTree<T>*>::iterator _iter = b; _iter != e; ++_iter) {
-                    results.push_back(*_iter);
-                }
-                child_results.clear();
-            }
-        } else {
-            results.push_back(this);
-        }
-    }
+std::vector<typename QuadTree<T>::NodeIndex> QuadTree<T>::GetNodesByLocation(a2de::Vector2D& loc) {
+    std::vector<NodeIndex> results;
+    GetNodesByLocation(loc, std::back_inserter(results));
     return results;
 }
 
 template<typename T>
 void QuadTree<T>::Add(std::vector<T>& elems) {
-    std::vector<T>::iterator b = elems.begin();
-    std::vector<T>::iterator e = elems.end();
-    for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
+    typename std::vector<T>::iterator b = elems.begin();
+    typename std::vector<T>::iterator e = elems.end();
+    for(typename std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
         this->Add(*_iter);
     }
 }
 
 template<typename T>
-std::vector<QuadTree<T>*> QuadTree<T>::GetSiblings(QuadTree<T>* node) {
-    std::vector<QuadTree<T>*> siblings;
-    if(node == nullptr) return siblings;
-    if(node->_parent == nullptr) {
+std::vector<typename QuadTree<T>::NodeIndex> QuadTree<T>::GetSiblings(NodeIndex node) {
+    std::vector<NodeIndex> siblings;
+    if(node >= _nodes.size()) return siblings;
+    NodeIndex parent = _nodes[node].parent;
+    if(parent == NULL_INDEX) {
         siblings.push_back(node);
         return siblings;
     }
     for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        siblings.push_back(_parent->_children[i]);
+        siblings.push_back(_nodes[parent].first_child + i);
     }
     return siblings;
 
@@ -502,57 +861,251 @@ std::vector<QuadTree<T>*> QuadTree<T>::GetSiblings(QuadTree<T>* node) {
 
 template<typename T>
 std::vector<T> QuadTree<T>::GetAllElements() {
-    return this->GetElements(this);
+    std::vector<T> total_elements;
+    total_elements.reserve(_elements.size() - _free_elements.size());
+    GetAllElements(std::back_inserter(total_elements));
+    return total_elements;
+}
+
+template<typename T>
+std::vector<T> QuadTree<T>::Query(const a2de::Shape& area) {
+    std::vector<T> selected_elements;
+    Query(area, std::back_inserter(selected_elements));
+    return selected_elements;
+}
+
+template<typename T>
+std::vector<T> QuadTree<T>::QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end) {
+    std::vector<T> selected_elements;
+    QueryRay(start, end, std::back_inserter(selected_elements));
+    return selected_elements;
 }
 
 template<typename T>
-std::vector<T> QuadTree<T>::GetElements(QuadTree<T>* node) {
-    class IsInTotal {
-    public:
-        IsInTotal(std::vector<T>* total_elements) : _total_elements(total_elements) { }
-        bool operator()(T& elem) {
-            return std::find(_total_elements->begin(), _total_elements->end(), elem) == _total_elements->end();
+template<typename OutputIterator>
+OutputIterator QuadTree<T>::Query(const a2de::Shape& area, OutputIterator out) {
+    Visit(area, OutputVisitor<OutputIterator>(out, static_cast<std::size_t>(-1)));
+    return out;
+}
+
+template<typename T>
+template<typename OutputIterator>
+OutputIterator QuadTree<T>::QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end, OutputIterator out) {
+    VisitRay(start, end, OutputVisitor<OutputIterator>(out, static_cast<std::size_t>(-1)));
+    return out;
+}
+
+template<typename T>
+template<typename OutputIterator>
+OutputIterator QuadTree<T>::QueryNearest(const a2de::Vector2D& point, std::size_t k, OutputIterator out) {
+    if(k == 0) return out;
+    VisitNearest(point, OutputVisitor<OutputIterator>(out, k));
+    return out;
+}
+
+template<typename T>
+template<typename OutputIterator>
+OutputIterator QuadTree<T>::GetNodesByElement(const T& elem, OutputIterator out) {
+    VisitNodesByElement(elem, OutputVisitor<OutputIterator>(out, static_cast<std::size_t>(-1)));
+    return out;
+}
+
+template<typename T>
+template<typename OutputIterator>
+OutputIterator QuadTree<T>::GetNodesByLocation(const a2de::Vector2D& loc, OutputIterator out) {
+    VisitNodesByLocation(loc, OutputVisitor<OutputIterator>(out, static_cast<std::size_t>(-1)));
+    return out;
+}
+
+template<typename T>
+template<typename OutputIterator>
+OutputIterator QuadTree<T>::GetAllElements(OutputIterator out) {
+    VisitAllElements(OutputVisitor<OutputIterator>(out, static_cast<std::size_t>(-1)));
+    return out;
+}
+
+template<typename T>
+template<typename Visitor>
+bool QuadTree<T>::Visit(const a2de::Shape& area, Visitor visitor) {
+    Extents area_extents = GetExtents(area);
+    NextStamp();
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        NodeIndex node = _stack.back();
+        _stack.pop_back();
+        if(Overlaps(_nodes[node], area_extents) == false) continue;
+        if(IsLeaf(node) == false) {
+            for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+                _stack.push_back(_nodes[node].first_child + i);
+            }
+            continue;
         }
-    private:
-        std::vector<T>* _total_elements;
-    };
-    std::vector<T> total_elements;
-    if(node == nullptr) return total_elements;
-    if(IsLeaf(node)) return node->_elements;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        std::vector<T> c_elems(node->GetElements(node->_children[i]));
-        std::size_t c_s = c_elems.size();
-        for(std::size_t c = 0; c < c_s; ++c) {
-            std::copy_if(c_elems.begin(), c_elems.end(), std::back_inserter(total_elements), IsInTotal(&total_elements));
+        for(NodeIndex link = _nodes[node].first_link; link != NULL_INDEX; link = _links[link].next) {
+            NodeIndex element = _links[link].element;
+            if(_element_stamps[element] == _stamp) continue;
+            _element_stamps[element] = _stamp;
+            if(visitor(_elements[element]) == false) return false;
         }
     }
-    return total_elements;
+    return true;
 }
+
 template<typename T>
-void QuadTree<T>::QueryNode(QuadTree<T>* node, const a2de::Shape& area, std::vector<T>& selected_elements) {
+template<typename Visitor>
+bool QuadTree<T>::VisitRay(const a2de::Vector2D& start, const a2de::Vector2D& end, Visitor visitor) {
+    double t_enter = 0.0;
+    if(Crosses(GetExtents(_nodes[0]), start, end, t_enter) == false) return true;
+    NextStamp();
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        NodeIndex node = _stack.back();
+        _stack.pop_back();
+        if(IsLeaf(node)) {
+            for(NodeIndex link = _nodes[node].first_link; link != NULL_INDEX; link = _links[link].next) {
+                NodeIndex element = _links[link].element;
+                if(_element_stamps[element] == _stamp) continue;
+                _element_stamps[element] = _stamp;
+                if(Crosses(GetExtents(bounds_of(_elements[element])), start, end, t_enter) == false) continue;
+                if(visitor(_elements[element]) == false) return false;
+            }
+            continue;
+        }
+        //Push the crossed children farthest first so the nearest is walked next. Siblings do not overlap,
+        //so this walks the leaves in the order the segment passes through them.
+        NodeIndex crossed[4];
+        double entries[4];
+        std::size_t count = 0;
+        NodeIndex first = _nodes[node].first_child;
+        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+            if(Crosses(GetExtents(_nodes[first + i]), start, end, t_enter) == false) continue;
+            std::size_t j = count++;
+            for(; j > 0 && entries[j - 1] < t_enter; --j) {
+                crossed[j] = crossed[j - 1];
+                entries[j] = entries[j - 1];
+            }
+            crossed[j] = first + i;
+            entries[j] = t_enter;
+        }
+        for(std::size_t i = 0; i < count; ++i) {
+            _stack.push_back(crossed[i]);
+        }
+    }
+    return true;
+}
 
-    if(node == nullptr) return;
+template<typename T>
+template<typename Visitor>
+bool QuadTree<T>::VisitNearest(const a2de::Vector2D& point, Visitor visitor) {
+    //Best-first: a node is never farther than the elements it holds, so elements leave the heap in order.
+    NextStamp();
+    _nearest.clear();
+    Candidate root = { DistanceSquared(GetExtents(_nodes[0]), point), 0, false };
+    _nearest.push_back(root);
+    while(_nearest.empty() == false) {
+        std::pop_heap(_nearest.begin(), _nearest.end());
+        Candidate current = _nearest.back();
+        _nearest.pop_back();
+        if(current.is_element) {
+            if(visitor(_elements[current.index]) == false) return false;
+            continue;
+        }
+        if(IsLeaf(current.index)) {
+            for(NodeIndex link = _nodes[current.index].first_link; link != NULL_INDEX; link = _links[link].next) {
+                NodeIndex element = _links[link].element;
+                if(_element_stamps[element] == _stamp) continue;
+                _element_stamps[element] = _stamp;
+                Candidate candidate = { DistanceSquared(GetExtents(bounds_of(_elements[element])), point), element, true };
+                _nearest.push_back(candidate);
+                std::push_heap(_nearest.begin(), _nearest.end());
+            }
+            continue;
+        }
+        NodeIndex first = _nodes[current.index].first_child;
+        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+            Candidate candidate = { DistanceSquared(GetExtents(_nodes[first + i]), point), static_cast<NodeIndex>(first + i), false };
+            _nearest.push_back(candidate);
+            std::push_heap(_nearest.begin(), _nearest.end());
+        }
+    }
+    return true;
+}
 
-    if(node->_bounds.Intersects(area) == false) return;
+template<typename T>
+template<typename Visitor>
+bool QuadTree<T>::VisitNodesByElement(const T& elem, Visitor visitor) {
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        NodeIndex node = _stack.back();
+        _stack.pop_back();
+        if(IsLeaf(node) == false) {
+            for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+                _stack.push_back(_nodes[node].first_child + i);
+            }
+            continue;
+        }
+        for(NodeIndex link = _nodes[node].first_link; link != NULL_INDEX; link = _links[link].next) {
+            if((_elements[_links[link].element] == elem) == false) continue;
+            if(visitor(node) == false) return false;
+            break;
+        }
+    }
+    return true;
+}
 
-    if(IsLeaf(node)) {
-        std::vector<T>::iterator b = node->_elements.begin();
-        std::vector<T>::iterator e = node->_elements.end();
-        for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
-            selected_elements.push_back(*_iter);
+template<typename T>
+template<typename Visitor>
+bool QuadTree<T>::VisitNodesByLocation(const a2de::Vector2D& loc, Visitor visitor) {
+    Extents point = GetExtents(loc);
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        NodeIndex node = _stack.back();
+        _stack.pop_back();
+        if(Overlaps(_nodes[node], point) == false) continue;
+        if(IsLeaf(node)) {
+            if(visitor(node) == false) return false;
+            continue;
+        }
+        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+            _stack.push_back(_nodes[node].first_child + i);
         }
-        return;
     }
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        QueryNode(node->_children[i], area, selected_elements);
+    return true;
+}
+
+template<typename T>
+template<typename Visitor>
+bool QuadTree<T>::VisitAllElements(Visitor visitor) {
+    std::size_t s = _elements.size();
+    for(std::size_t i = 0; i < s; ++i) {
+        if(_element_refs[i] == 0) continue;
+        if(visitor(_elements[i]) == false) return false;
     }
+    return true;
 }
 
 template<typename T>
-std::vector<T> QuadTree<T>::Query(const a2de::Shape& area) {
-    std::vector<T> selected_elements;
-    QueryNode(this, area, selected_elements);
-    return selected_elements;
+void QuadTree<T>::QueryPairs(std::vector<std::pair<T, T> >& pairs) {
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        NodeIndex node = _stack.back();
+        _stack.pop_back();
+        if(IsLeaf(node) == false) {
+            for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+                _stack.push_back(_nodes[node].first_child + i);
+            }
+            continue;
+        }
+        for(NodeIndex first = _nodes[node].first_link; first != NULL_INDEX; first = _links[first].next) {
+            for(NodeIndex second = _links[first].next; second != NULL_INDEX; second = _links[second].next) {
+                pairs.push_back(std::make_pair(_elements[_links[first].element], _elements[_links[second].element]));
+            }
+        }
+    }
 }
 
 template<typename T>
@@ -582,172 +1135,185 @@ void QuadTree<T>::ResetNodeColor() {
 
 template<typename T>
 unsigned long QuadTree<T>::NumberOfElementsInTree() {
-    if(IsLeaf(this)) return _elements.size();
-    unsigned long num_elements = 0;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        num_elements += _children[i]->NumberOfElementsInTree();
-    }
-    return num_elements;
+    return _elements.size() - _free_elements.size();
 }
 
 template<typename T>
 unsigned long QuadTree<T>::Divisions() {
-    if(IsLeaf(this)) return 0;
-    unsigned long num_divisions = MAX_CHILDREN;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        num_divisions += _children[i]->Divisions();
-    }
-    return num_divisions;
+    return (_nodes.size() - 1) - (_free_blocks.size() * MAX_CHILDREN);
 }
 
 template<typename T>
 unsigned long QuadTree<T>::Height() {
-
-    if(IsLeaf(this)) return 0;
-    unsigned long height = 1;
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        height += _children[i]->Height();
+    unsigned long height = 0;
+    std::size_t s = _nodes.size();
+    for(std::size_t i = 0; i < s; ++i) {
+        if(IsLeaf(i) == false) continue;
+        //Freed blocks are detached from the tree and have no parent to walk.
+        if(i != 0 && _nodes[i].parent == NULL_INDEX) continue;
+        unsigned long depth = 0;
+        for(NodeIndex node = static_cast<NodeIndex>(i); _nodes[node].parent != NULL_INDEX; node = _nodes[node].parent) {
+            ++depth;
+        }
+        height = std::max(height, depth);
     }
     return height;
 }
 
 template<typename T>
-bool QuadTree<T>::IsLeaf(QuadTree<T>* node) {
-    return (node->_children[CHILD_FIRST] == nullptr);
-}
-
-template<typename T>
-void QuadTree<T>::DrawTopToBottom(BITMAP* dest) {
-    _bounds.Draw(dest, _bounds.GetColor(), _bounds.IsFilled());
-    if(IsLeaf(this) == false) {
+void QuadTree<T>::Draw(BITMAP* dest, bool top_to_bottom) {
+    //Pre-order puts every parent before its children.
+    std::vector<NodeIndex> order;
+    _stack.clear();
+    _stack.push_back(0);
+    while(_stack.empty() == false) {
+        NodeIndex node = _stack.back();
+        _stack.pop_back();
+        order.push_back(node);
+        if(IsLeaf(node)) continue;
         for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            _children[i]->DrawTopToBottom(dest);
+            _stack.push_back(_nodes[node].first_child + i);
         }
     }
-}
-
-template<typename T>
-void QuadTree<T>::DrawBottomToTop(BITMAP* dest) {
-    if(IsLeaf(this) == false) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            _children[i]->DrawBottomToTop(dest);
-        }
+    if(top_to_bottom == false) {
+        std::reverse(order.begin(), order.end());
+    }
+    for(typename std::vector<NodeIndex>::iterator _iter = order.begin(); _iter != order.end(); ++_iter) {
+        GetNodeBounds(*_iter).Draw(dest, _bounds.GetColor(), _bounds.IsFilled());
     }
-    _bounds.Draw(dest, _bounds.GetColor(), _bounds.IsFilled());
 }
 
 template<typename T>
-void QuadTree<T>::Draw(BITMAP* dest, bool top_to_bottom) {
-    top_to_bottom ? DrawTopToBottom(dest) : DrawBottomToTop(dest);
+void QuadTree<T>::Draw(BITMAP* dest) {
+    Draw(dest, true);
 }
 
 template<typename T>
-void QuadTree<T>::SubDivide() {
-    try {
-        //Define 
-        double half_width = _bounds.GetWidth();
-        double half_height = _bounds.GetHeight();
-        if(a2de::Math::ToScreenScale(half_width) <= 1.0 || a2de::Math::ToScreenScale(half_height) <= 1.0) return;
-
-        a2de::Vector2D dimensions(half_width, half_height);
-        a2de::Vector2D ul_pos(this->_bounds.GetPosition() - (a2de::Vector2D(half_width, half_height) / 2.0));
-        a2de::Vector2D ur_pos(ul_pos + a2de::Vector2D(half_width, 0.0));
-        a2de::Vector2D ll_pos(ul_pos + a2de::Vector2D(0.0, half_height));
-        a2de::Vector2D lr_pos(ul_pos + a2de::Vector2D(half_width, half_height));
-        a2de::Color color = _bounds.GetColor();
-        bool filled = _bounds.IsFilled();
-
-        a2de::Rectangle ul(ul_pos, dimensions / 2.0, color, filled);
-        a2de::Rectangle ur(ur_pos, dimensions / 2.0, color, filled);
-        a2de::Rectangle ll(ll_pos, dimensions / 2.0, color, filled);
-        a2de::Rectangle lr(lr_pos, dimensions / 2.0, color, filled);
-
-        _children[CHILD_UPPER_LEFT] = new QuadTree(this, ul);
-        _children[CHILD_UPPER_RIGHT] = new QuadTree(this, ur);
-        _children[CHILD_LOWER_LEFT] = new QuadTree(this, ll);
-        _children[CHILD_LOWER_RIGHT] = new QuadTree(this, lr);
+void QuadTree<T>::SubDivide(NodeIndex node) {
+    //Define
+    double half_width = _nodes[node].half_width;
+    double half_height = _nodes[node].half_height;
+    if(a2de::Math::ToScreenScale(half_width) <= 1.0 || a2de::Math::ToScreenScale(half_height) <= 1.0) return;
+
+    //Allocating may move the pool; index into it from here on.
+    NodeIndex first = AllocateBlock();
+    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
+        Node& child = _nodes[first + i];
+        bool right = (i == CHILD_UPPER_RIGHT || i == CHILD_LOWER_RIGHT);
+        bool lower = (i == CHILD_LOWER_LEFT || i == CHILD_LOWER_RIGHT);
+        child.x = _nodes[node].x + (right ? half_width : -half_width) / 2.0;
+        child.y = _nodes[node].y + (lower ? half_height : -half_height) / 2.0;
+        child.half_width = half_width / 2.0;
+        child.half_height = half_height / 2.0;
+        child.parent = node;
+        child.first_child = NULL_INDEX;
+        child.first_link = NULL_INDEX;
+        child.element_count = 0;
+    }
 
-        //Give elements of mine to children, may or may not accept them.
+    NodeIndex link = _nodes[node].first_link;
+    _nodes[node].first_child = first;
+    _nodes[node].first_link = NULL_INDEX;
+    _nodes[node].element_count = 0;
+
+    //Give elements of mine to children. Link to the children before releasing my link so the element stays alive.
+    while(link != NULL_INDEX) {
+        NodeIndex next = _links[link].next;
+        NodeIndex element = _links[link].element;
+        Extents extents = GetExtents(bounds_of(_elements[element]));
+        bool accepted = false;
         for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            std::vector<T>::iterator b = _elements.begin();
-            for(std::vector<T>::iterator _iter = b; _iter != _elements.end(); /** DO NOTHING **/) {
-                if(_children[i]->Add(*_iter) == false) {
-                    ++_iter;
-                    continue;
-                }
-                _iter = _elements.erase(_iter);
-            }
+            accepted |= InsertElement(first + i, element, extents);
         }
-
-    } catch(...) {
-        for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            if(_children[i]) {
-                delete _children[i];
-                _children[i] = nullptr;
-            }
+        if(accepted == false) {
+            LinkElement(first + CHILD_FIRST, element);
         }
+        ReleaseLink(link);
+        link = next;
     }
 }
 
 template<typename T>
-void QuadTree<T>::UnSubDivide() {
-
+void QuadTree<T>::UnSubDivide(NodeIndex node) {
+    NodeIndex first = _nodes[node].first_child;
     for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        QuadTree<T>* curNode = _children[i];
-        QuadTree<T>* curNodeParent = curNode->_parent;
-        for(std::vector<T>::iterator _iter = curNode->_elements.begin(); _iter != curNode->_elements.end(); ++_iter) {
-            curNodeParent->_elements.push_back(*_iter);
+        NodeIndex child = first + i;
+        NodeIndex link = _nodes[child].first_link;
+        while(link != NULL_INDEX) {
+            NodeIndex next = _links[link].next;
+            NodeIndex element = _links[link].element;
+            //Elements that straddle children are linked from each of them.
+            bool linked = false;
+            for(NodeIndex other = _nodes[node].first_link; other != NULL_INDEX; other = _links[other].next) {
+                if(_links[other].element != element) continue;
+                linked = true;
+                break;
+            }
+            if(linked == false) {
+                LinkElement(node, element);
+            }
+            ReleaseLink(link);
+            link = next;
         }
-        delete _children[i];
-        _children[i] = nullptr;
+        _nodes[child].first_link = NULL_INDEX;
+        _nodes[child].element_count = 0;
+        _nodes[child].parent = NULL_INDEX;
     }
+    _nodes[node].first_child = NULL_INDEX;
+    _free_blocks.push_back(first);
 }
 
 template<typename T>
-bool QuadTree<T>::Add(const T& elem) {
+bool QuadTree<T>::InsertElement(NodeIndex node, NodeIndex element, const Extents& extents) {
+    if(Overlaps(_nodes[node], extents) == false) return false;
 
-    if(ptr(elem)) {
-        bool intersects_result = _bounds.Intersects(*ptr(elem));
-        if(intersects_result == false) {
-            return false;
-        }
-    }
-
-    if(IsLeaf(this) == false) {
+    if(IsLeaf(node) == false) {
         bool result = false;
+        NodeIndex first = _nodes[node].first_child;
         for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            result |= _children[i]->Add(elem);
+            result |= InsertElement(first + i, element, extents);
         }
         return result;
     }
-    _elements.push_back(elem);
-    if(_elements.size() > MAX_ELEMENTS) {
-        SubDivide();
+    LinkElement(node, element);
+    if(_nodes[node].element_count > MAX_ELEMENTS) {
+        SubDivide(node);
     }
     return true;
 }
 
 template<typename T>
-bool QuadTree<T>::Add(const T* elem) {
-    return Add(*elem);
-}
-
-template<typename T>
-bool QuadTree<T>::Remove(const T& elem) {
-
-    if(ptr(elem) && _bounds.Intersects(*ptr(elem)) == false) return false;
+bool QuadTree<T>::RemoveElement(NodeIndex node, const T& elem, const Extents& extents) {
+    if(Overlaps(_nodes[node], extents) == false) return false;
 
-    if(IsLeaf(this)) {
-        return RemoveElement(elem);
+    if(IsLeaf(node)) {
+        NodeIndex previous = NULL_INDEX;
+        for(NodeIndex link = _nodes[node].first_link; link != NULL_INDEX; link = _links[link].next) {
+            if((_elements[_links[link].element] == elem) == false) {
+                previous = link;
+                continue;
+            }
+            if(previous == NULL_INDEX) {
+                _nodes[node].first_link = _links[link].next;
+            } else {
+                _links[previous].next = _links[link].next;
+            }
+            --_nodes[node].element_count;
+            ReleaseLink(link);
+            return true;
+        }
+        return false;
     }
 
+    bool result = false;
+    NodeIndex first = _nodes[node].first_child;
     for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        _children[i]->Remove(elem);
+        result |= RemoveElement(first + i, elem, extents);
     }
 
     bool all_children_are_leaves = true;
     for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        if(IsLeaf(_children[i])) continue;
+        if(IsLeaf(first + i)) continue;
         all_children_are_leaves = false;
         break;
     }
@@ -755,15 +1321,53 @@ bool QuadTree<T>::Remove(const T& elem) {
     if(all_children_are_leaves) {
         unsigned long elements_in_children = 0;
         for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-            elements_in_children += _children[i]->NumberOfElementsInTree();
+            elements_in_children += _nodes[first + i].element_count;
         }
         if(elements_in_children < MAX_ELEMENTS) {
-            UnSubDivide();
+            UnSubDivide(node);
         }
     }
+    return result;
+}
+
+template<typename T>
+bool QuadTree<T>::Add(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+
+    Extents extents = GetExtents(bounds_of(elem));
+    if(Overlaps(_nodes[0], extents) == false) return false;
+
+    NodeIndex element = 0;
+    if(_free_elements.empty()) {
+        element = static_cast<NodeIndex>(_elements.size());
+        _elements.push_back(elem);
+        _element_refs.push_back(0);
+        _element_stamps.push_back(0);
+    } else {
+        element = _free_elements.back();
+        _free_elements.pop_back();
+        _elements[element] = elem;
+    }
+
+    if(InsertElement(0, element, extents) == false) {
+        _free_elements.push_back(element);
+        return false;
+    }
     return true;
 }
 
+template<typename T>
+bool QuadTree<T>::Add(const T* elem) {
+    return Add(*elem);
+}
+
+template<typename T>
+bool QuadTree<T>::Remove(const T& elem) {
+    if(ptr(elem) == nullptr) return false;
+    return RemoveElement(0, elem, GetExtents(bounds_of(elem)));
+}
+
 template<typename T>
 bool QuadTree<T>::Remove(const T* elem) {
     return Remove(*elem);
@@ -771,7 +1375,9 @@ bool QuadTree<T>::Remove(const T* elem) {
 
 template<typename T>
 bool QuadTree<T>::Update(const T& elem) {
+    //Remove under the extents elem was stored with, then store it under its new ones.
     if(Remove(elem)) {
+        refit(elem);
         if(Add(elem)) {
             return true;
         }
@@ -786,49 +1392,35 @@ bool QuadTree<T>::Update(const T* elem) {
 
 template<typename T>
 void QuadTree<T>::Update(std::vector<T>& elem) {
-    std::vector<T>::iterator b = elem.begin();
-    std::vector<T>::iterator e = elem.end();
-    for(std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
+    typename std::vector<T>::iterator b = elem.begin();
+    typename std::vector<T>::iterator e = elem.end();
+    for(typename std::vector<T>::iterator _iter = b; _iter != e; ++_iter) {
         Update(*_iter);
     }
 }
 
-
-template<typename T>
-bool QuadTree<T>::RemoveElement(const T& elem) {
-
-    std::vector<T>::iterator b = _elements.begin();
-    std::vector<T>::iterator e = _elements.end();
-    std::vector<T>::iterator _iter = b;
-    _iter = std::find(b, e, elem);
-    if(_iter != _elements.end()) {
-        _elements.erase(_iter);
-        return true;
-    }
-    return false;
-}
-
 template<typename T>
 void QuadTree<T>::Clear() {
-    Clear(this);
-}
-
-template<typename T>
-void QuadTree<T>::Clear(QuadTree<T>* node) {
-
-    if(IsLeaf(node)) {
-        node->_elements.clear();
-        return;
-    }
-    
-    for(std::size_t i = 0; i < MAX_CHILDREN; ++i) {
-        node->_children[i]->Clear();
-    }
-    node->UnSubDivide();
-    node->_elements.clear();
-
+    //Every pool holds plain data, so shrinking them is a reset rather than a teardown.
+    _nodes.resize(1);
+    Node& root = _nodes[0];
+    root.x = _bounds.GetX();
+    root.y = _bounds.GetY();
+    root.half_width = _bounds.GetWidth();
+    root.half_height = _bounds.GetHeight();
+    root.parent = NULL_INDEX;
+    root.first_child = NULL_INDEX;
+    root.first_link = NULL_INDEX;
+    root.element_count = 0;
+    _free_blocks.clear();
+    _links.clear();
+    _free_link = NULL_INDEX;
+    _elements.clear();
+    _element_refs.clear();
+    _element_stamps.clear();
+    _free_elements.clear();
 }
 
 A2DE_END
 
-#endif
\ No newline at end of file
+#endif
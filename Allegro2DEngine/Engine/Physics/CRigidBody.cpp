@@ -7,8 +7,9 @@
  **************************************************************************************************/
 #include "CRigidBody.h"
 
+#include "CBodyStore.h"
+
 #include <cmath>
-#include <numeric>
 #include "../Math/CPoint.h"
 #include "../Math/CRectangle.h"
 #include "../Time/CStopwatch.h"
@@ -20,23 +21,25 @@ double RigidBody::MASS_EQUIVALENCY_TOLERANCE = 0.0001;
 
 RigidBody::RigidBody(double mass, double gravModX, double gravModY, double restitution, double static_friction, double kinetic_friction)
  : _curState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), restitution, static_friction, kinetic_friction),
-   _prevState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), restitution, static_friction, kinetic_friction) { }
+   _store(nullptr), _store_index(0), _bullet(false), _sensor(false) { }
 
 RigidBody::RigidBody(double mass, const Vector2D& gravMod, const PhysicsMaterial& material)
  : _curState(mass, gravMod, Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()),
-   _prevState(mass, gravMod, Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()) { }
+   _store(nullptr), _store_index(0), _bullet(false), _sensor(false) { }
 
 RigidBody::RigidBody(double mass, double gravModX, double gravModY, const PhysicsMaterial& material)
  : _curState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()),
-   _prevState(mass, Vector2D(gravModX, gravModY), Vector2D(0.0, 0.0), Vector2D(0.0, 0.0), material.GetRestitution(), material.GetStaticFriction(), material.GetKineticFriction()) { }
+   _store(nullptr), _store_index(0), _bullet(false), _sensor(false) { }
 
 RigidBody::RigidBody(const State& state) 
  : _curState(state),
-   _prevState(state) { }
+   _store(nullptr), _store_index(0), _bullet(false), _sensor(false) { }
 
 RigidBody::RigidBody(const RigidBody& other)
  : _curState(other._curState),
-   _prevState(other._curState) { }
+   _store(nullptr), _store_index(0), _bullet(other._bullet), _sensor(other._sensor) {
+    CopyKinematics(other);
+}
 
 RigidBody::RigidBody(const RigidBodyDef& body_definition)
 : _curState(body_definition.mass,
@@ -46,24 +49,29 @@ RigidBody::RigidBody(const RigidBodyDef& body_definition)
   body_definition.restitution,
   body_definition.static_friction,
   body_definition.kinetic_friction),
-  _prevState(body_definition.mass,
-  Vector2D(body_definition.gravity_mod_x, body_definition.gravity_mod_y),
-  Vector2D(body_definition.position_x, body_definition.position_y),
-  Vector2D(body_definition.velocity_x, body_definition.velocity_y),
-  body_definition.restitution,
-  body_definition.static_friction,
-  body_definition.kinetic_friction) {
+  _store(nullptr),
+  _store_index(0),
+  _bullet(body_definition.bullet),
+  _sensor(body_definition.sensor) {
     /* DO NOTHING */
 }
 
 RigidBody::~RigidBody() {
-    /* DO NOTHING */
+    if(_store) _store->Detach(_store_index);
 }
 
 RigidBody& RigidBody::operator=(const RigidBody& rhs) {
     if(this == &rhs) return *this;
     this->_curState = rhs._curState;
-    this->_prevState = rhs._prevState;
+    this->_bullet = rhs._bullet;
+    this->_sensor = rhs._sensor;
+    //An attached body keeps its slot and takes the other body's values into it.
+    if(_store) {
+        _store->SetMass(_store_index, _curState.GetMass());
+        _store->SetGravityModifier(_store_index, _curState.GetGravityModifier());
+        _store->SetForced(_store_index, _curState.HasForces());
+    }
+    CopyKinematics(rhs);
     return *this;
 }
 
@@ -80,10 +88,11 @@ double RigidBody::GetMass() {
 }
 void RigidBody::SetMass(double mass) {
     _curState.SetMass(mass);
+    if(_store) _store->SetMass(_store_index, mass);
 }
 
 double RigidBody::GetXPosition() const {
-    return _curState.GetXPosition();
+    return GetPosition().GetX();
 }
 
 double RigidBody::GetXPosition() {
@@ -94,7 +103,7 @@ void RigidBody::SetXPosition(double x) {
 }
 
 double RigidBody::GetYPosition() const {
-    return _curState.GetYPosition();
+    return GetPosition().GetY();
 }
 double RigidBody::GetYPosition() {
     return static_cast<const RigidBody&>(*this).GetYPosition();
@@ -104,7 +113,7 @@ void RigidBody::SetYPosition(double y) {
 }
 
 double RigidBody::GetXVelocity() const {
-    return _curState.GetXVelocity();
+    return GetVelocity().GetX();
 }
 double RigidBody::GetXVelocity() {
     return static_cast<const RigidBody&>(*this).GetXVelocity();
@@ -114,7 +123,7 @@ void RigidBody::SetXVelocity(double x) {
 }
 
 double RigidBody::GetYVelocity() const {
-    return _curState.GetYVelocity();
+    return GetVelocity().GetY();
 }
 double RigidBody::GetYVelocity() {
     return static_cast<const RigidBody&>(*this).GetYVelocity();
@@ -128,6 +137,10 @@ void RigidBody::SetVelocity(double x, double y) {
 }
 
 void RigidBody::SetVelocity(const Vector2D& velocity) {
+    if(_store) {
+        _store->SetVelocity(_store_index, velocity);
+        return;
+    }
     _curState.SetVelocity(velocity);
 }
 
@@ -153,6 +166,7 @@ void RigidBody::SetYGravityModifier(double y) {
 
 void RigidBody::SetGravityModifier(double x, double y) {
     _curState.SetGravityModifier(x, y);
+    if(_store) _store->SetGravityModifier(_store_index, _curState.GetGravityModifier());
 }
 
 bool RigidBody::operator<(const RigidBody& rhs) const {
@@ -176,25 +190,27 @@ bool RigidBody::operator!=(const RigidBody& rhs) const {
 }
 
 double RigidBody::GetXAcceleration() const {
-    return _curState.GetXAcceleration();
+    return GetAcceleration().GetX();
 }
 double RigidBody::GetXAcceleration() {
     return static_cast<const RigidBody&>(*this).GetXAcceleration();
 }
 
 double RigidBody::GetYAcceleration() const {
-    return _curState.GetYAcceleration();
+    return GetAcceleration().GetY();
 }
 double RigidBody::GetYAcceleration() {
     return static_cast<const RigidBody&>(*this).GetYAcceleration();
 }
 
 void RigidBody::Update(double deltaTime) {
-    _prevState = _curState;
+    //The World integrates every attached body at once.
+    if(_store) return;
     _curState.Update(deltaTime);
 }
 
 const Vector2D& RigidBody::GetPosition() const {
+    //An attached body's State holds a copy of the store's position, refreshed every time it moves.
     return this->_curState.GetPosition();
 }
 
@@ -203,6 +219,7 @@ Vector2D& RigidBody::GetPosition() {
 }
 
 void a2de::RigidBody::SetPosition(const Vector2D& position) {
+    if(_store) _store->SetPosition(_store_index, position);
     _curState.SetPosition(position);
 }
 
@@ -211,6 +228,7 @@ void RigidBody::SetPosition(double x, double y) {
 }
 
 Vector2D RigidBody::GetVelocity() const {
+    if(_store) return _store->GetVelocity(_store_index);
     return _curState.GetVelocity();
 }
 
@@ -219,6 +237,7 @@ Vector2D RigidBody::GetVelocity() {
 }
 
 Vector2D RigidBody::GetAcceleration() const {
+    if(_store) return _store->GetAcceleration(_store_index);
     return _curState.GetAcceleration();
 }
 
@@ -227,6 +246,10 @@ Vector2D RigidBody::GetAcceleration() {
 }
 
 void RigidBody::SetAcceleration(const Vector2D& acceleration) {
+    if(_store) {
+        _store->SetAcceleration(_store_index, acceleration);
+        return;
+    }
     _curState.SetAcceleration(acceleration);
 }
 void RigidBody::SetAcceleration(double x, double y) {
@@ -248,13 +271,23 @@ Vector2D RigidBody::GetGravityModifier() {
 }
 
 void RigidBody::ApplyForce(const Vector2D& force, double duration) {
+    if(duration < 0.0) return;
     _curState.ApplyForce(force, duration);
+    if(_store) {
+        _store->SetForced(_store_index, true);
+        _store->SetActive(_store_index, true);
+    }
 }
 void RigidBody::ApplyForce(double x, double y, double duration) { ApplyForce(Vector2D(x, y), duration); }
 void RigidBody::ApplyXForce(double x, double duration) { ApplyForce(x, 0.0, duration); }
 void RigidBody::ApplyYForce(double y, double duration) { ApplyForce(0.0, y, duration); }
 
 void RigidBody::ApplyImpulse(const Vector2D& impulse) {
+    if(_store) {
+        _store->AddForce(_store_index, impulse);
+        _store->SetActive(_store_index, true);
+        return;
+    }
     _curState.ApplyImpulse(impulse);
 }
 void RigidBody::ApplyImpulse(double x, double y) { ApplyImpulse(Vector2D(x, y)); }
@@ -263,12 +296,18 @@ void RigidBody::ApplyYImpulse(double y) { ApplyImpulse(0.0, y); }
 
 void RigidBody::ClearForces() {
     _curState.ClearForces();
+    if(_store) _store->SetForced(_store_index, false);
 }
 
 void RigidBody::ClearImpulses() {
+    if(_store) _store->SetForce(_store_index, Vector2D());
     _curState.ClearImpulses();
 }
 
+const a2de::ForceBuffer& RigidBody::GetForces() const {
+    return _curState.GetForces();
+}
+
 double RigidBody::GetRestitution() const {
     return _curState.GetRestitution();
 }
@@ -347,14 +386,23 @@ double RigidBody::GetDamper() {
 }
 
 void RigidBody::Wake() {
+    if(_store) {
+        _store->SetActive(_store_index, true);
+        return;
+    }
     _curState.Wake();
 }
 
 void RigidBody::Sleep() {
+    if(_store) {
+        _store->SetActive(_store_index, false);
+        return;
+    }
     _curState.Sleep();
 }
 
 bool RigidBody::IsActive() const {
+    if(_store) return _store->IsActive(_store_index);
     return _curState.IsActive();
 }
 
@@ -362,5 +410,85 @@ bool RigidBody::IsActive() {
     return static_cast<const RigidBody&>(*this).IsActive();
 }
 
+bool RigidBody::IsBullet() const {
+    return _bullet;
+}
+
+void RigidBody::SetBullet(bool bullet) {
+    _bullet = bullet;
+}
+
+bool RigidBody::IsSensor() const {
+    return _sensor;
+}
+
+void RigidBody::SetSensor(bool sensor) {
+    _sensor = sensor;
+}
+
+void RigidBody::Attach(a2de::BodyStore* store, std::size_t index) {
+    if(_store) _store->Detach(_store_index);
+
+    store->SetPosition(index, _curState.GetPosition());
+    store->SetVelocity(index, _curState.GetVelocity());
+    store->SetAcceleration(index, _curState.GetAcceleration());
+    store->SetForce(index, _curState.GetImpulse());
+    store->SetMass(index, _curState.GetMass());
+    store->SetGravityModifier(index, _curState.GetGravityModifier());
+    store->SetActive(index, _curState.IsActive());
+    store->SetForced(index, _curState.HasForces());
+    _curState.ClearImpulses();
+
+    _store = store;
+    _store_index = index;
+}
+
+void RigidBody::Detach() {
+    if(_store == nullptr) return;
+
+    BodyStore* store = _store;
+    std::size_t index = _store_index;
+    _store = nullptr;
+    _store_index = 0;
+
+    _curState.SetPosition(store->GetPosition(index));
+    _curState.SetVelocity(store->GetVelocity(index));
+    _curState.SetAcceleration(store->GetAcceleration(index));
+    Vector2D pending(store->GetForce(index));
+    if(pending != Vector2D()) _curState.ApplyImpulse(pending);
+    _curState.SetActive(store->IsActive(index));
+}
+
+void RigidBody::CollectForces(double deltaTime) {
+    if(IsActive() && Math::IsEqual(GetMass(), 0.0) == false) {
+        _store->AddForce(_store_index, _curState.SumForces());
+        _curState.AgeForces(deltaTime);
+    } else {
+        _curState.ClearForces();
+    }
+    _store->SetForced(_store_index, _curState.HasForces());
+}
+
+void RigidBody::UpdateShapes() {
+    _curState.SetPosition(_store->GetPosition(_store_index));
+}
+
+void RigidBody::CopyKinematics(const RigidBody& other) {
+    SetPosition(other.GetPosition());
+    SetVelocity(other.GetVelocity());
+    SetAcceleration(other.GetAcceleration());
+    ClearImpulses();
+    if(other._store) {
+        Vector2D pending(other._store->GetForce(other._store_index));
+        if(pending != Vector2D()) ApplyImpulse(pending);
+    } else {
+        if(other._curState.HasImpulse()) ApplyImpulse(other._curState.GetImpulse());
+    }
+    if(other.IsActive()) {
+        Wake();
+    } else {
+        Sleep();
+    }
+}
 
-A2DE_END
\ No newline at end of file
+A2DE_END
@@ -22,6 +22,7 @@ A2DE_BEGIN
 
 class StopWatch;
 class Rectangle;
+class BodyStore;
 
 struct RigidBodyDef {
     RigidBodyDef() : mass(0.0),
@@ -33,7 +34,9 @@ struct RigidBodyDef {
                      velocity_y(0.0),
                      restitution(1.0),
                      static_friction(0.0),
-                     kinetic_friction(0.0) {
+                     kinetic_friction(0.0),
+                     bullet(false),
+                     sensor(false) {
         /* DO NOTHING */
     }
     double mass;
@@ -46,6 +49,8 @@ struct RigidBodyDef {
     double restitution;
     double static_friction;
     double kinetic_friction;
+    bool bullet;
+    bool sensor;
 };
 
 /**************************************************************************************************
@@ -543,7 +548,8 @@ public:
     void SetMass(double mass);
 
     /**************************************************************************************************
-     * <summary>Updates the physical properties of this object.</summary>
+     * <summary>Updates the physical properties of this object. Does nothing while the body is in a
+     * World; the World integrates it along with every other body.</summary>
      * <remarks>Casey Ugone, 8/3/2011.</remarks>
      * <param name="deltaTime">Current change in time.</param>
      **************************************************************************************************/
@@ -561,6 +567,13 @@ public:
      **************************************************************************************************/
     void ClearImpulses();
 
+    /**************************************************************************************************
+     * <summary>Gets the timed forces still acting.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The forces.</returns>
+     **************************************************************************************************/
+    const a2de::ForceBuffer& GetForces() const;
+
     /**************************************************************************************************
      * <summary>Sets the physics material.</summary>
      * <remarks>Casey Ugone, 9/3/2012.</remarks>
@@ -699,12 +712,90 @@ public:
     bool IsActive() const;
     bool IsActive();
 
+    /**************************************************************************************************
+     * <summary>Query if the body is a bullet. A bullet is swept from where it started the step to
+     * where it ended, so it cannot pass through thin bodies however fast it moves.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>true if a bullet, false if not.</returns>
+     **************************************************************************************************/
+    bool IsBullet() const;
+
+    /**************************************************************************************************
+     * <summary>Sets whether the body is a bullet.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="bullet">true to sweep the body every step.</param>
+     **************************************************************************************************/
+    void SetBullet(bool bullet);
+
+    /**************************************************************************************************
+     * <summary>Query if the body is a sensor. A sensor reports what overlaps its bounds but is never
+     * pushed and never pushes back.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <returns>true if a sensor, false if not.</returns>
+     **************************************************************************************************/
+    bool IsSensor() const;
+
+    /**************************************************************************************************
+     * <summary>Sets whether the body is a sensor.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="sensor">true to only report overlaps.</param>
+     **************************************************************************************************/
+    void SetSensor(bool sensor);
+
 protected:
 
 private:
+
+    /**************************************************************************************************
+     * <summary>Moves the kinematic data of the current State into a store slot. From then on the
+     * store owns it and this body only forwards to it.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="store">[in,out] The store.</param>
+     * <param name="index">The slot.</param>
+     **************************************************************************************************/
+    void Attach(a2de::BodyStore* store, std::size_t index);
+
+    /**************************************************************************************************
+     * <summary>Moves the kinematic data of the store slot back into the current State.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     **************************************************************************************************/
+    void Detach();
+
+    /**************************************************************************************************
+     * <summary>Folds the timed forces of the current State into the store's force accumulator and
+     * ages them. Called by the store right before it integrates.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void CollectForces(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Moves the current State, and with it the shapes, to the store's position. Called by the
+     * store after it integrates.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     **************************************************************************************************/
+    void UpdateShapes();
+
+    /**************************************************************************************************
+     * <summary>Copies the position, velocity, acceleration, pending impulses and sleep state of another
+     * body, wherever either body keeps them.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="other">The other body.</param>
+     **************************************************************************************************/
+    void CopyKinematics(const RigidBody& other);
+
     /// <summary> The current State </summary>
     State _curState;
-    State _prevState;
+    /// <summary> The store holding the kinematic data, null while not in a World </summary>
+    a2de::BodyStore* _store;
+    /// <summary> The slot in the store </summary>
+    std::size_t _store_index;
+    /// <summary> Whether the body is swept every step </summary>
+    bool _bullet;
+    /// <summary> Whether the body only reports overlaps </summary>
+    bool _sensor;
+
+    friend class BodyStore;
 
 };
 
@@ -8,7 +8,6 @@
 #include "CRigidBodyState.h"
 
 #include "../Math/MiscMath.h"
-#include <numeric>
 #include <algorithm>
 #include "../Math/CShape.h"
 #include <string>
@@ -37,14 +36,14 @@ A2DE_BEGIN
 const double State::DEFAULT_DAMPER_VALUE = 0.9999;
 
 State::State(double mass, const Vector2D& gravMod, const Vector2D& position, const Vector2D& velocity, double restitution, double static_friction, double kinetic_friction)
-     : _mass(mass), _gravMod(gravMod), _position(position), _velocity(velocity), _acceleration(0.0, 0.0), _forces(), _impulses(), _active(true), _mat(restitution, static_friction, kinetic_friction), _bounding_rectangle(nullptr), _collision_shape(nullptr), _density(), _damper(DEFAULT_DAMPER_VALUE) {
+     : _mass(mass), _gravMod(gravMod), _position(position), _velocity(velocity), _acceleration(0.0, 0.0), _forces(), _impulse_x(0.0), _impulse_y(0.0), _has_impulse(false), _active(true), _mat(restitution, static_friction, kinetic_friction), _bounding_rectangle(nullptr), _collision_shape(nullptr), _density(), _damper(DEFAULT_DAMPER_VALUE) {
     SetBoundingRectangle(_bounding_rectangle);
     SetCollisionShape(_collision_shape);
     _density = CalculateDensity();
 }
 
 State::State(const State& other)
-     : _mass(other._mass), _gravMod(other._gravMod), _position(other._position), _velocity(other._velocity), _acceleration(other._acceleration), _forces(other._forces), _impulses(other._impulses), _active(other._active), _mat(other._mat), _bounding_rectangle(nullptr), _collision_shape(nullptr), _density(), _damper(DEFAULT_DAMPER_VALUE) {
+     : _mass(other._mass), _gravMod(other._gravMod), _position(other._position), _velocity(other._velocity), _acceleration(other._acceleration), _forces(other._forces), _impulse_x(other._impulse_x), _impulse_y(other._impulse_y), _has_impulse(other._has_impulse), _active(other._active), _mat(other._mat), _bounding_rectangle(nullptr), _collision_shape(nullptr), _density(), _damper(DEFAULT_DAMPER_VALUE) {
     SetBoundingRectangle(other._bounding_rectangle);
     SetCollisionShape(other._collision_shape);
     _density = CalculateDensity();
@@ -59,7 +58,9 @@ State& State::operator=(const State& rhs) {
     this->_velocity = rhs._velocity;
     this->_acceleration = rhs._acceleration;
     this->_forces = rhs._forces;
-    this->_impulses = rhs._impulses;
+    this->_impulse_x = rhs._impulse_x;
+    this->_impulse_y = rhs._impulse_y;
+    this->_has_impulse = rhs._has_impulse;
     this->_active = rhs._active;
     this->_mat = rhs._mat;
 
@@ -151,7 +152,7 @@ void State::SetAcceleration(double x, double y) { SetAcceleration(Vector2D(x, y)
 void State::ApplyForce(const Vector2D& force, double duration) {
     if(duration < 0.0) return;
     Wake();
-    _forces.push_back(std::make_pair(force, duration));
+    _forces.Add(force, duration);
 }
 void State::ApplyForce(double x, double y, double duration) { ApplyForce(Vector2D(x, y), duration); }
 void State::ApplyXForce(double x, double duration) { ApplyForce(x, 0.0, duration); }
@@ -159,20 +160,46 @@ void State::ApplyYForce(double y, double duration) { ApplyForce(0.0, y, duration
 
 void State::ApplyImpulse(const Vector2D& impulse) {
     Wake();
-    _impulses.push_back(impulse);
+    _impulse_x += impulse.GetX();
+    _impulse_y += impulse.GetY();
+    _has_impulse = true;
 }
 void State::ApplyImpulse(double x, double y) { ApplyImpulse(Vector2D(x, y)); }
 void State::ApplyXImpulse(double x) { ApplyImpulse(x, 0.0); }
 void State::ApplyYImpulse(double y) { ApplyImpulse(0.0, y); }
 
 void State::ClearForces() {
-    if(_forces.empty()) return;
-    _forces.clear();
+    _forces.Clear();
 }
 
 void State::ClearImpulses() {
-    if(_impulses.empty()) return;
-    _impulses.clear();
+    _impulse_x = 0.0;
+    _impulse_y = 0.0;
+    _has_impulse = false;
+}
+
+a2de::Vector2D State::GetImpulse() const {
+    return a2de::Vector2D(_impulse_x, _impulse_y);
+}
+
+bool State::HasImpulse() const {
+    return _has_impulse;
+}
+
+a2de::Vector2D State::SumForces() const {
+    return _forces.Sum();
+}
+
+void State::AgeForces(double deltaTime) {
+    _forces.Age(deltaTime);
+}
+
+bool State::HasForces() const {
+    return _forces.IsEmpty() == false;
+}
+
+const State::ForceContainer& State::GetForces() const {
+    return _forces;
 }
 
 bool State::IsActive() const {
@@ -197,16 +224,9 @@ void State::Update(double deltaTime) {
         return;
     }
 
-    a2de::Vector2D total_forces;
-    std::for_each(_forces.begin(), _forces.end(), [&total_forces] (ForceContainer::value_type& current_force) mutable -> a2de::Vector2D 
-    {
-        if(current_force.second < 0.0) return Vector2D();
-        total_forces += current_force.first;
-        return total_forces;
-    });
+    a2de::Vector2D total_forces(SumForces());
 
-    Vector2D total_impulses = std::accumulate(_impulses.begin(), _impulses.end(), Vector2D());
-    Vector2D F(total_forces + total_impulses);
+    Vector2D F(total_forces + GetImpulse());
     ClearImpulses();
     double mass = GetMass();
 
@@ -229,12 +249,9 @@ void State::Update(double deltaTime) {
     SetVelocity(GetAcceleration() * deltaTime + GetVelocity());
     SetPosition(((0.5 * GetAcceleration()) * deltaTime * deltaTime) + (GetVelocity() * deltaTime) + GetPosition());
 
-    _forces.remove_if([=](ForceContainer::value_type& current_force)->bool {
-        current_force.second -= deltaTime;
-        return (current_force.second < 0.0);
-    });
+    AgeForces(deltaTime);
 
-    if(_impulses.empty() && _forces.empty() &&
+    if(HasImpulse() == false && HasForces() == false &&
       ((a2de::Math::IsEqual(_acceleration.GetX(), 0.0) && a2de::Math::IsEqual(_acceleration.GetY(), 0.0)) &&
       (a2de::Math::IsEqual(_velocity.GetX(), 0.0) && a2de::Math::IsEqual(_velocity.GetY(), 0.0))))
     {
@@ -11,7 +11,7 @@
 #include "../a2de_vals.h"
 #include "../Math/CVector2D.h"
 #include "IUpdatable.h"
-#include <list>
+#include "CForceBuffer.h"
 #include "../Math/CRectangle.h"
 
 A2DE_BEGIN
@@ -123,8 +123,7 @@ private:
 
 class State : public IUpdatable {
     
-    typedef std::list<std::pair<Vector2D, double> > ForceContainer;
-    typedef std::list<Vector2D> ImpulseContainer;
+    typedef a2de::ForceBuffer ForceContainer;
 
     /**************************************************************************************************
      * <summary>Constructor.</summary>
@@ -455,6 +454,48 @@ class State : public IUpdatable {
      **************************************************************************************************/
     void ClearImpulses();
 
+    /**************************************************************************************************
+     * <summary>Gets the sum of the impulses applied since the last update.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <returns>The pending impulse.</returns>
+     **************************************************************************************************/
+    Vector2D GetImpulse() const;
+
+    /**************************************************************************************************
+     * <summary>Query if any impulse was applied since the last update.</summary>
+     * <remarks>Casey Ugone, 8/12/2014.</remarks>
+     * <returns>true if an impulse is pending, false if not.</returns>
+     **************************************************************************************************/
+    bool HasImpulse() const;
+
+    /**************************************************************************************************
+     * <summary>Sums the timed forces still acting.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <returns>The total force.</returns>
+     **************************************************************************************************/
+    Vector2D SumForces() const;
+
+    /**************************************************************************************************
+     * <summary>Shortens the duration of every timed force and removes those that ran out.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void AgeForces(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Query if any timed force is still acting.</summary>
+     * <remarks>Casey Ugone, 8/11/2014.</remarks>
+     * <returns>true if forces remain, false if not.</returns>
+     **************************************************************************************************/
+    bool HasForces() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the timed forces still acting.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The forces.</returns>
+     **************************************************************************************************/
+    const ForceContainer& GetForces() const;
+
     /**************************************************************************************************
      * <summary>Applies the force described by force.</summary>
      * <remarks>Casey Ugone, 9/3/2012.</remarks>
@@ -727,8 +768,12 @@ class State : public IUpdatable {
     Vector2D _acceleration;
     /// <summary> The forces applied to a body.</summary>
     ForceContainer _forces;
-    /// <summary> The impulses applied to a body.</summary>
-    ImpulseContainer _impulses;
+    /// <summary> The x component of the impulses applied to a body since the last update.</summary>
+    double _impulse_x;
+    /// <summary> The y component of the impulses applied to a body since the last update.</summary>
+    double _impulse_y;
+    /// <summary> Whether an impulse was applied since the last update.</summary>
+    bool _has_impulse;
 
     /// <summary> The body is not asleep and can accept forces and collisions. </summary>
     bool _active;
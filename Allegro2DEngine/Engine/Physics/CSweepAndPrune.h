@@ -0,0 +1,669 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CSweepAndPrune.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the sweep and prune class
+ **************************************************************************************************/
+#ifndef A2DE_CSWEEPANDPRUNE_H
+#define A2DE_CSWEEPANDPRUNE_H
+
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <utility>
+
+#include "../a2de_vals.h"
+#include "../a2de_graphics.h"
+#include "../a2de_math.h"
+#include "IBroadPhase.h"
+
+A2DE_BEGIN
+
+class a2de::Shape;
+
+/**************************************************************************************************
+ * <summary>A sweep and prune broad phase. The minimum and maximum of every element's extents are kept
+ * in a sorted list per axis across frames. Lists are re-sorted with an insertion sort, which is close
+ * to linear when elements move a little each frame, and each swap adds or removes an overlapping pair
+ * so the pair set is maintained incrementally instead of being recomputed.</summary>
+ * <remarks>Casey Ugone, 7/26/2014.</remarks>
+ **************************************************************************************************/
+template<typename T>
+class SweepAndPrune : public IBroadPhase<T> {
+
+public:
+
+    /**************************************************************************************************
+     * <summary>Constructor.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="bounds">The bounds. Only used when drawing.</param>
+     **************************************************************************************************/
+    SweepAndPrune(const a2de::Rectangle& bounds);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     **************************************************************************************************/
+    ~SweepAndPrune();
+
+    /**************************************************************************************************
+     * <summary>Adds an element. Its overlaps are found the next time the axes are sorted.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elem">The const T& to add.</param>
+     * <returns>true if it succeeds, false if it fails or the element was already added.</returns>
+     **************************************************************************************************/
+    bool Add(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Adds an element. Its overlaps are found the next time the axes are sorted.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elem">The const T* to add.</param>
+     * <returns>true if it succeeds, false if it fails or the element was already added.</returns>
+     **************************************************************************************************/
+    bool Add(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Removes the given element and every pair it is part of.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elem">The const T& to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Remove(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Removes the given element and every pair it is part of.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elem">The const T* to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Remove(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Refits the given element and records its new extents. Endpoints are moved the next time
+     * the axes are sorted.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Update(const T& elem);
+
+    /**************************************************************************************************
+     * <summary>Refits the given element and records its new extents. Endpoints are moved the next time
+     * the axes are sorted.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elem">The element.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    bool Update(const T* elem);
+
+    /**************************************************************************************************
+     * <summary>Adds a range of elements.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elems">[in,out] The std::vector<T>& to add.</param>
+     **************************************************************************************************/
+    void Add(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Removes the given elements.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elems">[in,out] The std::vector<T>& to remove.</param>
+     **************************************************************************************************/
+    void Remove(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Updates the given elements.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="elems">[in,out] The elems.</param>
+     **************************************************************************************************/
+    void Update(std::vector<T>& elems);
+
+    /**************************************************************************************************
+     * <summary>Clears this object to its blank/initial state. Every current pair is recorded as
+     * removed.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    const a2de::Rectangle& GetBounds() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the bounds.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <returns>The bounds.</returns>
+     **************************************************************************************************/
+    a2de::Rectangle& GetBounds();
+
+    /**************************************************************************************************
+     * <summary>Gets the number of elements.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <returns>The total number of elements.</returns>
+     **************************************************************************************************/
+    unsigned long NumberOfElements();
+
+    /**************************************************************************************************
+     * <summary>Queries a given area. Each element is reported once.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="area">The area.</param>
+     * <returns>The elements whose extents overlap the extents of the area.</returns>
+     **************************************************************************************************/
+    std::vector<T> Query(const a2de::Shape& area);
+
+    /**************************************************************************************************
+     * <summary>Gets every pair of elements whose extents overlap. Each pair is reported once with the
+     * lesser element first.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="pairs">[in,out] The candidate pairs are appended here.</param>
+     **************************************************************************************************/
+    void QueryPairs(std::vector<std::pair<T, T> >& pairs);
+
+    /**************************************************************************************************
+     * <summary>Gets the pairs that began or stopped overlapping since the last call. A pair that began
+     * and stopped in between is not reported.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="added">  [in,out] The pairs that began overlapping are appended here.</param>
+     * <param name="removed">[in,out] The pairs that stopped overlapping are appended here.</param>
+     **************************************************************************************************/
+    void QueryPairDeltas(std::vector<std::pair<T, T> >& added, std::vector<std::pair<T, T> >& removed);
+
+    /**************************************************************************************************
+     * <summary>Gets all elements.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <returns>all elements.</returns>
+     **************************************************************************************************/
+    std::vector<T> GetAllElements();
+
+    /**************************************************************************************************
+     * <summary>Draws the bounds and the extents of every element.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     **************************************************************************************************/
+    void Draw(BITMAP* dest);
+
+protected:
+private:
+
+    /// <summary> The sorted axes </summary>
+    enum AXIS {
+        AXIS_X,
+        AXIS_Y,
+        AXIS_MAX,
+    };
+
+    /// <summary> One end of an element's extents along an axis </summary>
+    struct EndPoint {
+        /// <summary> The coordinate along the axis </summary>
+        double value;
+        /// <summary> The index of the owning proxy </summary>
+        std::size_t proxy;
+        /// <summary> true if this is the minimum, false if the maximum </summary>
+        bool is_min;
+    };
+
+    /// <summary> An element and the extents it was last added or updated with </summary>
+    struct Proxy {
+        /// <summary> The element </summary>
+        T elem;
+        /// <summary> The minimum along each axis </summary>
+        double min[AXIS_MAX];
+        /// <summary> The maximum along each axis </summary>
+        double max[AXIS_MAX];
+        /// <summary> true if the proxy holds an element, false if it is free </summary>
+        bool in_use;
+    };
+
+    typedef std::pair<T, T> ElementPair;
+
+    /**************************************************************************************************
+     * <summary>Gets the extents of a point.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="point">The point.</param>
+     * <param name="min">  [out] The top-left corner.</param>
+     * <param name="max">  [out] The bottom-right corner.</param>
+     **************************************************************************************************/
+    static void GetExtents(const a2de::Vector2D& point, a2de::Vector2D& min, a2de::Vector2D& max);
+
+    /**************************************************************************************************
+     * <summary>Gets the extents of a shape.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="shape">The shape.</param>
+     * <param name="min">  [out] The top-left corner.</param>
+     * <param name="max">  [out] The bottom-right corner.</param>
+     **************************************************************************************************/
+    static void GetExtents(const a2de::Shape& shape, a2de::Vector2D& min, a2de::Vector2D& max);
+
+    /**************************************************************************************************
+     * <summary>Copies the current extents of the proxy's element into the proxy.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="proxy">[in,out] The proxy.</param>
+     **************************************************************************************************/
+    static void SetExtents(Proxy& proxy);
+
+    /**************************************************************************************************
+     * <summary>Query if two proxies overlap on every axis.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="first"> The first proxy.</param>
+     * <param name="second">The second proxy.</param>
+     * <returns>true if they overlap, false if they do not.</returns>
+     **************************************************************************************************/
+    static bool Overlaps(const Proxy& first, const Proxy& second);
+
+    /**************************************************************************************************
+     * <summary>Makes the key a pair is stored under, the lesser element first.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="first"> The first element.</param>
+     * <param name="second">The second element.</param>
+     * <returns>The key.</returns>
+     **************************************************************************************************/
+    static ElementPair MakePair(const T& first, const T& second);
+
+    /**************************************************************************************************
+     * <summary>Sorts every axis if any element was added or updated since the last sort.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     **************************************************************************************************/
+    void SortAxes();
+
+    /**************************************************************************************************
+     * <summary>Refreshes the endpoint values of an axis and insertion sorts it, adding and removing
+     * pairs as endpoints pass each other.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="axis">The axis.</param>
+     **************************************************************************************************/
+    void SortAxis(std::size_t axis);
+
+    /**************************************************************************************************
+     * <summary>Records a pair as overlapping.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="pair">The pair.</param>
+     **************************************************************************************************/
+    void AddPair(const ElementPair& pair);
+
+    /**************************************************************************************************
+     * <summary>Records a pair as no longer overlapping.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="pair">The pair.</param>
+     **************************************************************************************************/
+    void RemovePair(const ElementPair& pair);
+
+    /// <summary> The proxies, indexed by the endpoints </summary>
+    std::vector<Proxy> _proxies;
+    /// <summary> The indices of unused proxies </summary>
+    std::vector<std::size_t> _free_proxies;
+    /// <summary> The proxy index of each element </summary>
+    std::map<T, std::size_t> _lookup;
+    /// <summary> The endpoints of each axis, sorted by value </summary>
+    std::vector<EndPoint> _endpoints[AXIS_MAX];
+    /// <summary> The overlapping pairs </summary>
+    std::set<ElementPair> _pairs;
+    /// <summary> Pairs added (+1) or removed (-1) since the last call to QueryPairDeltas </summary>
+    std::map<ElementPair, int> _pair_deltas;
+    /// <summary> true if the axes need sorting </summary>
+    bool _dirty;
+    /// <summary> The bounds </summary>
+    a2de::Rectangle _bounds;
+
+    //DO NOT COPY!
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    SweepAndPrune(const SweepAndPrune<T>& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator.</summary>
+     * <remarks>Casey Ugone, 7/26/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A shallow copy of this object.</returns>
+     **************************************************************************************************/
+    SweepAndPrune<T>& operator=(const SweepAndPrune<T>& rhs);
+
+};
+
+template<typename T>
+SweepAndPrune<T>::SweepAndPrune(const a2de::Rectangle& bounds) : _proxies(), _free_proxies(), _lookup(), _pairs(), _pair_deltas(), _dirty(false), _bounds(bounds) {
+    _bounds.SetFill(false);
+}
+
+template<typename T>
+SweepAndPrune<T>::~SweepAndPrune() {
+    _proxies.clear();
+    _lookup.clear();
+    _pairs.clear();
+    _pair_deltas.clear();
+}
+
+template<typename T>
+const a2de::Rectangle& SweepAndPrune<T>::GetBounds() const {
+    return _bounds;
+}
+
+template<typename T>
+a2de::Rectangle& SweepAndPrune<T>::GetBounds() {
+    return const_cast<a2de::Rectangle&>(static_cast<const SweepAndPrune<T>&>(*this).GetBounds());
+}
+
+template<typename T>
+void SweepAndPrune<T>::GetExtents(const a2de::Vector2D& point, a2de::Vector2D& min, a2de::Vector2D& max) {
+    min = point;
+    max = point;
+}
+
+template<typename T>
+void SweepAndPrune<T>::GetExtents(const a2de::Shape& shape, a2de::Vector2D& min, a2de::Vector2D& max) {
+    //Shape dimensions are half-extents about the position.
+    a2de::Vector2D half_extents(shape.GetWidth(), shape.GetHeight());
+    min = shape.GetPosition() - half_extents;
+    max = shape.GetPosition() + half_extents;
+}
+
+template<typename T>
+void SweepAndPrune<T>::SetExtents(Proxy& proxy) {
+    a2de::Vector2D min;
+    a2de::Vector2D max;
+    GetExtents(bounds_of(proxy.elem), min, max);
+    proxy.min[AXIS_X] = min.GetX();
+    proxy.min[AXIS_Y] = min.GetY();
+    proxy.max[AXIS_X] = max.GetX();
+    proxy.max[AXIS_Y] = max.GetY();
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Overlaps(const Proxy& first, const Proxy& second) {
+    for(std::size_t axis = 0; axis < AXIS_MAX; ++axis) {
+        if(first.max[axis] < second.min[axis] || second.max[axis] < first.min[axis]) return false;
+    }
+    return true;
+}
+
+template<typename T>
+typename SweepAndPrune<T>::ElementPair SweepAndPrune<T>::MakePair(const T& first, const T& second) {
+    if(second < first) return std::make_pair(second, first);
+    return std::make_pair(first, second);
+}
+
+template<typename T>
+void SweepAndPrune<T>::AddPair(const ElementPair& pair) {
+    if(_pairs.insert(pair).second == false) return;
+    //A pair removed and added again since the last query has not changed.
+    typename std::map<ElementPair, int>::iterator _iter = _pair_deltas.find(pair);
+    if(_iter != _pair_deltas.end()) {
+        _pair_deltas.erase(_iter);
+        return;
+    }
+    _pair_deltas.insert(std::make_pair(pair, 1));
+}
+
+template<typename T>
+void SweepAndPrune<T>::RemovePair(const ElementPair& pair) {
+    if(_pairs.erase(pair) == 0) return;
+    typename std::map<ElementPair, int>::iterator _iter = _pair_deltas.find(pair);
+    if(_iter != _pair_deltas.end()) {
+        _pair_deltas.erase(_iter);
+        return;
+    }
+    _pair_deltas.insert(std::make_pair(pair, -1));
+}
+
+template<typename T>
+void SweepAndPrune<T>::SortAxes() {
+    if(_dirty == false) return;
+    for(std::size_t axis = 0; axis < AXIS_MAX; ++axis) {
+        SortAxis(axis);
+    }
+    _dirty = false;
+}
+
+template<typename T>
+void SweepAndPrune<T>::SortAxis(std::size_t axis) {
+    std::vector<EndPoint>& endpoints = _endpoints[axis];
+    std::size_t s = endpoints.size();
+
+    for(std::size_t i = 0; i < s; ++i) {
+        const Proxy& proxy = _proxies[endpoints[i].proxy];
+        endpoints[i].value = endpoints[i].is_min ? proxy.min[axis] : proxy.max[axis];
+    }
+
+    //Overlap is tested against the extents every proxy will have once all axes are sorted,
+    //so the pair set is correct no matter which axis detects the change.
+    for(std::size_t i = 1; i < s; ++i) {
+        EndPoint key = endpoints[i];
+        std::size_t j = i;
+        while(j > 0 && key.value < endpoints[j - 1].value) {
+            const EndPoint& passed = endpoints[j - 1];
+            const Proxy& key_proxy = _proxies[key.proxy];
+            const Proxy& passed_proxy = _proxies[passed.proxy];
+            if(key.is_min && passed.is_min == false) {
+                //key's extents now start before passed's end.
+                if(Overlaps(key_proxy, passed_proxy)) {
+                    AddPair(MakePair(key_proxy.elem, passed_proxy.elem));
+                }
+            } else if(key.is_min == false && passed.is_min) {
+                //key's extents now end before passed's start.
+                RemovePair(MakePair(key_proxy.elem, passed_proxy.elem));
+            }
+            endpoints[j] = endpoints[j - 1];
+            --j;
+        }
+        endpoints[j] = key;
+    }
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Add(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    if(_lookup.find(elem) != _lookup.end()) return false;
+
+    std::size_t index = 0;
+    if(_free_proxies.empty()) {
+        index = _proxies.size();
+        _proxies.push_back(Proxy());
+    } else {
+        index = _free_proxies.back();
+        _free_proxies.pop_back();
+    }
+
+    Proxy& proxy = _proxies[index];
+    proxy.elem = elem;
+    proxy.in_use = true;
+    SetExtents(proxy);
+    _lookup.insert(std::make_pair(elem, index));
+
+    //New endpoints start at the end of each axis and are swept into place on the next sort.
+    for(std::size_t axis = 0; axis < AXIS_MAX; ++axis) {
+        EndPoint min_point = { proxy.min[axis], index, true };
+        EndPoint max_point = { proxy.max[axis], index, false };
+        _endpoints[axis].push_back(min_point);
+        _endpoints[axis].push_back(max_point);
+    }
+    _dirty = true;
+    return true;
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Add(const T* elem) {
+    return Add(*elem);
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Remove(const T& elem) {
+
+    if(ptr(elem) == nullptr) return false;
+    typename std::map<T, std::size_t>::iterator _lookup_iter = _lookup.find(elem);
+    if(_lookup_iter == _lookup.end()) return false;
+    std::size_t index = _lookup_iter->second;
+    _lookup.erase(_lookup_iter);
+
+    std::vector<ElementPair> stale_pairs;
+    for(typename std::set<ElementPair>::iterator _iter = _pairs.begin(); _iter != _pairs.end(); ++_iter) {
+        if(_iter->first == elem || _iter->second == elem) {
+            stale_pairs.push_back(*_iter);
+        }
+    }
+    for(typename std::vector<ElementPair>::iterator _iter = stale_pairs.begin(); _iter != stale_pairs.end(); ++_iter) {
+        RemovePair(*_iter);
+    }
+
+    for(std::size_t axis = 0; axis < AXIS_MAX; ++axis) {
+        std::vector<EndPoint>& endpoints = _endpoints[axis];
+        std::size_t s = endpoints.size();
+        std::size_t kept = 0;
+        //Removing keeps the remaining endpoints in sorted order.
+        for(std::size_t i = 0; i < s; ++i) {
+            if(endpoints[i].proxy == index) continue;
+            endpoints[kept++] = endpoints[i];
+        }
+        endpoints.resize(kept);
+    }
+
+    _proxies[index].in_use = false;
+    _free_proxies.push_back(index);
+    return true;
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Remove(const T* elem) {
+    return Remove(*elem);
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Update(const T& elem) {
+    if(ptr(elem) == nullptr) return false;
+    typename std::map<T, std::size_t>::iterator _iter = _lookup.find(elem);
+    if(_iter == _lookup.end()) return false;
+    refit(elem);
+    SetExtents(_proxies[_iter->second]);
+    _dirty = true;
+    return true;
+}
+
+template<typename T>
+bool SweepAndPrune<T>::Update(const T* elem) {
+    return Update(*elem);
+}
+
+template<typename T>
+void SweepAndPrune<T>::Add(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Add(*_iter);
+    }
+}
+
+template<typename T>
+void SweepAndPrune<T>::Remove(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Remove(*_iter);
+    }
+}
+
+template<typename T>
+void SweepAndPrune<T>::Update(std::vector<T>& elems) {
+    for(typename std::vector<T>::iterator _iter = elems.begin(); _iter != elems.end(); ++_iter) {
+        this->Update(*_iter);
+    }
+}
+
+template<typename T>
+void SweepAndPrune<T>::Clear() {
+    std::vector<ElementPair> stale_pairs(_pairs.begin(), _pairs.end());
+    for(typename std::vector<ElementPair>::iterator _iter = stale_pairs.begin(); _iter != stale_pairs.end(); ++_iter) {
+        RemovePair(*_iter);
+    }
+    _proxies.clear();
+    _free_proxies.clear();
+    _lookup.clear();
+    for(std::size_t axis = 0; axis < AXIS_MAX; ++axis) {
+        _endpoints[axis].clear();
+    }
+    _dirty = false;
+}
+
+template<typename T>
+unsigned long SweepAndPrune<T>::NumberOfElements() {
+    return _lookup.size();
+}
+
+template<typename T>
+std::vector<T> SweepAndPrune<T>::Query(const a2de::Shape& area) {
+    SortAxes();
+
+    std::vector<T> selected_elements;
+
+    a2de::Vector2D area_min;
+    a2de::Vector2D area_max;
+    GetExtents(area, area_min, area_max);
+
+    Proxy area_proxy;
+    area_proxy.min[AXIS_X] = area_min.GetX();
+    area_proxy.min[AXIS_Y] = area_min.GetY();
+    area_proxy.max[AXIS_X] = area_max.GetX();
+    area_proxy.max[AXIS_Y] = area_max.GetY();
+
+    //Every element starting past the right side of the area is sorted after it.
+    std::vector<EndPoint>& endpoints = _endpoints[AXIS_X];
+    for(typename std::vector<EndPoint>::iterator _iter = endpoints.begin(); _iter != endpoints.end(); ++_iter) {
+        if(area_max.GetX() < _iter->value) break;
+        if(_iter->is_min == false) continue;
+        const Proxy& proxy = _proxies[_iter->proxy];
+        if(Overlaps(proxy, area_proxy) == false) continue;
+        selected_elements.push_back(proxy.elem);
+    }
+    return selected_elements;
+}
+
+template<typename T>
+void SweepAndPrune<T>::QueryPairs(std::vector<std::pair<T, T> >& pairs) {
+    SortAxes();
+    pairs.insert(pairs.end(), _pairs.begin(), _pairs.end());
+}
+
+template<typename T>
+void SweepAndPrune<T>::QueryPairDeltas(std::vector<std::pair<T, T> >& added, std::vector<std::pair<T, T> >& removed) {
+    SortAxes();
+    for(typename std::map<ElementPair, int>::iterator _iter = _pair_deltas.begin(); _iter != _pair_deltas.end(); ++_iter) {
+        if(_iter->second > 0) {
+            added.push_back(_iter->first);
+        } else {
+            removed.push_back(_iter->first);
+        }
+    }
+    _pair_deltas.clear();
+}
+
+template<typename T>
+std::vector<T> SweepAndPrune<T>::GetAllElements() {
+    std::vector<T> total_elements;
+    total_elements.reserve(_lookup.size());
+    for(typename std::vector<Proxy>::iterator _iter = _proxies.begin(); _iter != _proxies.end(); ++_iter) {
+        if(_iter->in_use == false) continue;
+        total_elements.push_back(_iter->elem);
+    }
+    return total_elements;
+}
+
+template<typename T>
+void SweepAndPrune<T>::Draw(BITMAP* dest) {
+    if(dest == nullptr) return;
+
+    a2de::Color color = _bounds.GetColor();
+    for(typename std::vector<Proxy>::iterator _iter = _proxies.begin(); _iter != _proxies.end(); ++_iter) {
+        if(_iter->in_use == false) continue;
+        double half_width = (_iter->max[AXIS_X] - _iter->min[AXIS_X]) / 2.0;
+        double half_height = (_iter->max[AXIS_Y] - _iter->min[AXIS_Y]) / 2.0;
+        a2de::Rectangle extents(_iter->min[AXIS_X] + half_width, _iter->min[AXIS_Y] + half_height, half_width, half_height, color, false);
+        extents.Draw(dest, color, false);
+    }
+    _bounds.Draw(dest, color, false);
+}
+
+A2DE_END
+
+#endif
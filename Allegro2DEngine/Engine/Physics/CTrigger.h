@@ -15,15 +15,41 @@
 #include "../Objects/ADTObject.h"
 #include "CRigidBody.h"
 #include "IUpdatable.h"
-
-#include <list>
-#include <algorithm>
-#include <iterator>
+#include "ISensor.h"
 
 A2DE_BEGIN
 
+/**************************************************************************************************
+ * <summary>Turns the object a sensor reports into what a trigger tracks. A trigger of objects
+ * gets the object itself.</summary>
+ * <remarks>Casey Ugone, 8/21/2014.</remarks>
+ **************************************************************************************************/
 template<class T>
-class Trigger : public Object {
+struct TriggerTarget {
+    static T From(a2de::Object* object) {
+        return object;
+    }
+};
+
+/**************************************************************************************************
+ * <summary>A trigger of bodies gets the body of the object.</summary>
+ * <remarks>Casey Ugone, 8/21/2014.</remarks>
+ **************************************************************************************************/
+template<>
+struct TriggerTarget<a2de::RigidBody*> {
+    static a2de::RigidBody* From(a2de::Object* object) {
+        return object ? object->GetBody() : nullptr;
+    }
+};
+
+/**************************************************************************************************
+ * <summary>An area that reacts to what enters, stays in and leaves it. The area is a sensor body:
+ * once the trigger is added to a World, the world finds what overlaps it in its broad phase and
+ * calls OnEnter, OnTick and OnExit from its contact cache.</summary>
+ * <remarks>Casey Ugone, 5/20/2013.</remarks>
+ **************************************************************************************************/
+template<class T>
+class Trigger : public Object, public ISensor {
 public:
 
     /**************************************************************************************************
@@ -146,7 +172,7 @@ public:
     a2de::Vector2D& GetExtents();
 
     /**************************************************************************************************
-     * <summary>Updates the trigger and all objects.</summary>
+     * <summary>Updates the trigger. What overlaps it is reported by the World it was added to.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
      * <param name="deltaTime">Time since the last frame.</param>
      **************************************************************************************************/
@@ -174,19 +200,25 @@ public:
     virtual void OnTick(T object)=0;
 
     /**************************************************************************************************
-     * <summary>Registers the object described by object.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Calls OnEnter with what began to overlap the area.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
      * <param name="object">The object.</param>
-     * <returns>true if it succeeds, false if it fails.</returns>
      **************************************************************************************************/
-    bool RegisterObject(T object);
+    virtual void BeginOverlap(a2de::Object* object);
 
     /**************************************************************************************************
-     * <summary>Unregisters the object described by object.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
+     * <summary>Calls OnTick with what still overlaps the area.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
      * <param name="object">The object.</param>
      **************************************************************************************************/
-    void UnregisterObject(T object);
+    virtual void PersistOverlap(a2de::Object* object);
+
+    /**************************************************************************************************
+     * <summary>Calls OnExit with what no longer overlaps the area.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="object">The object.</param>
+     **************************************************************************************************/
+    virtual void EndOverlap(a2de::Object* object);
 
     /**************************************************************************************************
      * <summary>Gets the body.</summary>
@@ -205,26 +237,22 @@ public:
 protected:
     /// <summary> The area </summary>
     a2de::RigidBody* _area;
-    /// <summary> The previous objects </summary>
-    std::list<T> _previous_objects;
-    /// <summary> The current objects </summary>
-    std::list<T> _current_objects;
-    /// <summary> The temp objects </summary>
-    std::list<T> _temp_objects;
 private:
 
 };
 
 template<class T>
-Trigger<T>::Trigger() : _area(nullptr), _previous_objects(), _current_objects(), _temp_objects() {
+Trigger<T>::Trigger() : _area(nullptr) {
     _area = new a2de::RigidBody(0.0, 0.0, 0.0, 1.0, 0.0, 0.0);
+    _area->SetSensor(true);
     _area->SetBoundingRectangle(new a2de::AABB(a2de::Transform(), a2de::Vector2D(), a2de::Color::YELLOW()));
 }
 
 template<class T>
-Trigger<T>::Trigger(const Trigger& other) : _area(nullptr), _previous_objects(other._previous_objects), _current_objects(other._current_objects), _temp_objects(other._temp_objects)  {
+Trigger<T>::Trigger(const Trigger& other) : _area(nullptr) {
     
     this->_area = new a2de::RigidBody(other.GetBody()->GetMass(), other.GetBody()->GetGravityModifier(), a2de::PhysicsMaterial(other.GetBody()->GetRestitution(), other.GetBody()->GetStaticFriction(), other.GetBody()->GetKineticFriction()));
+    this->_area->SetSensor(true);
     this->_area->SetPosition(other.GetPosition());
     this->_area->SetBoundingRectangle(new AABB(other.GetPosition(), other.GetDimensions(), a2de::Color::YELLOW()));
 
@@ -234,9 +262,6 @@ Trigger<T>::Trigger(const Trigger& other) : _area(nullptr), _previous_objects(ot
 template<class T>
 Trigger<T>::~Trigger() {
     delete _area;
-    _previous_objects.clear();
-    _current_objects.clear();
-    _temp_objects.clear();
 }
 
 template<class T>
@@ -246,9 +271,7 @@ Trigger<T>& Trigger<T>::operator=(const Trigger<T>& rhs) {
     delete _area;
     _area = nullptr;
     this->_area = new a2de::RigidBody(rhs.GetBody()->GetMass(), rhs.GetBody()->GetGravityModifier(), a2de::PhysicsMaterial(rhs.GetBody()->GetRestitution(), rhs.GetBody()->GetStaticFriction()), a2de::Shape::Clone(rhs.GetBody()->GetBoundingRectangle()));
-    this->_previous_objects = rhs._previous_objects;
-    this->_current_objects = rhs._current_objects;
-    this->_temp_objects = rhs._temp_objects;
+    this->_area->SetSensor(true);
 
     IBoundingBox* bb = nullptr;
     IBoundingBox* rbb = rhs.GetBody()->GetBoundingRectangle();
@@ -265,42 +288,7 @@ Trigger<T>& Trigger<T>::operator=(const Trigger<T>& rhs) {
 
 template<class T>
 void Trigger<T>::Update(double /*deltaTime*/) {
-
-    _previous_objects = _current_objects;
-
-    _temp_objects.sort();
-    _current_objects.sort();
-
-    std::set_difference(_temp_objects.begin(), _temp_objects.end(), _current_objects.begin(), _current_objects.end(), std::back_inserter(_current_objects));
-    _temp_objects.clear();
-
-    _previous_objects.sort();
-    _current_objects.sort();
-
-    std::list<T> just_entered;
-    std::set_difference(_current_objects.begin(), _current_objects.end(), _previous_objects.begin(), _previous_objects.end(), std::back_inserter(just_entered));
-
-    std::list<T> still_in;
-    std::set_intersection(_previous_objects.begin(), _previous_objects.end(), _current_objects.begin(), _current_objects.end(), std::back_inserter(still_in));
-
-    std::list<T> just_exited;
-    std::set_difference(_previous_objects.begin(), _previous_objects.end(), _current_objects.begin(), _current_objects.end(), std::back_inserter(just_exited));
-
-    std::for_each(just_entered.begin(), just_entered.end(), [this](T elem)
-    {
-        this->OnEnter(elem);
-    });
-
-    std::for_each(still_in.begin(), still_in.end(), [this](T elem)
-    {
-        this->OnTick(elem);
-    });
-
-    std::for_each(just_exited.begin(), just_exited.end(), [this](T elem)
-    {
-        this->OnExit(elem);
-    });
-
+    /* DO NOTHING */
 }
 
 template<class T>
@@ -369,13 +357,13 @@ a2de::Vector2D& Trigger<T>::GetExtents() {
 }
 
 template<class T>
-void Trigger<T>::OnEnter(T entered_object) {
-    RegisterObject(entered_object);
+void Trigger<T>::OnEnter(T /*entered_object*/) {
+    /* DO NOTHING */
 }
 
 template<class T>
-void Trigger<T>::OnExit(T exited_object) {
-    UnregisterObject(exited_object);
+void Trigger<T>::OnExit(T /*exited_object*/) {
+    /* DO NOTHING */
 }
 
 template<class T>
@@ -384,18 +372,18 @@ void Trigger<T>::OnTick(T /*object*/) {
 }
 
 template<class T>
-bool Trigger<T>::RegisterObject(T object) {
-    std::list<T>::iterator _iter = std::find(_temp_objects.begin(), _temp_objects.end(), object);
-    if(_iter != _temp_objects.end()) return false;
-    _temp_objects.push_back(object);
-    return true;
+void Trigger<T>::BeginOverlap(a2de::Object* object) {
+    this->OnEnter(TriggerTarget<T>::From(object));
+}
+
+template<class T>
+void Trigger<T>::PersistOverlap(a2de::Object* object) {
+    this->OnTick(TriggerTarget<T>::From(object));
 }
 
 template<class T>
-void Trigger<T>::UnregisterObject(T object) {
-    std::list<T>::iterator _iter = std::find(_temp_objects.begin(), _temp_objects.end(), object);
-    if(_iter == _temp_objects.end()) return;
-    _temp_objects.erase(_iter);
+void Trigger<T>::EndOverlap(a2de::Object* object) {
+    this->OnExit(TriggerTarget<T>::From(object));
 }
 
 template<class T>
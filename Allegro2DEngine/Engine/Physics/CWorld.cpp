@@ -22,7 +22,8 @@
 #include "../Objects/ADTObject.h"
 #include "CRigidBody.h"
 #include "CContactPair.h"
-#include "CContactData.h"
+#include "../Math/GJK.h"
+#include "../Math/CPoint.h"
 
 #include "../Physics/IBoundingBox.h"
 
@@ -31,9 +32,32 @@
 #include <set>
 #include <cmath>
 
+#if defined(_MSC_VER) && (_MSC_VER >= 1600)
+#  include <ppl.h>
+#  define A2DE_PARALLEL_PPL
+#elif __cplusplus >= 201103L
+#  include <thread>
+#  define A2DE_PARALLEL_THREADS
+#endif
+
 A2DE_BEGIN
 
-World::World(const a2de::WorldDef& world_definition) throw(...) : _dimensions(Vector2D(world_definition.width, world_definition.height)), _cameras(MapCams()), _objects(Objects()), _buffer(nullptr), _gh(nullptr), _dh(nullptr), _grid() {
+const std::size_t World::PARALLEL_CONTACT_THRESHOLD = 64;
+const std::size_t World::CONTACT_BLOCK_SIZE = 32;
+const std::size_t World::PARALLEL_BODY_THRESHOLD = 1024;
+const std::size_t World::BODY_BLOCK_SIZE = 256;
+const double World::BULLET_SEPARATION = 0.01;
+
+World::World(const a2de::WorldDef& world_definition) throw(...) : _dimensions(Vector2D(world_definition.width, world_definition.height)), _cameras(MapCams()), _objects(Objects()), _buffer(nullptr), _gh(nullptr), _dh(nullptr), _world_forces(world_definition.world_forces), _gravity_revision(0), _drag_revision(0), _subscriptions_dirty(true), _handles(), _free_handles(), _bodies(), _grid(), _candidates(), _bullet_starts(), _contacts(), _contact_listener(nullptr), _sensors(), _sensor_count(0), _allow_sleeping(world_definition.allow_sleeping), _sleep_energy(world_definition.sleep_energy), _time_to_sleep(world_definition.time_to_sleep), _islands(), _island_sleep_times(), _active_contacts(), _solver(), _dispatcher(), _fixed_time_step(0.0), _substeps(1), _max_steps(1), _accumulator(0.0), _interpolation_alpha(1.0), _previous_positions(), _render_positions() {
+    _solver.SetVelocityIterations(world_definition.velocity_iterations);
+    _solver.SetPositionIterations(world_definition.position_iterations);
+    _solver.SetPositionCorrection(world_definition.position_correction);
+    _solver.SetPenetrationSlop(world_definition.penetration_slop);
+    _solver.SetWarmStarting(world_definition.warm_starting);
+    SetFixedTimeStep(world_definition.fixed_time_step);
+    SetSubsteps(world_definition.substeps);
+    SetMaxSteps(world_definition.max_steps);
+
     a2de::Math::SetWorldScale(world_definition.scale);
     double screen_x = a2de::Math::ToScreenScale(_dimensions.GetX());
     double screen_y = a2de::Math::ToScreenScale(_dimensions.GetY());
@@ -59,7 +83,25 @@ World::World(const a2de::WorldDef& world_definition) throw(...) : _dimensions(Ve
             _dh = new DragForceGenerator(world_definition.drag_k1, world_definition.drag_k2);
         }
         Vector2D dims(world_definition.width, world_definition.height);
-        _grid = new QuadTree<a2de::Vector2D>(a2de::Rectangle(dims / 2.0, dims, a2de::Color::GREEN(), false));
+        a2de::Rectangle bounds(dims / 2.0, dims, a2de::Color::GREEN(), false);
+        switch(world_definition.broadphase) {
+            case WorldDef::BROADPHASE_GRID:
+                _grid = new Grid<a2de::BodyHandle*>(bounds, world_definition.grid_cell_size);
+                break;
+            case WorldDef::BROADPHASE_SWEEP_AND_PRUNE:
+                _grid = new SweepAndPrune<a2de::BodyHandle*>(bounds);
+                break;
+            case WorldDef::BROADPHASE_DYNAMIC_TREE:
+                _grid = new DynamicTree<a2de::BodyHandle*>(bounds);
+                break;
+            case WorldDef::BROADPHASE_LOOSE_QUADTREE:
+                _grid = new LooseQuadTree<a2de::BodyHandle*>(bounds);
+                break;
+            case WorldDef::BROADPHASE_QUADTREE:
+            default:
+                _grid = new QuadTree<a2de::BodyHandle*>(bounds);
+                break;
+        }
 
     } catch(...) {
         DeallocateWorld();
@@ -118,7 +160,24 @@ bool World::AddObject(Object* obj) {
 
     if(this->_gh) this->_gh->RegisterBody(obj);
     if(this->_dh) this->_dh->RegisterBody(obj);
-    if(obj->GetBody()) this->_grid->Add(obj->GetBody()->GetPosition());
+    if(obj->GetBody()) {
+        unsigned long id = _handles.size();
+        if(_free_handles.empty() == false) {
+            id = _free_handles.back();
+            _free_handles.pop_back();
+        } else {
+            _handles.push_back(nullptr);
+        }
+        _bodies.Attach(id, obj->GetBody());
+        _subscriptions_dirty = true;
+        _handles[id] = new BodyHandle(id, obj);
+        this->_grid->Add(_handles[id]);
+        if(id >= _sensors.size()) _sensors.resize(id + 1, nullptr);
+        _sensors[id] = dynamic_cast<a2de::ISensor*>(obj);
+        if(_sensors[id]) ++_sensor_count;
+        //A reused id must not interpolate from where its last body was.
+        if(id < _previous_positions.size()) _previous_positions[id] = obj->GetBody()->GetPosition();
+    }
 
     this->_objects.insert(obj);
     return true;
@@ -135,12 +194,44 @@ bool World::RemoveObject(Object* obj) {
         _objects.erase(_iter);
         if(_gh) _gh->UnregisterBody(obj);
         if(_dh) _dh->UnregisterBody(obj);
-        _grid->Remove(obj->GetBody()->GetPosition());
+        BodyHandle* handle = GetHandle(obj);
+        if(handle) {
+            unsigned long id = handle->GetId();
+            //Whatever rested on the body can fall now, and the listener and any sensor it overlapped see the
+            //contact end.
+            const a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+            for(a2de::ContactCache::ContactsConstIter _contact = contacts.begin(); _contact != contacts.end(); ++_contact) {
+                if(_contact->first_id != id && _contact->second_id != id) continue;
+                if(_contact->state != a2de::Contact::STATE_END) DispatchContactEvent(*_contact, a2de::Contact::STATE_END);
+                a2de::BodyHandle* other = (_contact->first_id == id ? _contact->second : _contact->first);
+                if(other->GetBody() == nullptr || IsStaticBody(other->GetBody())) continue;
+                other->GetBody()->Wake();
+                other->SetSleepTime(0.0);
+            }
+            _contacts.Remove(handle);
+            _grid->Remove(handle);
+            _bodies.Detach(id);
+            if(_sensors[id]) --_sensor_count;
+            _sensors[id] = nullptr;
+            delete handle;
+            _handles[id] = nullptr;
+            _free_handles.push_back(id);
+        }
         return true;
     }
     return false;
 }
 
+a2de::BodyHandle* World::GetHandle(Object* obj) {
+    if(obj == nullptr) return nullptr;
+    std::vector<BodyHandle*>::iterator _iter = std::find_if(_handles.begin(), _handles.end(), [obj](BodyHandle* elem)->bool
+    {
+        return elem && elem->GetObject() == obj;
+    });
+    if(_iter == _handles.end()) return nullptr;
+    return *_iter;
+}
+
 double World::GetWidth() const {
     return _dimensions.GetX();
 }
@@ -239,12 +330,14 @@ void World::SetGravity(const Vector2D& gravity) {
     if(a2de::Math::IsEqual(gravity.GetX(), 0.0) && a2de::Math::IsEqual(gravity.GetY(), 0.0)) {
         delete _gh;
         _gh = nullptr;
+        _subscriptions_dirty = true;
         return;
     }
 
     if(_gh == nullptr) {
         if(a2de::Math::IsEqual(gravity.GetX(), 0.0) == false || a2de::Math::IsEqual(gravity.GetY(), 0.0) == false) {
             _gh = new GravityForceGenerator(gravity);
+            _subscriptions_dirty = true;
         }
     }
     if(_gh) _gh->SetGravity(gravity);
@@ -258,12 +351,14 @@ void World::SetDragCoefficients(const Vector2D& k1k2) {
     if(a2de::Math::IsEqual(k1k2.GetX(), 0.0) && a2de::Math::IsEqual(k1k2.GetY(), 0.0)) {
         delete _dh;
         _dh = nullptr;
+        _subscriptions_dirty = true;
         return;
     }
 
     if(_dh == nullptr) {
         if(a2de::Math::IsEqual(k1k2.GetX(), 0.0) == false || a2de::Math::IsEqual(k1k2.GetY(), 0.0) == false) {
             _dh = new DragForceGenerator();
+            _subscriptions_dirty = true;
         }
     }
     if(_dh) _dh->SetK1(k1k2.GetX());
@@ -275,8 +370,64 @@ const DragForceGenerator* World::GetDragHandler() const {
 }
 
 void World::Update(double deltaTime) {
-    UpdateObjectsInWorld(deltaTime);
-    ResolveCollisions(deltaTime);
+    if(_fixed_time_step <= 0.0) {
+        _interpolation_alpha = 1.0;
+        Step(deltaTime);
+        return;
+    }
+
+    _accumulator += deltaTime;
+    std::size_t steps = 0;
+    while(_accumulator >= _fixed_time_step && steps < _max_steps) {
+        SavePreviousPositions();
+        Step(_fixed_time_step);
+        _accumulator -= _fixed_time_step;
+        ++steps;
+    }
+    //Past the clamp the world falls behind rather than trying to catch up next frame.
+    if(_accumulator >= _fixed_time_step) _accumulator = std::fmod(_accumulator, _fixed_time_step);
+    _interpolation_alpha = _accumulator / _fixed_time_step;
+}
+
+void World::Step(double deltaTime) {
+    double substep = deltaTime / _substeps;
+    for(std::size_t i = 0; i < _substeps; ++i) {
+        UpdateObjectsInWorld(substep);
+        ResolveCollisions(substep);
+    }
+}
+
+void World::SavePreviousPositions() {
+    _previous_positions.resize(_handles.size());
+    for(std::size_t i = 0; i < _handles.size(); ++i) {
+        if(_handles[i] == nullptr || _handles[i]->GetBody() == nullptr) continue;
+        _previous_positions[i] = _handles[i]->GetBody()->GetPosition();
+    }
+}
+
+void World::BeginInterpolatedPoses() {
+    _render_positions.clear();
+    if(_fixed_time_step <= 0.0) return;
+    std::size_t count = std::min(_handles.size(), _previous_positions.size());
+    for(std::size_t i = 0; i < count; ++i) {
+        if(_handles[i] == nullptr) continue;
+        a2de::RigidBody* body = _handles[i]->GetBody();
+        if(body == nullptr || IsAwakeBody(body) == false) continue;
+        a2de::Vector2D current(body->GetPosition());
+        const a2de::Vector2D& previous = _previous_positions[i];
+        if(current == previous) continue;
+        _render_positions.push_back(std::make_pair(static_cast<unsigned long>(i), current));
+        double x = previous.GetX() + (current.GetX() - previous.GetX()) * _interpolation_alpha;
+        double y = previous.GetY() + (current.GetY() - previous.GetY()) * _interpolation_alpha;
+        body->SetPosition(x, y);
+    }
+}
+
+void World::EndInterpolatedPoses() {
+    for(std::vector<std::pair<unsigned long, a2de::Vector2D> >::iterator _iter = _render_positions.begin(); _iter != _render_positions.end(); ++_iter) {
+        _handles[_iter->first]->GetBody()->SetPosition(_iter->second);
+    }
+    _render_positions.clear();
 }
 
 void World::ClearVisibleScene(const Camera& cam) {
@@ -293,10 +444,12 @@ void World::ClearVisibleScene(const Camera& cam, const Color& color) {
 
 void World::Render() {
     if(_objects.empty()) return;
+    BeginInterpolatedPoses();
     std::for_each(_objects.begin(), _objects.end(), [this](a2de::Object* elem)
     {
         this->RenderObject(elem);
     });
+    EndInterpolatedPoses();
 }
 
 void World::RenderObject(Sprite* sprite) {
@@ -409,475 +562,880 @@ void World::RenderObject(IBoundingBox* bounding_box) {
 }
 
 void World::DrawGrid() {
-    _grid->Draw(_buffer, true);
+    _grid->Draw(_buffer);
 }
 
 void World::UpdateObjectsInWorld(double deltaTime) {
-    if(_gh) _gh->Update(deltaTime);
-    if(_dh) _dh->Update(deltaTime);
+    //Batched world forces run with the integration so each block of slots is walked while it is in cache.
+    if(_world_forces == WorldDef::WORLDFORCES_PER_SUBSCRIBER) {
+        if(_gh) _gh->Update(deltaTime);
+        if(_dh) _dh->Update(deltaTime);
+    }
 
     if(_objects.empty()) return;
+
+    //An object may have replaced its body since it was added; the new one takes over the slot.
+    for(std::size_t i = 0; i < _handles.size(); ++i) {
+        if(_handles[i] == nullptr) continue;
+        a2de::RigidBody* body = _handles[i]->GetBody();
+        if(body == nullptr || body == _bodies.GetBody(i)) continue;
+        _bodies.Attach(i, body);
+        _subscriptions_dirty = true;
+    }
+    if(_world_forces != WorldDef::WORLDFORCES_PER_SUBSCRIBER) UpdateSubscriptions();
+
+    //Game logic first so the forces it applies count this frame, then move every body at once.
     std::for_each(_objects.begin(), _objects.end(),  [deltaTime](Object* elem)
     {
         elem->Update(deltaTime);
     });
 
+    BeginBulletSweeps();
+    IntegrateBodies(deltaTime);
+
+}
+
+void World::IntegrateBodies(double deltaTime) {
+    std::size_t body_count = _bodies.GetSize();
+    if(body_count < PARALLEL_BODY_THRESHOLD) {
+        IntegrateBlock(0, body_count, deltaTime);
+        return;
+    }
+#if defined(A2DE_PARALLEL_PPL)
+    std::size_t block_count = (body_count + BODY_BLOCK_SIZE - 1) / BODY_BLOCK_SIZE;
+    Concurrency::parallel_for(std::size_t(0), block_count, [this, body_count, deltaTime](std::size_t block)
+    {
+        std::size_t first = block * BODY_BLOCK_SIZE;
+        IntegrateBlock(first, std::min(body_count, first + BODY_BLOCK_SIZE), deltaTime);
+    });
+#elif defined(A2DE_PARALLEL_THREADS)
+    //Whole blocks per thread keep two threads from writing to the same cache line.
+    std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t block_count = (body_count + BODY_BLOCK_SIZE - 1) / BODY_BLOCK_SIZE;
+    std::size_t per_thread = ((block_count + thread_count - 1) / thread_count) * BODY_BLOCK_SIZE;
+    std::vector<std::thread> workers;
+    for(std::size_t first = per_thread; first < body_count; first += per_thread) {
+        workers.push_back(std::thread(&World::IntegrateBlock, this, first, std::min(body_count, first + per_thread), deltaTime));
+    }
+    IntegrateBlock(0, std::min(body_count, per_thread), deltaTime);
+    std::for_each(workers.begin(), workers.end(), [](std::thread& worker) { worker.join(); });
+#else
+    IntegrateBlock(0, body_count, deltaTime);
+#endif
+}
+
+void World::UpdateSubscriptions() {
+    unsigned long gravity_revision = _gh ? _gh->GetRevision() : 0;
+    unsigned long drag_revision = _dh ? _dh->GetRevision() : 0;
+    if(_subscriptions_dirty == false && gravity_revision == _gravity_revision && drag_revision == _drag_revision) return;
+
+    std::size_t body_count = _bodies.GetSize();
+    for(std::size_t i = 0; i < body_count; ++i) {
+        if(_bodies.IsUsed(i) == false) continue;
+        _bodies.SetGravitySubscribed(i, false);
+        _bodies.SetDragSubscribed(i, false);
+    }
+    //Subscribers whose bodies are not in this world have no slot and are skipped.
+    std::size_t index = 0;
+    if(_gh) {
+        const std::list<Object*>& subscribers = _gh->GetSubscribers();
+        for(std::list<Object*>::const_iterator _iter = subscribers.begin(); _iter != subscribers.end(); ++_iter) {
+            if(*_iter && _bodies.GetIndex((*_iter)->GetBody(), index)) _bodies.SetGravitySubscribed(index, true);
+        }
+    }
+    if(_dh) {
+        const std::list<Object*>& subscribers = _dh->GetSubscribers();
+        for(std::list<Object*>::const_iterator _iter = subscribers.begin(); _iter != subscribers.end(); ++_iter) {
+            if(*_iter && _bodies.GetIndex((*_iter)->GetBody(), index)) _bodies.SetDragSubscribed(index, true);
+        }
+    }
+    _gravity_revision = gravity_revision;
+    _drag_revision = drag_revision;
+    _subscriptions_dirty = false;
+}
+
+void World::IntegrateBlock(std::size_t first, std::size_t last, double deltaTime) {
+    switch(_world_forces) {
+        case WorldDef::WORLDFORCES_BATCHED:
+            if(_dh) _dh->Update(_bodies, first, last);
+            if(_gh) _gh->Update(_bodies, first, last);
+            _bodies.Integrate(first, last, deltaTime);
+            break;
+        case WorldDef::WORLDFORCES_INTEGRATED:
+            if(_dh) _dh->Update(_bodies, first, last);
+            if(_gh) {
+                _bodies.Integrate(first, last, deltaTime, _gh->GetGravityValue());
+            } else {
+                _bodies.Integrate(first, last, deltaTime);
+            }
+            break;
+        case WorldDef::WORLDFORCES_PER_SUBSCRIBER:
+        default:
+            _bodies.Integrate(first, last, deltaTime);
+            break;
+    }
 }
 
 void World::ResolveCollisions(double deltaTime) {
     //BroadPhase: Check if Bounding Boxes are colliding.
     //NarrowPhase: Check if Collision Shapes are colliding and handle shape-specific resolution.
-    ContactPairs cps = BroadPhaseCollision();
-    NarrowPhaseCollision(cps, deltaTime);
+    BroadPhaseCollision();
+    NarrowPhaseCollision(deltaTime);
+    UpdateIslands(deltaTime);
+    DispatchContactEvents();
 }
 
-World::ContactPairs World::BroadPhaseCollision() {
+void World::BroadPhaseCollision() {
 
-    //Update the QuadTree Grid.
-    //For each Camera: Query any visible Objects.
-    //For each visible Object in all Cameras: generate a unique Contact Pair.
-    //Return the set of Contact Pairs.
+    //Update the spatial partition Grid.
+    //Pull back any bullet that passed through something on its way, before its pairs are collected.
+    //Collect every pair of handles the partition says may overlap, i.e. whose fat bounds share a cell.
+    //For each candidate pair with overlapping tight bounds: touch its cached contact.
+    //Contacts that were not touched end this frame.
 
     UpdateGrid();
+    SweepBullets();
 
-    ContactPairs cps;
-    if(_objects.empty()) return cps; //returns empty cps
-
-    //Must use oldie-but-goody for-loop here due to conditional processing of some objects and not others.
-    for(ObjectsIter objects_iter = _objects.begin(); objects_iter != _objects.end(); ++objects_iter) {
-        if((*objects_iter)->GetBody() == nullptr) continue;
-        std::vector<a2de::QuadTree<a2de::Vector2D>* > p = this->_grid->GetNodesByLocation((*objects_iter)->GetBody()->GetPosition());
-        if(p.empty()) continue;
-
-        std::size_t ps = p.size();
-        std::vector<a2de::Vector2D> v;
-        for(std::size_t i = 0; i < ps; ++i) {
-            std::vector<a2de::Vector2D> current_element_vec(p[i]->GetAllElements());
-            std::size_t cs = current_element_vec.size();
-            if(i == 0) {
-                v = current_element_vec;
-                continue;
-            }
-            v.reserve(cs + v.size());
-            v.insert(v.end(), current_element_vec.begin(), current_element_vec.end());
-        }
+    _contacts.BeginFrame();
+    _candidates.clear();
+    if(_objects.empty() == false) {
+        _grid->QueryPairs(_candidates);
+        GenerateContactPairs(_candidates);
+    }
+    _contacts.EndFrame();
+}
 
-        ContactPairs current_cps_pairs = GenerateContactPairs(v);
+void World::NarrowPhaseCollision(double deltaTime) {
+
+    //Split in three: decide which contacts are live, fill their manifolds in parallel, then resolve them
+    //together in cache order. Only the resolution writes to the bodies, so the result does not depend on
+    //how many threads did the generating.
+    a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+    _active_contacts.clear();
+    for(std::size_t i = 0; i < contacts.size(); ++i) {
+        a2de::Contact& contact = contacts[i];
+        if(contact.state == a2de::Contact::STATE_END) continue;
+        a2de::RigidBody* first_body = contact.first->GetBody();
+        a2de::RigidBody* second_body = contact.second->GetBody();
+        if(first_body == nullptr || second_body == nullptr) continue;
+        //A sensor only reports the overlap.
+        if(first_body->IsSensor() || second_body->IsSensor()) continue;
+
+        //A resting pair keeps its cached data and costs nothing. An awake body wakes what it touches.
+        bool first_awake = IsAwakeBody(first_body);
+        bool second_awake = IsAwakeBody(second_body);
+        if(first_awake == false && second_awake == false) continue;
+        if(first_awake == false && IsStaticBody(first_body) == false) {
+            first_body->Wake();
+            contact.first->SetSleepTime(0.0);
+        }
+        if(second_awake == false && IsStaticBody(second_body) == false) {
+            second_body->Wake();
+            contact.second->SetSleepTime(0.0);
+        }
+        _active_contacts.push_back(i);
+    }
 
-        //Remove any false positives. FP = non-colliding bounding boxes.
-        for(World::ContactPairsIter contacts_iter = current_cps_pairs.begin(); contacts_iter != current_cps_pairs.end(); /* DO NOTHING */ ) {
-            a2de::RigidBody* first_body = const_cast<a2de::RigidBody*>((*contacts_iter).GetFirstBody());
-            a2de::RigidBody* second_body = const_cast<a2de::RigidBody*>((*contacts_iter).GetSecondBody());
-
-            IBoundingBox* fBB = first_body->GetBoundingRectangle();
-            IBoundingBox* sBB = second_body->GetBoundingRectangle();
-            if(fBB == nullptr || sBB == nullptr) {
-                current_cps_pairs.erase(contacts_iter++);
-                continue;
-            }
-            a2de::Rectangle fR(fBB->GetTransform().GetPosition(), fBB->GetHalfExtents());
-            a2de::Rectangle sR(sBB->GetTransform().GetPosition(), sBB->GetHalfExtents());
-            if(fR.Intersects(sR) == false) {
-                current_cps_pairs.erase(contacts_iter++);
-                continue;
-            }
-            ++contacts_iter;
+    std::size_t active_count = _active_contacts.size();
+    if(active_count < PARALLEL_CONTACT_THRESHOLD) {
+        GenerateContacts(0, active_count);
+    } else {
+#if defined(A2DE_PARALLEL_PPL)
+        std::size_t block_count = (active_count + CONTACT_BLOCK_SIZE - 1) / CONTACT_BLOCK_SIZE;
+        Concurrency::parallel_for(std::size_t(0), block_count, [this, active_count](std::size_t block)
+        {
+            std::size_t first = block * CONTACT_BLOCK_SIZE;
+            GenerateContacts(first, std::min(active_count, first + CONTACT_BLOCK_SIZE));
+        });
+#elif defined(A2DE_PARALLEL_THREADS)
+        std::size_t thread_count = std::max(1u, std::thread::hardware_concurrency());
+        std::size_t per_thread = (active_count + thread_count - 1) / thread_count;
+        std::vector<std::thread> workers;
+        for(std::size_t first = per_thread; first < active_count; first += per_thread) {
+            workers.push_back(std::thread(&World::GenerateContacts, this, first, std::min(active_count, first + per_thread)));
         }
-        cps.insert(current_cps_pairs.begin(), current_cps_pairs.end());
+        GenerateContacts(0, std::min(active_count, per_thread));
+        std::for_each(workers.begin(), workers.end(), [](std::thread& worker) { worker.join(); });
+#else
+        GenerateContacts(0, active_count);
+#endif
     }
-    return cps;
-}
 
-void World::NarrowPhaseCollision(ContactPairs& contact_pairs, double deltaTime) {
+    //The manifolds stay in the cache for the next frame; the touching ones go to the solver, which sweeps
+    //over all of them together.
+    _solver.Clear();
+    for(std::size_t k = 0; k < active_count; ++k) {
+        a2de::Contact& contact = contacts[_active_contacts[k]];
+        if(contact.manifold.IsEmpty()) continue;
+        _solver.AddContact(contact, contact.first->GetBody(), contact.second->GetBody());
+    }
+    _solver.Solve(deltaTime);
+
+}
 
-    //For Each contact pair, update the post-collision physics.
-    for(World::ContactPairsIter _iter = contact_pairs.begin(); _iter != contact_pairs.end(); ++_iter) {
-        a2de::RigidBody* first_body = const_cast<a2de::RigidBody*>((*_iter).GetFirstBody());
-        a2de::RigidBody* second_body = const_cast<a2de::RigidBody*>((*_iter).GetSecondBody());
+void World::GenerateContacts(std::size_t first, std::size_t last) {
+    //Each live contact owns its manifold, so workers never write to the same one.
+    a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+    for(std::size_t k = first; k < last; ++k) {
+        a2de::Contact& contact = contacts[_active_contacts[k]];
+        ShapeCollisionSolver(contact.first->GetBody(), contact.second->GetBody(), contact.manifold);
+    }
+}
 
-        first_body->Wake();
-        second_body->Wake();
+void World::DispatchContactEvents() {
+    if(_contact_listener == nullptr && _sensor_count == 0) return;
+    const a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+    for(a2de::ContactCache::ContactsConstIter _iter = contacts.begin(); _iter != contacts.end(); ++_iter) {
+        DispatchContactEvent(*_iter, _iter->state);
+    }
+}
 
-        //Process contact: Adjust Velocity. Adjust Position.
-        VelocitySolver(first_body, second_body);
-        PositionSolver(first_body, second_body, deltaTime);
+void World::DispatchContactEvent(const a2de::Contact& contact, a2de::Contact::STATE state) {
+    if(_sensor_count > 0) DispatchSensorEvent(contact, state);
+    if(_contact_listener == nullptr) return;
+    switch(state) {
+        case a2de::Contact::STATE_BEGIN:
+            _contact_listener->BeginContact(contact);
+            break;
+        case a2de::Contact::STATE_PERSIST:
+            _contact_listener->PersistContact(contact);
+            break;
+        case a2de::Contact::STATE_END:
+            _contact_listener->EndContact(contact);
+            break;
     }
+}
 
+void World::DispatchSensorEvent(const a2de::Contact& contact, a2de::Contact::STATE state) {
+    //The cache already knows whether the pair began, kept or stopped overlapping this frame.
+    a2de::ISensor* first_sensor = contact.first_id < _sensors.size() ? _sensors[contact.first_id] : nullptr;
+    a2de::ISensor* second_sensor = contact.second_id < _sensors.size() ? _sensors[contact.second_id] : nullptr;
+    if((first_sensor == nullptr) == (second_sensor == nullptr)) return;
+    a2de::ISensor* sensor = (first_sensor ? first_sensor : second_sensor);
+    a2de::Object* object = (first_sensor ? contact.second : contact.first)->GetObject();
+    switch(state) {
+        case a2de::Contact::STATE_BEGIN:
+            sensor->BeginOverlap(object);
+            break;
+        case a2de::Contact::STATE_PERSIST:
+            sensor->PersistOverlap(object);
+            break;
+        case a2de::Contact::STATE_END:
+            sensor->EndOverlap(object);
+            break;
+    }
 }
 
 void World::UpdateGrid() {
-
-    std::vector<a2de::Vector2D> objs;
-    for(auto _iter = this->_objects.begin(); _iter != this->_objects.end(); ++_iter ) {
+    //Handles persist in the partition between frames; only those that moved out of their fat bounds are reinserted.
+    for(std::vector<BodyHandle*>::iterator _iter = _handles.begin(); _iter != _handles.end(); ++_iter) {
+        if(*_iter == nullptr) continue;
         if((*_iter)->GetBody() == nullptr) continue;
-        a2de::Vector2D collision_position = (*_iter)->GetBody()->GetPosition();
-        objs.push_back(collision_position);
+        //Sleeping bodies do not move, so their bounds are still good.
+        if(IsStaticBody((*_iter)->GetBody()) == false && IsAwakeBody((*_iter)->GetBody()) == false) continue;
+        (*_iter)->UpdateBounds();
+        if((*_iter)->IsContained()) continue;
+        if(_grid->Update(*_iter)) continue;
+
+        //Not stored yet, e.g. the body was outside of the world when it was added.
+        (*_iter)->Refit();
+        _grid->Add(*_iter);
     }
-    _grid->Clear();
-    _grid->Add(objs);
 }
 
-void World::QueryAllCameras(std::vector<a2de::Vector2D>& queried_elems) {
-    std::size_t max_cameras = _cameras.size();
-    for(std::size_t i = 0; i < max_cameras; ++i) {
-        std::vector<a2de::Vector2D> temp_queried_elems(_grid->Query(a2de::Rectangle(_cameras.at(i).GetPosition(), _cameras.at(i).GetExtents())));
-        queried_elems.insert(queried_elems.end(), temp_queried_elems.begin(), temp_queried_elems.end());
+void World::BeginBulletSweeps() {
+    _bullet_starts.clear();
+    for(std::vector<BodyHandle*>::iterator _iter = _handles.begin(); _iter != _handles.end(); ++_iter) {
+        if(*_iter == nullptr) continue;
+        a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr || body->IsBullet() == false || body->IsSensor()) continue;
+        if(IsAwakeBody(body) == false || body->GetCollisionShape() == nullptr) continue;
+        _bullet_starts.push_back(std::make_pair((*_iter)->GetId(), body->GetPosition()));
     }
 }
 
-a2de::World::ContactPairs World::GenerateContactPairs(std::vector<a2de::Vector2D>& queried_elems) {
-
-    a2de::World::ContactPairs contact_pairs;
-
-    std::size_t max_elems = queried_elems.size();
-    if(max_elems == 0) return contact_pairs;
-
-    for(std::size_t i = 0; i < max_elems - 1; ++i) {
-        for(std::size_t j = i + 1; j < max_elems; ++j) {
-
-            if(queried_elems[i] == queried_elems[j]) continue;
-            a2de::Vector2D& left_position(queried_elems[i]);
-            ObjectsIter left_iter = std::find_if(_objects.begin(), _objects.end(), [&left_position](a2de::Object* elem)->bool
-            {
-                if(elem == nullptr) return false;
-                if(elem->GetBody() == nullptr) return false;
-                return elem->GetBody()->GetPosition() == left_position;
-            });
-            if(left_iter == _objects.end()) continue;
-
-            if((*left_iter)->GetBody() == nullptr) continue;
-            a2de::RigidBody* left_body = (*left_iter)->GetBody();
-
-            a2de::Vector2D& right_position(queried_elems[j]);
-            ObjectsIter right_iter = std::find_if(_objects.begin(), _objects.end(), [&right_position](a2de::Object* elem)->bool
-            {
-                if(elem == nullptr) return false;
-                if(elem->GetBody() == nullptr) return false;
-                return elem->GetBody()->GetPosition() == right_position;
-            });
-            if(right_iter == _objects.end()) continue;
-
-            if((*right_iter)->GetBody() == nullptr) continue;
-            a2de::RigidBody* right_body = (*right_iter)->GetBody();
-
-            if(left_body == right_body) continue;
-
-            //The result doesn't matter. Inserted or not, the loop will continue.
-            contact_pairs.insert(a2de::ContactPair(left_body, right_body));
+void World::SweepBullets() {
+    for(std::vector<std::pair<unsigned long, a2de::Vector2D> >::iterator _iter = _bullet_starts.begin(); _iter != _bullet_starts.end(); ++_iter) {
+        if(_iter->first >= _handles.size() || _handles[_iter->first] == nullptr) continue;
+        BodyHandle* handle = _handles[_iter->first];
+        a2de::RigidBody* body = handle->GetBody();
+        if(body == nullptr || body->GetCollisionShape() == nullptr) continue;
+        a2de::Shape* shape = body->GetCollisionShape();
+
+        //A step shorter than the bullet itself cannot skip over anything the narrow phase would miss.
+        a2de::Vector2D start(_iter->second);
+        a2de::Vector2D end(body->GetPosition());
+        a2de::Vector2D displacement(end - start);
+        double dx = displacement.GetX();
+        double dy = displacement.GetY();
+        double size = std::min(shape->GetWidth(), shape->GetHeight());
+        if(dx * dx + dy * dy <= size * size) continue;
+
+        //The tight bounds sit at the end of the sweep; stretch them back over the start.
+        const a2de::Rectangle& bounds = handle->GetBounds();
+        a2de::Rectangle swept(a2de::Vector2D(bounds.GetX() - dx / 2.0, bounds.GetY() - dy / 2.0), a2de::Vector2D(bounds.GetWidth() + std::fabs(dx) / 2.0, bounds.GetHeight() + std::fabs(dy) / 2.0));
+        std::vector<BodyHandle*> found(_grid->Query(swept));
+
+        shape->SetPosition(start);
+        BodyHandle* hit = nullptr;
+        double hit_time = 1.0;
+        a2de::Vector2D hit_normal;
+        for(std::vector<BodyHandle*>::iterator _other = found.begin(); _other != found.end(); ++_other) {
+            if(*_other == nullptr || *_other == handle) continue;
+            a2de::RigidBody* other_body = (*_other)->GetBody();
+            if(other_body == nullptr || other_body == body || other_body->IsSensor()) continue;
+            //Two bullets would each stop short of where the other ended; leave them to the narrow phase.
+            if(other_body->IsBullet() && IsStaticBody(other_body) == false) continue;
+            const a2de::Shape* other_shape = other_body->GetCollisionShape();
+            if(other_shape == nullptr) continue;
+
+            double time = 0.0;
+            a2de::Vector2D normal;
+            if(a2de::GJK::GetTimeOfImpact(*shape, displacement, *other_shape, a2de::Vector2D(), BULLET_SEPARATION, time, normal) == false) continue;
+            //Already touching at the start and moving apart: nothing to stop.
+            if(time == 0.0 && displacement.DotProduct(normal) <= 0.0) continue;
+            if(hit != nullptr && time >= hit_time) continue;
+            hit = *_other;
+            hit_time = time;
+            hit_normal = normal;
+        }
 
+        if(hit == nullptr) {
+            body->SetPosition(end);
+        } else {
+            //The rest of the step is dropped rather than resolved again.
+            body->SetPosition(a2de::Vector2D(start.GetX() + hit_time * dx, start.GetY() + hit_time * dy));
+
+            a2de::RigidBody* other_body = hit->GetBody();
+            bool other_static = IsStaticBody(other_body);
+            double inverse_mass = 1.0 / body->GetMass();
+            double other_inverse_mass = other_static ? 0.0 : 1.0 / other_body->GetMass();
+            a2de::Vector2D velocity(body->GetVelocity());
+            a2de::Vector2D other_velocity(other_body->GetVelocity());
+            double nx = hit_normal.GetX();
+            double ny = hit_normal.GetY();
+            double closing = (velocity.GetX() - other_velocity.GetX()) * nx + (velocity.GetY() - other_velocity.GetY()) * ny;
+            if(closing > 0.0) {
+                double restitution = body->GetRestitution() * other_body->GetRestitution();
+                double impulse = (1.0 + restitution) * closing / (inverse_mass + other_inverse_mass);
+                body->SetVelocity(velocity.GetX() - impulse * inverse_mass * nx, velocity.GetY() - impulse * inverse_mass * ny);
+                if(other_static == false) {
+                    other_body->SetVelocity(other_velocity.GetX() + impulse * other_inverse_mass * nx, other_velocity.GetY() + impulse * other_inverse_mass * ny);
+                    other_body->Wake();
+                    hit->SetSleepTime(0.0);
+                }
+            }
         }
+
+        handle->UpdateBounds();
+        if(handle->IsContained()) continue;
+        if(_grid->Update(handle)) continue;
+        handle->Refit();
+        _grid->Add(handle);
     }
-    return contact_pairs;
 }
 
-void World::VelocitySolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Vector2D first_position = first_body->GetPosition();
-    a2de::Vector2D second_position = second_body->GetPosition();
-    a2de::Vector2D first_contact_normal;
-    a2de::Vector2D relPosFirst = first_position - second_position;
-    if(relPosFirst != a2de::Vector2D(0.0, 0.0)) {
-        first_contact_normal = relPosFirst.Normalize();
-    }
-    a2de::Vector2D second_contact_normal;
-    a2de::Vector2D relPosSecond = second_position - first_position;
-    if(relPosSecond != a2de::Vector2D(0.0, 0.0)) {
-        second_contact_normal = relPosSecond.Normalize();
+void World::QueryAllCameras(std::vector<a2de::BodyHandle*>& queried_elems) {
+    for(MapCamsIter _iter = _cameras.begin(); _iter != _cameras.end(); ++_iter) {
+        std::vector<a2de::BodyHandle*> temp_queried_elems(_grid->Query(a2de::Rectangle(_iter->second.GetPosition(), _iter->second.GetExtents())));
+        queried_elems.insert(queried_elems.end(), temp_queried_elems.begin(), temp_queried_elems.end());
     }
+}
 
-    double m1 = first_body->GetMass();
-    double m2 = second_body->GetMass();
-    double mass_sum = m1 + m2;
-    double mass1_mass2_diff = m1 - m2;
-    double mass2_mass1_diff = m2 - m1;
-    double v1 = first_body->GetVelocity().GetLength();
-    double v2 = second_body->GetVelocity().GetLength();
-    double theta1 = first_body->GetVelocity().GetAngle();
-    double theta2 = second_body->GetVelocity().GetAngle();
-    double phi1 = first_contact_normal.GetAngle();
-    double phi2 = second_contact_normal.GetAngle();
-    double cos_theta1_phi1 = std::cos(theta1 - phi1);
-    double cos_theta2_phi1 = std::cos(theta2 - phi1);
-    double sin_theta1_phi1 = std::sin(theta1 - phi1);
-    double cos_theta1_phi2 = std::cos(theta1 - phi2);
-    double cos_theta2_phi2 = std::cos(theta2 - phi2);
-    double sin_theta2_phi2 = std::sin(theta2 - phi2);
-    double cos_phi1_pi_2 = std::cos(phi1 + (a2de::Math::A2DE_1PI_2));
-    double sin_phi1_pi_2 = std::sin(phi1 + (a2de::Math::A2DE_1PI_2));
-    double cos_phi2_pi_2 = std::cos(phi2 + (a2de::Math::A2DE_1PI_2));
-    double sin_phi2_pi_2 = std::sin(phi2 + (a2de::Math::A2DE_1PI_2));
-    double twice_m1v1 = 2.0 * m1 * v1;
-    double twice_m2v2 = 2.0 * m2 * v2;
-    double cos_phi1 = std::cos(phi1);
-    double sin_phi1 = std::sin(phi1);
-    double cos_phi2 = std::cos(phi2);
-    double sin_phi2 = std::sin(phi2);
-
-    double v1_ratio = ((v1 * cos_theta1_phi1 * mass1_mass2_diff) + (twice_m2v2 * cos_theta2_phi1)) / mass_sum;
-
-    double v1x = (v1_ratio * cos_phi1) + (v1 * sin_theta1_phi1 * cos_phi1_pi_2);
-    double v1y = (v1_ratio * sin_phi1) + (v1 * sin_theta1_phi1 * sin_phi1_pi_2);
-
-    a2de::Vector2D v1prime(v1x, v1y);
+void World::GenerateContactPairs(std::vector<std::pair<a2de::BodyHandle*, a2de::BodyHandle*> >& candidates) {
 
-    double v2_ratio = ((v2 * cos_theta2_phi2 * mass2_mass1_diff) + (twice_m1v1 * cos_theta1_phi2)) / mass_sum;
+    for(std::vector<std::pair<BodyHandle*, BodyHandle*> >::iterator _iter = candidates.begin(); _iter != candidates.end(); ++_iter) {
+        BodyHandle* left = _iter->first;
+        BodyHandle* right = _iter->second;
+        if(left == nullptr || right == nullptr || left == right) continue;
 
-    double v2x = (v2_ratio * cos_phi2) + (v2 * sin_theta2_phi2 * cos_phi2_pi_2);
-    double v2y = (v2_ratio * sin_phi2) + (v2 * sin_theta2_phi2 * sin_phi2_pi_2);
+        //Keep the lower id first so the same two bodies always produce the same pair.
+        if(right->GetId() < left->GetId()) std::swap(left, right);
 
-    a2de::Vector2D v2prime(v2x, v2y);
+        a2de::RigidBody* left_body = left->GetBody();
+        a2de::RigidBody* right_body = right->GetBody();
+        if(left_body == nullptr || right_body == nullptr) continue;
+        if(left_body == right_body) continue;
 
-    double first_r = first_body->GetRestitution();
-    double second_r = second_body->GetRestitution();
+        //Pairs with no awake body only keep the contacts they already had; nothing new can start.
+        if(IsAwakeBody(left_body) == false && IsAwakeBody(right_body) == false) {
+            if(_contacts.Find(left->GetId(), right->GetId())) {
+                _contacts.Touch(left, right);
+            }
+            continue;
+        }
 
-    first_body->SetVelocity(first_r * v1prime);
-    second_body->SetVelocity(second_r * v2prime);
+        //Remove any false positives. FP = non-colliding bounding boxes.
+        if(left_body->GetBoundingRectangle() == nullptr || right_body->GetBoundingRectangle() == nullptr) continue;
+        if(left->GetBounds().Intersects(right->GetBounds()) == false) continue;
 
+        //Partitions that report a pair more than once touch the same contact again.
+        _contacts.Touch(left, right);
+    }
 }
 
-void World::PositionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body, double /*deltaTime*/) {
-
-    double first_mass = first_body->GetMass();
-    double second_mass = second_body->GetMass();
+bool World::ShapeCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body, a2de::ContactManifold& manifold) {
+    if(first_body == nullptr || second_body == nullptr) {
+        manifold.Reset();
+        return false;
+    }
+    return _dispatcher.Collide(*first_body, *second_body, manifold);
+}
 
-    //If both are zero or infinite mass, do nothing.
-    if(a2de::Math::IsEqual(first_mass, 0.0) && a2de::Math::IsEqual(second_mass, 0.0)) return;
-    if(a2de::Math::IsEqual(first_mass, a2de::Math::A2DE_INFINITY) && a2de::Math::IsEqual(second_mass, a2de::Math::A2DE_INFINITY)) return;
+const a2de::IBroadPhase<a2de::BodyHandle*>* World::GetGrid() const {
+    return _grid;
+}
 
-    a2de::Shape* first_collision_shape = first_body->GetCollisionShape();
-    a2de::Shape* second_collision_shape = second_body->GetCollisionShape();
+a2de::IBroadPhase<a2de::BodyHandle*>* World::GetGrid() {
+    return const_cast<a2de::IBroadPhase<a2de::BodyHandle*>*>(static_cast<const World&>(*this).GetGrid());
+}
 
-    if(first_collision_shape == nullptr || second_collision_shape == nullptr) return;
+void World::SetContactListener(a2de::IContactListener* listener) {
+    _contact_listener = listener;
+}
 
-    std::vector<ContactData> collision_results(ShapeCollisionSolver(first_body, second_body));
+const a2de::ContactCache& World::GetContactCache() const {
+    return _contacts;
+}
 
-    if(collision_results.empty()) return;
+const a2de::CollisionDispatcher& World::GetCollisionDispatcher() const {
+    return _dispatcher;
+}
 
-    double mass_sum = first_mass + second_mass;
+a2de::CollisionDispatcher& World::GetCollisionDispatcher() {
+    return const_cast<a2de::CollisionDispatcher&>(static_cast<const World&>(*this).GetCollisionDispatcher());
+}
 
-    a2de::Vector2D first_position = first_body->GetPosition();
-    a2de::Vector2D second_position = second_body->GetPosition();
+double World::GetFixedTimeStep() const {
+    return _fixed_time_step;
+}
 
-    a2de::Vector2D first_contact_normal = collision_results[0].GetContactNormal();
-    a2de::Vector2D first_interpenetration = first_contact_normal * collision_results[0].GetPenetrationAmount() * (first_mass / mass_sum);
+void World::SetFixedTimeStep(double time_step) {
+    _fixed_time_step = std::max(0.0, time_step);
+    _accumulator = 0.0;
+    _interpolation_alpha = _fixed_time_step > 0.0 ? 0.0 : 1.0;
+}
 
-    a2de::Vector2D second_contact_normal = collision_results[1].GetContactNormal();
-    a2de::Vector2D second_interpenetration = second_contact_normal * collision_results[1].GetPenetrationAmount() * (second_mass / mass_sum);
+std::size_t World::GetSubsteps() const {
+    return _substeps;
+}
 
-    first_body->SetPosition((first_position + first_interpenetration));
-    second_body->SetPosition((second_position + second_interpenetration));
+void World::SetSubsteps(std::size_t substeps) {
+    _substeps = std::max<std::size_t>(1, substeps);
 }
 
-std::vector<ContactData> World::ShapeCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Shape* first_collision_shape = first_body->GetCollisionShape();
-    a2de::Shape* second_collision_shape = second_body->GetCollisionShape();
-    if(first_collision_shape == nullptr || second_collision_shape == nullptr) return std::vector<ContactData>();
+std::size_t World::GetMaxSteps() const {
+    return _max_steps;
+}
 
-    a2de::Shape::SHAPE_TYPE first_shape_type = first_collision_shape->GetShapeType();
-    a2de::Shape::SHAPE_TYPE second_shape_type = second_collision_shape->GetShapeType();
+void World::SetMaxSteps(std::size_t max_steps) {
+    _max_steps = std::max<std::size_t>(1, max_steps);
+}
 
-    bool isCircleCircle = first_shape_type == a2de::Shape::SHAPETYPE_CIRCLE && second_shape_type == a2de::Shape::SHAPETYPE_CIRCLE;
-    bool isCircleLine = (first_shape_type == a2de::Shape::SHAPETYPE_CIRCLE && second_shape_type == a2de::Shape::SHAPETYPE_LINE) || (first_shape_type == a2de::Shape::SHAPETYPE_LINE && second_shape_type == a2de::Shape::SHAPETYPE_CIRCLE);
-    bool isCircleRectangle = (first_shape_type == a2de::Shape::SHAPETYPE_CIRCLE && second_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE) || (first_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE && second_shape_type == a2de::Shape::SHAPETYPE_CIRCLE);
-    bool isRectangleLine = (first_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE && second_shape_type == a2de::Shape::SHAPETYPE_LINE) || (first_shape_type == a2de::Shape::SHAPETYPE_LINE && second_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE);
-    bool isRectangleRectangle = (first_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE && second_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE);
+double World::GetInterpolationAlpha() const {
+    return _interpolation_alpha;
+}
 
-    std::vector<ContactData> collision_result;
-    if(isCircleCircle) {
-        collision_result = CircleCircleCollisionSolver(first_body, second_body);
-    } else if(isCircleLine) {
-        if(first_shape_type == a2de::Shape::SHAPETYPE_CIRCLE) {
-            collision_result = CircleLineCollisionSolver(first_body, second_body);
-        } else {
-            collision_result = CircleLineCollisionSolver(second_body, first_body);
+void World::SaveSnapshot(a2de::WorldSnapshot& snapshot) const {
+    snapshot.BeginWrite();
+    snapshot.WriteDouble(_accumulator);
+    snapshot.WriteDouble(_interpolation_alpha);
+    snapshot.WriteUnsigned(_contacts.GetFrame());
+
+    snapshot.WriteUnsigned(_handles.size());
+    for(std::size_t i = 0; i < _handles.size(); ++i) {
+        a2de::BodyHandle* handle = _handles[i];
+        a2de::RigidBody* body = handle ? handle->GetBody() : nullptr;
+        if(body == nullptr) {
+            snapshot.WriteByte(0);
+            continue;
         }
-    } else if(isCircleRectangle) {
-        if(first_shape_type == a2de::Shape::SHAPETYPE_CIRCLE) {
-            collision_result = CircleRectangleCollisionSolver(first_body, second_body);
-        } else {
-            collision_result = CircleRectangleCollisionSolver(second_body, first_body);
+        unsigned char flags = SNAPSHOT_BODY;
+        if(body->IsActive()) flags |= SNAPSHOT_ACTIVE;
+        if(_gh && _gh->IsRegistered(handle->GetObject())) flags |= SNAPSHOT_GRAVITY;
+        if(_dh && _dh->IsRegistered(handle->GetObject())) flags |= SNAPSHOT_DRAG;
+        snapshot.WriteByte(flags);
+
+        //A body replaced since the last update has no impulses waiting in the store yet.
+        a2de::Vector2D force;
+        if(_bodies.IsUsed(i) && _bodies.GetBody(i) == body) force = _bodies.GetForce(i);
+        const a2de::Vector2D& position = body->GetPosition();
+        a2de::Vector2D velocity(body->GetVelocity());
+        a2de::Vector2D acceleration(body->GetAcceleration());
+        a2de::Vector2D gravity_modifier(body->GetGravityModifier());
+        snapshot.WriteDouble(position.GetX());
+        snapshot.WriteDouble(position.GetY());
+        snapshot.WriteDouble(velocity.GetX());
+        snapshot.WriteDouble(velocity.GetY());
+        snapshot.WriteDouble(acceleration.GetX());
+        snapshot.WriteDouble(acceleration.GetY());
+        snapshot.WriteDouble(force.GetX());
+        snapshot.WriteDouble(force.GetY());
+        snapshot.WriteDouble(body->GetMass());
+        snapshot.WriteDouble(gravity_modifier.GetX());
+        snapshot.WriteDouble(gravity_modifier.GetY());
+        snapshot.WriteDouble(handle->GetSleepTime());
+
+        const a2de::Rectangle& fat_bounds = handle->GetFatBounds();
+        snapshot.WriteDouble(fat_bounds.GetX());
+        snapshot.WriteDouble(fat_bounds.GetY());
+        snapshot.WriteDouble(fat_bounds.GetWidth());
+        snapshot.WriteDouble(fat_bounds.GetHeight());
+
+        const a2de::ForceBuffer& forces = body->GetForces();
+        snapshot.WriteUnsigned(forces.GetSize());
+        for(std::size_t j = 0; j < forces.GetSize(); ++j) {
+            snapshot.WriteDouble(forces[j].x);
+            snapshot.WriteDouble(forces[j].y);
+            snapshot.WriteDouble(forces[j].duration);
         }
-    } else if(isRectangleLine) {
-        if(first_shape_type == a2de::Shape::SHAPETYPE_RECTANGLE) {
-            collision_result = RectangleLineCollisionSolver(first_body, second_body);
-        } else {
-            collision_result = RectangleLineCollisionSolver(second_body, first_body);
+    }
+
+    const a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+    snapshot.WriteUnsigned(contacts.size());
+    for(a2de::ContactCache::ContactsConstIter _iter = contacts.begin(); _iter != contacts.end(); ++_iter) {
+        snapshot.WriteUnsigned(_iter->first_id);
+        snapshot.WriteUnsigned(_iter->second_id);
+        snapshot.WriteByte(static_cast<unsigned char>(_iter->state));
+        snapshot.WriteUnsigned(_iter->frame);
+        snapshot.WriteDouble(_iter->manifold.GetNormalX());
+        snapshot.WriteDouble(_iter->manifold.GetNormalY());
+        snapshot.WriteByte(static_cast<unsigned char>(_iter->manifold.GetPointCount()));
+        for(std::size_t j = 0; j < _iter->manifold.GetPointCount(); ++j) {
+            const a2de::ManifoldPoint& point = _iter->manifold[j];
+            snapshot.WriteDouble(point.x);
+            snapshot.WriteDouble(point.y);
+            snapshot.WriteDouble(point.penetration);
+            snapshot.WriteDouble(point.normal_impulse);
+            snapshot.WriteDouble(point.tangent_impulse);
         }
-    } else if (isRectangleRectangle) {
-        collision_result = RectangleRectangleCollisionSolver(first_body, second_body);
-    } else {
-        /* DO NOTHING */
     }
-    return collision_result;
 }
 
-std::vector<ContactData> World::CircleCircleCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Circle first_shape(*dynamic_cast<a2de::Circle*>(first_body->GetCollisionShape()));
-    a2de::Circle second_shape(*dynamic_cast<a2de::Circle*>(second_body->GetCollisionShape()));
-
-    std::vector<ContactData> contact_result;
-    if(first_shape.Intersects(second_shape) == false) return contact_result;
+bool World::RestoreSnapshot(const a2de::WorldSnapshot& snapshot) {
+    //Check the whole snapshot first so a mismatch leaves the world as it was.
+    if(ReadSnapshot(snapshot, false) == false) return false;
+    ReadSnapshot(snapshot, true);
 
-    a2de::Vector2D p1(first_shape.GetPosition());
-    a2de::Vector2D p2(second_shape.GetPosition());
-    double r1 = first_shape.GetRadius();
-    double r2 = second_shape.GetRadius();
-    a2de::Vector2D second_collision_direction((p2 - p1).Normalize());
-    a2de::Vector2D first_collision_direction((p1 - p2).Normalize());
-
-    a2de::Vector2D c1(p1 + second_collision_direction * r1);
-    a2de::Vector2D c2(p2 + first_collision_direction * r2);
-
-    double interpenetration_distance((c2 - c1).GetLength());
-
-    contact_result.push_back(ContactData(c1, second_collision_direction, interpenetration_distance, *first_body, *second_body));
-    contact_result.push_back(ContactData(c2, first_collision_direction, interpenetration_distance, *second_body, *first_body));
-
-
-    //a2de::Vector2D first_collision_direction(second_shape.GetPosition() - first_shape.GetPosition());
-    //a2de::Vector2D second_collision_direction(first_shape.GetPosition() - second_shape.GetPosition());
-    //a2de::Vector2D collision_normalA_distance(first_collision_direction.Normalize() * first_shape.GetRadius());
-    //a2de::Vector2D collision_normalB_distance(second_collision_direction.Normalize() * second_shape.GetRadius());
-
-    //double distance_angleA = collision_normalA_distance.GetAngle();
-    //double distance_angleB = collision_normalB_distance.GetAngle();
-    //double c_normal_aX = first_collision_direction.GetX();
-    //double c_normal_aY = first_collision_direction.GetY();
-    //double c_normal_bX = second_collision_direction.GetX();
-    //double c_normal_bY = second_collision_direction.GetY();
-    //a2de::Vector2D collision_pointA(c_normal_aX * std::cos(distance_angleA), c_normal_aY * std::sin(distance_angleA));
-    //a2de::Vector2D collision_pointB(c_normal_bX * std::cos(distance_angleB), c_normal_bY * std::sin(distance_angleB));
-
-    //double interpenetration_distanceA = (collision_pointB - collision_pointA).GetLength();
-    //double interpenetration_distanceB = (collision_pointA - collision_pointB).GetLength();
-
-    //contact_result.push_back(ContactData(collision_pointA, first_collision_direction, interpenetration_distanceA, *first_body, *second_body));
-    //contact_result.push_back(ContactData(collision_pointB, second_collision_direction, interpenetration_distanceB, *second_body, *first_body));
-
-    return contact_result;
+    //Nothing should be drawn between where the bodies were before the restore and where they are now.
+    if(_fixed_time_step > 0.0) SavePreviousPositions();
+    return true;
 }
 
-std::vector<ContactData> World::CircleLineCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Circle first_shape(*dynamic_cast<a2de::Circle*>(first_body->GetCollisionShape()));
-    a2de::Line second_shape(*dynamic_cast<a2de::Line*>(second_body->GetCollisionShape()));
-
-    std::vector<ContactData> contact_result;
-    if(first_shape.Intersects(second_shape) == false) return contact_result;
-
-    Vector2D line_vector = second_shape.GetPointTwo() - second_shape.GetPointOne();
-    double left_angle_distance = std::abs(a2de::Vector2D::GetAngleFrom(line_vector.GetLeftNormal(), first_shape.GetPosition()));
-    double right_angle_distance = std::abs(a2de::Vector2D::GetAngleFrom(line_vector.GetRightNormal(), first_shape.GetPosition()));
-    double angle_distance = std::min(left_angle_distance, right_angle_distance);
-
-    double x_distance = std::cos(angle_distance) * first_shape.GetRadius();
-    double y_distance = std::sin(angle_distance) * first_shape.GetRadius();
+bool World::ReadSnapshot(const a2de::WorldSnapshot& snapshot, bool apply) {
+    std::size_t offset = 0;
+    if(snapshot.BeginRead(offset) == false) return false;
+
+    double accumulator = 0.0;
+    double interpolation_alpha = 0.0;
+    unsigned long frame = 0;
+    unsigned long handle_count = 0;
+    if(snapshot.ReadDouble(offset, accumulator) == false || snapshot.ReadDouble(offset, interpolation_alpha) == false) return false;
+    if(snapshot.ReadUnsigned(offset, frame) == false || snapshot.ReadUnsigned(offset, handle_count) == false) return false;
+    if(handle_count != _handles.size()) return false;
+    if(apply) {
+        _accumulator = accumulator;
+        _interpolation_alpha = interpolation_alpha;
+        _contacts.SetFrame(frame);
+    }
 
-    if(left_angle_distance < right_angle_distance) {
-        contact_result.push_back(ContactData(a2de::Vector2D(x_distance, y_distance), line_vector.GetLeftNormal(), first_shape.GetRadius() - second_shape.GetDistance(first_shape.GetPosition()), *first_body, *second_body));
-    } else {
-        contact_result.push_back(ContactData(a2de::Vector2D(x_distance, y_distance), line_vector.GetRightNormal(), first_shape.GetRadius() - second_shape.GetDistance(first_shape.GetPosition()), *first_body, *second_body));
+    for(std::size_t i = 0; i < _handles.size(); ++i) {
+        a2de::BodyHandle* handle = _handles[i];
+        a2de::RigidBody* body = handle ? handle->GetBody() : nullptr;
+        unsigned char flags = 0;
+        if(snapshot.ReadByte(offset, flags) == false) return false;
+        if(((flags & SNAPSHOT_BODY) != 0) != (body != nullptr)) return false;
+        if(body == nullptr) continue;
+
+        double values[16];
+        for(std::size_t j = 0; j < 16; ++j) {
+            if(snapshot.ReadDouble(offset, values[j]) == false) return false;
+        }
+        unsigned long force_count = 0;
+        if(snapshot.ReadUnsigned(offset, force_count) == false) return false;
+
+        if(apply) {
+            //Registering clears the body's forces, so the subscriptions go first.
+            a2de::Object* object = handle->GetObject();
+            if(_gh && ((flags & SNAPSHOT_GRAVITY) != 0) != _gh->IsRegistered(object)) {
+                if((flags & SNAPSHOT_GRAVITY) != 0) _gh->RegisterBody(object); else _gh->UnregisterBody(object);
+            }
+            if(_dh && ((flags & SNAPSHOT_DRAG) != 0) != _dh->IsRegistered(object)) {
+                if((flags & SNAPSHOT_DRAG) != 0) _dh->RegisterBody(object); else _dh->UnregisterBody(object);
+            }
+            body->SetMass(values[8]);
+            body->SetGravityModifier(values[9], values[10]);
+            body->SetPosition(a2de::Vector2D(values[0], values[1]));
+            body->SetVelocity(values[2], values[3]);
+            body->SetAcceleration(values[4], values[5]);
+            body->ClearForces();
+            body->ClearImpulses();
+        }
+        for(unsigned long j = 0; j < force_count; ++j) {
+            double x = 0.0;
+            double y = 0.0;
+            double duration = 0.0;
+            if(snapshot.ReadDouble(offset, x) == false || snapshot.ReadDouble(offset, y) == false || snapshot.ReadDouble(offset, duration) == false) return false;
+            if(apply) body->ApplyForce(a2de::Vector2D(x, y), duration);
+        }
+        if(apply == false) continue;
+
+        //Forces and impulses wake the body, so whether it sleeps is set last.
+        if(values[6] != 0.0 || values[7] != 0.0) body->ApplyImpulse(values[6], values[7]);
+        if((flags & SNAPSHOT_ACTIVE) != 0) body->Wake(); else body->Sleep();
+        handle->SetSleepTime(values[11]);
+
+        //The partition finds the handle by the fat bounds it was stored under, so it leaves before
+        //they change and comes back under the restored ones as they are, without a refit.
+        _grid->Remove(handle);
+        handle->GetFatBounds().SetPosition(a2de::Vector2D(values[12], values[13]));
+        handle->GetFatBounds().SetDimensions(a2de::Vector2D(values[14], values[15]));
+        handle->UpdateBounds();
+        _grid->Add(handle);
     }
 
-    return contact_result;
+    unsigned long contact_count = 0;
+    if(snapshot.ReadUnsigned(offset, contact_count) == false) return false;
+    a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+    if(apply) contacts.resize(contact_count);
+    for(unsigned long i = 0; i < contact_count; ++i) {
+        unsigned long first_id = 0;
+        unsigned long second_id = 0;
+        unsigned char state = 0;
+        unsigned long contact_frame = 0;
+        double normal_x = 0.0;
+        double normal_y = 0.0;
+        unsigned char point_count = 0;
+        if(snapshot.ReadUnsigned(offset, first_id) == false || snapshot.ReadUnsigned(offset, second_id) == false) return false;
+        if(snapshot.ReadByte(offset, state) == false || snapshot.ReadUnsigned(offset, contact_frame) == false) return false;
+        if(snapshot.ReadDouble(offset, normal_x) == false || snapshot.ReadDouble(offset, normal_y) == false) return false;
+        if(snapshot.ReadByte(offset, point_count) == false) return false;
+        if(first_id >= _handles.size() || second_id >= _handles.size()) return false;
+        if(_handles[first_id] == nullptr || _handles[second_id] == nullptr) return false;
+        if(state > a2de::Contact::STATE_END || point_count > a2de::ContactManifold::MAX_POINTS) return false;
+
+        if(apply) {
+            a2de::Contact& contact = contacts[i];
+            contact.first = _handles[first_id];
+            contact.second = _handles[second_id];
+            contact.first_id = first_id;
+            contact.second_id = second_id;
+            contact.state = static_cast<a2de::Contact::STATE>(state);
+            contact.frame = contact_frame;
+            contact.manifold.Clear();
+            contact.manifold.SetNormal(normal_x, normal_y);
+        }
+        for(std::size_t j = 0; j < point_count; ++j) {
+            double values[5];
+            for(std::size_t k = 0; k < 5; ++k) {
+                if(snapshot.ReadDouble(offset, values[k]) == false) return false;
+            }
+            if(apply == false) continue;
+            a2de::ContactManifold& manifold = contacts[i].manifold;
+            manifold.AddPoint(values[0], values[1], values[2]);
+            manifold[j].normal_impulse = values[3];
+            manifold[j].tangent_impulse = values[4];
+        }
+    }
+    return offset == snapshot.GetSize();
 }
 
-std::vector<ContactData> World::CircleRectangleCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Circle first_shape(*dynamic_cast<a2de::Circle*>(first_body->GetCollisionShape()));
-    a2de::Rectangle second_shape(*dynamic_cast<a2de::Rectangle*>(second_body->GetCollisionShape()));
-
-    std::vector<ContactData> contact_result;
-    if(first_shape.Intersects(second_shape) == false) return contact_result;
-
-    double resultTop = Point(first_shape.GetPosition()).GetDistanceSquared(second_shape.GetTop().GetPointOne(), second_shape.GetTop().GetPointTwo());
-    double resultLeft = Point(first_shape.GetPosition()).GetDistanceSquared(second_shape.GetLeft().GetPointOne(), second_shape.GetLeft().GetPointTwo());
-    double resultRight = Point(first_shape.GetPosition()).GetDistanceSquared(second_shape.GetRight().GetPointOne(), second_shape.GetRight().GetPointTwo());
-    double resultBottom = Point(first_shape.GetPosition()).GetDistanceSquared(second_shape.GetBottom().GetPointOne(), second_shape.GetBottom().GetPointTwo());
-
-    a2de::Vector2D contact_normal(second_shape.GetPosition() - first_shape.GetPosition().Normalize());
-    a2de::Vector2D contact_point(contact_normal * first_shape.GetRadius());
-    double interpenetraction_depth_s = std::min(std::min(resultTop, resultBottom), std::min(resultLeft, resultRight));
-
-    double interpenetraction_depth = std::sqrt(interpenetraction_depth_s);
-    contact_result.push_back(ContactData(contact_point, contact_normal, interpenetraction_depth, *first_body, *second_body));
+bool World::RayCast(const a2de::Vector2D& start, const a2de::Vector2D& end, a2de::QueryHit& hit, a2de::IQueryCallback* callback) {
+    //A ray is a point swept along the segment.
+    return Cast(a2de::Point(start), end - start, _grid->QueryRay(start, end), hit, callback);
+}
 
-    return contact_result;
+bool World::ShapeCast(const a2de::Shape& shape, const a2de::Vector2D& translation, a2de::QueryHit& hit, a2de::IQueryCallback* callback) {
+    //The bounds of any shape are where it reaches farthest along each axis.
+    double left = 0.0;
+    double right = 0.0;
+    double top = 0.0;
+    double bottom = 0.0;
+    double unused = 0.0;
+    shape.GetSupport(-1.0, 0.0, left, unused);
+    shape.GetSupport(1.0, 0.0, right, unused);
+    shape.GetSupport(0.0, -1.0, unused, top);
+    shape.GetSupport(0.0, 1.0, unused, bottom);
+    double dx = translation.GetX();
+    double dy = translation.GetY();
+    a2de::Vector2D center((left + right + dx) / 2.0, (top + bottom + dy) / 2.0);
+    a2de::Vector2D half_extents((right - left + std::fabs(dx)) / 2.0, (bottom - top + std::fabs(dy)) / 2.0);
+    return Cast(shape, translation, _grid->Query(a2de::Rectangle(center, half_extents)), hit, callback);
 }
 
-std::vector<ContactData> World::RectangleLineCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Rectangle first_shape(*dynamic_cast<a2de::Rectangle*>(first_body));
-    a2de::Line second_shape(*dynamic_cast<a2de::Line*>(second_body));
+std::size_t World::OverlapQuery(const a2de::Shape& area, std::vector<a2de::QueryHit>& hits, a2de::IQueryCallback* callback) {
+    std::vector<BodyHandle*> candidates(_grid->Query(area));
+    //Not every partition reports an element once.
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+    std::size_t count = 0;
+    for(std::vector<BodyHandle*>::iterator _iter = candidates.begin(); _iter != candidates.end(); ++_iter) {
+        if(*_iter == nullptr) continue;
+        a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr || body->GetCollisionShape() == nullptr) continue;
+        if(callback && callback->ShouldQuery((*_iter)->GetObject()) == false) continue;
+
+        a2de::Vector2D normal;
+        a2de::Vector2D point;
+        double depth = 0.0;
+        if(a2de::GJK::GetPenetration(area, *body->GetCollisionShape(), normal, depth, point) == false) continue;
+        a2de::QueryHit hit;
+        hit.object = (*_iter)->GetObject();
+        hit.body = body;
+        hit.point = point;
+        hit.normal = normal;
+        hit.fraction = 0.0;
+        hits.push_back(hit);
+        ++count;
+        if(callback && callback->ReportHit(hit) == false) break;
+    }
+    return count;
+}
 
-    std::vector<ContactData> contact_result;
-    if(first_shape.Intersects(second_shape) == false) return contact_result;
+bool World::Cast(const a2de::Shape& shape, const a2de::Vector2D& translation, const std::vector<a2de::BodyHandle*>& candidates, a2de::QueryHit& hit, a2de::IQueryCallback* callback) {
+    bool found = false;
+    double closest = 1.0;
+    for(std::vector<BodyHandle*>::const_iterator _iter = candidates.begin(); _iter != candidates.end(); ++_iter) {
+        if(*_iter == nullptr) continue;
+        a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr || body->GetCollisionShape() == nullptr) continue;
+        if(callback && callback->ShouldQuery((*_iter)->GetObject()) == false) continue;
+
+        //Only the motion up to the closest hit so far can find a closer one.
+        a2de::Vector2D motion(translation.GetX() * closest, translation.GetY() * closest);
+        double time = 0.0;
+        a2de::Vector2D normal;
+        a2de::Vector2D point;
+        if(a2de::GJK::GetTimeOfImpact(shape, motion, *body->GetCollisionShape(), a2de::Vector2D(), 0.0, time, normal, point) == false) continue;
+        time *= closest;
+        if(found && time >= closest) continue;
+
+        found = true;
+        closest = time;
+        hit.object = (*_iter)->GetObject();
+        hit.body = body;
+        hit.point = point;
+        hit.normal = a2de::Vector2D(-normal.GetX(), -normal.GetY());
+        hit.fraction = time;
+        if(callback && callback->ReportHit(hit) == false) break;
+    }
+    return found;
+}
 
-    return contact_result;
+bool World::IsSleepingAllowed() const {
+    return _allow_sleeping;
 }
 
-std::vector<ContactData> World::RectangleRectangleCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body) {
-    a2de::Rectangle first_shape(*dynamic_cast<a2de::Rectangle*>(first_body->GetCollisionShape()));
-    a2de::Rectangle second_shape(*dynamic_cast<a2de::Rectangle*>(second_body->GetCollisionShape()));
+void World::SetSleepingAllowed(bool allow) {
+    _allow_sleeping = allow;
+    if(_allow_sleeping) return;
+    for(std::vector<BodyHandle*>::iterator _iter = _handles.begin(); _iter != _handles.end(); ++_iter) {
+        if(*_iter == nullptr) continue;
+        a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr || IsStaticBody(body)) continue;
+        body->Wake();
+        (*_iter)->SetSleepTime(0.0);
+    }
+}
 
-    std::vector<ContactData> contact_result;
-    if(first_shape.Intersects(second_shape) == false) return contact_result;
+bool World::IsStaticBody(const a2de::RigidBody* body) {
+    double mass = body->GetMass();
+    return a2de::Math::IsEqual(mass, 0.0) || a2de::Math::IsEqual(mass, a2de::Math::A2DE_INFINITY);
+}
 
-    a2de::Vector2D fp(first_shape.GetPosition());
-    double fw(first_shape.GetWidth());
-    double fh(first_shape.GetHeight());
-    a2de::Vector2D fbl(fp + a2de::Vector2D(-fw, fh));
-    a2de::Vector2D ftl(fp + a2de::Vector2D(-fw, -fh));
-    a2de::Vector2D fbr(fp + a2de::Vector2D(fw, fh));
-    a2de::Vector2D ftr(fp + a2de::Vector2D(fw, -fh));
-    a2de::Vector2D fln((ftl - fbl).GetLeftNormal().Normalize());
-    a2de::Vector2D ftn((ftl - ftr).GetLeftNormal().Normalize());
-    a2de::Vector2D frn((fbr - ftr).GetLeftNormal().Normalize());
-    a2de::Vector2D fbn((fbl - fbr).GetLeftNormal().Normalize());
+bool World::IsAwakeBody(const a2de::RigidBody* body) {
+    return IsStaticBody(body) == false && body->IsActive();
+}
 
+unsigned long World::FindIsland(unsigned long id) {
+    //Path halving keeps the trees flat without recursion.
+    while(_islands[id] != id) {
+        _islands[id] = _islands[_islands[id]];
+        id = _islands[id];
+    }
+    return id;
+}
 
-    a2de::Vector2D sp(second_shape.GetPosition());
-    double sw(second_shape.GetWidth());
-    double sh(second_shape.GetHeight());
-    a2de::Vector2D sbl(sp + a2de::Vector2D(-sw, sh));
-    a2de::Vector2D stl(sp + a2de::Vector2D(-sw, -sh));
-    a2de::Vector2D sbr(sp + a2de::Vector2D(sw, sh));
-    a2de::Vector2D str(sp + a2de::Vector2D(sw, -sh));
-    a2de::Vector2D sln((stl - sbl).GetLeftNormal().Normalize());
-    a2de::Vector2D stn((str - stl).GetLeftNormal().Normalize());
-    a2de::Vector2D srn((sbr - str).GetLeftNormal().Normalize());
-    a2de::Vector2D sbn((sbl - sbr).GetLeftNormal().Normalize());
+void World::UpdateIslands(double deltaTime) {
+    if(_allow_sleeping == false) return;
 
-    a2de::Vector2D contact_point;
-    a2de::Vector2D contact_normal = (first_body->GetXPosition() < second_body->GetXPosition() ? frn : /*Right Normal*/
-                                    (first_body->GetXPosition() > second_body->GetXPosition() ? fln : /*Left Normal*/ 
-                                    (first_body->GetYPosition() < second_body->GetYPosition() ? fbn : /*Bottom Normal*/
-                                    (first_body->GetYPosition() > second_body->GetYPosition() ? ftn : /*Top Normal*/
-                                    a2de::Vector2D(0.0, 0.0) /*Do nothing*/ ))));
-    double penetration_amount;
-    a2de::Rectangle overlap_out;
-    bool is_overlapping = false;
-    first_shape.Overlap(second_shape, overlap_out, is_overlapping);
-    double w = overlap_out.GetWidth();
-    double h = overlap_out.GetHeight();
-    penetration_amount = w >= h ? w : h;
-    ContactData m1cd(contact_point, contact_normal, penetration_amount, *first_body, *second_body);
-    ContactData m2cd(contact_point, -contact_normal, penetration_amount, *second_body, *first_body);
+    std::size_t handle_count = _handles.size();
+    _islands.resize(handle_count);
+    for(std::size_t i = 0; i < handle_count; ++i) {
+        _islands[i] = i;
+    }
 
-    contact_result.push_back(m1cd);
-    contact_result.push_back(m2cd);
+    //Advance the rest time of every awake body. Sleeping bodies, however they fell asleep, count as rested.
+    for(std::vector<BodyHandle*>::iterator _iter = _handles.begin(); _iter != _handles.end(); ++_iter) {
+        if(*_iter == nullptr) continue;
+        a2de::RigidBody* body = (*_iter)->GetBody();
+        if(body == nullptr || IsStaticBody(body)) continue;
+        if(body->IsActive() == false) {
+            (*_iter)->SetSleepTime(std::max((*_iter)->GetSleepTime(), _time_to_sleep));
+            continue;
+        }
+        double energy = 0.5 * body->GetVelocity().GetLengthSquared();
+        if(energy > _sleep_energy) {
+            (*_iter)->SetSleepTime(0.0);
+        } else {
+            (*_iter)->SetSleepTime((*_iter)->GetSleepTime() + deltaTime);
+        }
+    }
 
-    return contact_result;
-}
+    //Dynamic bodies that touch share an island.
+    const a2de::ContactCache::Contacts& contacts = _contacts.GetContacts();
+    for(a2de::ContactCache::ContactsConstIter _iter = contacts.begin(); _iter != contacts.end(); ++_iter) {
+        if(_iter->state == a2de::Contact::STATE_END) continue;
+        a2de::RigidBody* first_body = _iter->first->GetBody();
+        a2de::RigidBody* second_body = _iter->second->GetBody();
+        if(first_body == nullptr || second_body == nullptr) continue;
+        if(IsStaticBody(first_body) || IsStaticBody(second_body)) continue;
+        if(first_body->IsSensor() || second_body->IsSensor()) continue;
+        unsigned long first_island = FindIsland(_iter->first_id);
+        unsigned long second_island = FindIsland(_iter->second_id);
+        if(first_island != second_island) {
+            _islands[second_island] = first_island;
+        }
+    }
 
-const a2de::QuadTree<a2de::Vector2D>* World::GetGrid() const {
-    return _grid;
-}
+    //An island is as restless as its most restless body.
+    _island_sleep_times.assign(handle_count, _time_to_sleep);
+    for(std::size_t i = 0; i < handle_count; ++i) {
+        if(_handles[i] == nullptr) continue;
+        a2de::RigidBody* body = _handles[i]->GetBody();
+        if(body == nullptr || IsStaticBody(body)) continue;
+        unsigned long island = FindIsland(i);
+        _island_sleep_times[island] = std::min(_island_sleep_times[island], _handles[i]->GetSleepTime());
+    }
 
-a2de::QuadTree<a2de::Vector2D>* World::GetGrid() {
-    return const_cast<a2de::QuadTree<a2de::Vector2D>*>(static_cast<const World&>(*this).GetGrid());
+    for(std::size_t i = 0; i < handle_count; ++i) {
+        if(_handles[i] == nullptr) continue;
+        a2de::RigidBody* body = _handles[i]->GetBody();
+        if(body == nullptr || IsStaticBody(body)) continue;
+        bool island_resting = _island_sleep_times[FindIsland(i)] >= _time_to_sleep;
+        if(island_resting && body->IsActive()) {
+            body->SetVelocity(0.0, 0.0);
+            body->Sleep();
+        } else if(island_resting == false && body->IsActive() == false) {
+            body->Wake();
+            _handles[i]->SetSleepTime(0.0);
+        }
+    }
 }
 
 void World::DeallocateWorld() {
     delete _grid;
     _grid = nullptr;
 
+    for(std::vector<BodyHandle*>::iterator _iter = _handles.begin(); _iter != _handles.end(); ++_iter) {
+        delete *_iter;
+        *_iter = nullptr;
+    }
+    _handles.clear();
+    _free_handles.clear();
+    _bodies.Clear();
+
     delete _gh;
     _gh = nullptr;
 
@@ -21,8 +21,21 @@
 
 #include "IUpdatable.h"
 #include "../Math/CRectangle.h"
+#include "IBroadPhase.h"
 #include "CQuadTree.h"
-#include "CContactData.h"
+#include "CGrid.h"
+#include "CSweepAndPrune.h"
+#include "CDynamicTree.h"
+#include "CLooseQuadTree.h"
+#include "CBodyHandle.h"
+#include "CBodyStore.h"
+#include "CContactCache.h"
+#include "CContactSolver.h"
+#include "CCollisionDispatcher.h"
+#include "IContactListener.h"
+#include "ISensor.h"
+#include "CWorldSnapshot.h"
+#include "IQueryCallback.h"
 
 A2DE_BEGIN
 
@@ -38,6 +51,33 @@ class IBoundingBox;
 * <remarks>Casey Ugone, 8/15/2013.</remarks>
 **************************************************************************************************/
 struct WorldDef {
+
+    /**************************************************************************************************
+     * <summary>Values that represent the spatial partition used by the broad phase. </summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     **************************************************************************************************/
+    enum BROADPHASE_TYPE {
+        BROADPHASE_QUADTREE,
+        BROADPHASE_GRID,
+        BROADPHASE_SWEEP_AND_PRUNE,
+        BROADPHASE_DYNAMIC_TREE,
+        BROADPHASE_LOOSE_QUADTREE,
+    };
+
+    /**************************************************************************************************
+     * <summary>Values that represent how the world's gravity and drag reach its bodies. </summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     **************************************************************************************************/
+    enum WORLDFORCES_TYPE {
+        //Each generator walks its subscribers and applies an impulse to each body.
+        WORLDFORCES_PER_SUBSCRIBER,
+        //Each generator runs one pass over the body store, reaching only the bodies subscribed to it.
+        WORLDFORCES_BATCHED,
+        //Drag runs one pass over the body store and gravity is added to the acceleration by the integrator,
+        //again only for the bodies subscribed to each.
+        WORLDFORCES_INTEGRATED,
+    };
+
     WorldDef() {
         width = 1.0;
         height = 1.0;
@@ -46,6 +86,20 @@ struct WorldDef {
         drag_k1 = 0.0;
         drag_k2 = 0.0;
         scale = 0.01;
+        broadphase = BROADPHASE_QUADTREE;
+        grid_cell_size = a2de::Grid<a2de::BodyHandle*>::DEFAULT_CELL_SIZE;
+        allow_sleeping = true;
+        sleep_energy = 0.001;
+        time_to_sleep = 0.5;
+        world_forces = WORLDFORCES_INTEGRATED;
+        velocity_iterations = a2de::ContactSolver::DEFAULT_VELOCITY_ITERATIONS;
+        position_iterations = a2de::ContactSolver::DEFAULT_POSITION_ITERATIONS;
+        position_correction = a2de::ContactSolver::DEFAULT_POSITION_CORRECTION;
+        penetration_slop = a2de::ContactSolver::DEFAULT_PENETRATION_SLOP;
+        warm_starting = true;
+        fixed_time_step = 0.0;
+        substeps = 1;
+        max_steps = 5;
     }
     /// <summary> The width of the world in meters.</summary>
     double width;
@@ -61,6 +115,34 @@ struct WorldDef {
     double drag_k2;
     /// <summary> The meters-to-pixels ratio for world scale.</summary>
     double scale;
+    /// <summary> The spatial partition used by the broad phase.</summary>
+    BROADPHASE_TYPE broadphase;
+    /// <summary> The size of each cell in meters when using the grid broad phase.</summary>
+    double grid_cell_size;
+    /// <summary> Whether resting islands of bodies are put to sleep.</summary>
+    bool allow_sleeping;
+    /// <summary> The kinetic energy per kilogram below which a body is resting.</summary>
+    double sleep_energy;
+    /// <summary> The time in seconds every body of an island must rest before the island sleeps.</summary>
+    double time_to_sleep;
+    /// <summary> How the world's gravity and drag reach its bodies.</summary>
+    WORLDFORCES_TYPE world_forces;
+    /// <summary> The number of sweeps the contact solver makes over the contact velocities.</summary>
+    std::size_t velocity_iterations;
+    /// <summary> The number of sweeps the contact solver makes over the contact penetrations.</summary>
+    std::size_t position_iterations;
+    /// <summary> The fraction of the penetration removed each frame.</summary>
+    double position_correction;
+    /// <summary> The penetration in meters that is allowed to remain.</summary>
+    double penetration_slop;
+    /// <summary> Whether the contact impulses of the last frame start the solve.</summary>
+    bool warm_starting;
+    /// <summary> The time in seconds of each physics step, or 0 to step once by each update's time.</summary>
+    double fixed_time_step;
+    /// <summary> The number of equal parts each step is split into.</summary>
+    std::size_t substeps;
+    /// <summary> The most fixed steps one update may take before the world falls behind.</summary>
+    std::size_t max_steps;
 };
 
 
@@ -347,7 +429,9 @@ public:
     const DragForceGenerator* GetDragHandler() const;
 
     /**************************************************************************************************
-     * <summary>Updates the world.</summary>
+     * <summary>Updates the world. With a fixed time step the time is banked and the world takes as
+     * many whole steps as it covers, up to the most steps per update; what is left sets the
+     * interpolation alpha. Without one the world takes a single step of the given time.</summary>
      * <remarks>Casey Ugone, 8/29/2012.</remarks>
      * <param name="deltaTime">Time since the last frame.</param>
      **************************************************************************************************/
@@ -376,7 +460,9 @@ public:
     void ClearVisibleScene(const Camera& cam, const Color& color);
 
     /**************************************************************************************************
-     * <summary>Renders every object based on visibility and z-depth.</summary>
+     * <summary>Renders every object based on visibility and z-depth. Bodies are drawn between
+     * where they were before the last step and where they are now, by the interpolation alpha,
+     * then put back.</summary>
      * <remarks>Casey Ugone, 5/27/2014.</remarks>
      **************************************************************************************************/
     void Render();
@@ -427,14 +513,167 @@ public:
      * <remarks>Casey Ugone, 5/27/2014.</remarks>
      * <returns>null if it fails, else the grid.</returns>
      **************************************************************************************************/
-    const a2de::QuadTree<a2de::Vector2D>* GetGrid() const;
+    const a2de::IBroadPhase<a2de::BodyHandle*>* GetGrid() const;
 
     /**************************************************************************************************
      * <summary>Gets the grid.</summary>
      * <remarks>Casey Ugone, 5/27/2014.</remarks>
      * <returns>null if it fails, else the grid.</returns>
      **************************************************************************************************/
-    a2de::QuadTree<a2de::Vector2D>* GetGrid();
+    a2de::IBroadPhase<a2de::BodyHandle*>* GetGrid();
+
+    /**************************************************************************************************
+     * <summary>Sets the object notified when bodies begin, keep and stop touching.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="listener">[in,out] If non-null, the listener. The world does not take ownership.</param>
+     **************************************************************************************************/
+    void SetContactListener(a2de::IContactListener* listener);
+
+    /**************************************************************************************************
+     * <summary>Gets the contacts kept from the last frame.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <returns>The contact cache.</returns>
+     **************************************************************************************************/
+    const a2de::ContactCache& GetContactCache() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the table that picks the narrow phase routine of each pair of shape types.
+     * Register a routine on it to collide shape types the world does not handle.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <returns>The collision dispatcher.</returns>
+     **************************************************************************************************/
+    const a2de::CollisionDispatcher& GetCollisionDispatcher() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the table that picks the narrow phase routine of each pair of shape types.
+     * Register a routine on it to collide shape types the world does not handle.</summary>
+     * <remarks>Casey Ugone, 8/16/2014.</remarks>
+     * <returns>The collision dispatcher.</returns>
+     **************************************************************************************************/
+    a2de::CollisionDispatcher& GetCollisionDispatcher();
+
+    /**************************************************************************************************
+     * <summary>Query if resting islands are put to sleep.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <returns>true if sleeping is allowed, false if not.</returns>
+     **************************************************************************************************/
+    bool IsSleepingAllowed() const;
+
+    /**************************************************************************************************
+     * <summary>Sets whether resting islands are put to sleep. Disallowing it wakes every body.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <param name="allow">true to allow sleeping.</param>
+     **************************************************************************************************/
+    void SetSleepingAllowed(bool allow);
+
+    /**************************************************************************************************
+     * <summary>Gets the time of each physics step.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The fixed time step in seconds, 0 if the world steps by each update's time.</returns>
+     **************************************************************************************************/
+    double GetFixedTimeStep() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the time of each physics step. Any time banked towards the next step is
+     * dropped.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="time_step">The fixed time step in seconds, 0 or less to step by each update's
+     *                         time.</param>
+     **************************************************************************************************/
+    void SetFixedTimeStep(double time_step);
+
+    /**************************************************************************************************
+     * <summary>Gets the number of equal parts each step is split into.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The substep count.</returns>
+     **************************************************************************************************/
+    std::size_t GetSubsteps() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the number of equal parts each step is split into.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="substeps">The substep count, at least 1.</param>
+     **************************************************************************************************/
+    void SetSubsteps(std::size_t substeps);
+
+    /**************************************************************************************************
+     * <summary>Gets the most fixed steps one update may take.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The maximum steps per update.</returns>
+     **************************************************************************************************/
+    std::size_t GetMaxSteps() const;
+
+    /**************************************************************************************************
+     * <summary>Sets the most fixed steps one update may take. A slow frame then slows the
+     * simulation down instead of making the next frame slower still.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="max_steps">The maximum steps per update, at least 1.</param>
+     **************************************************************************************************/
+    void SetMaxSteps(std::size_t max_steps);
+
+    /**************************************************************************************************
+     * <summary>Gets how far the time banked after the last update reaches towards the next step.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The interpolation alpha in [0, 1), 1 without a fixed time step.</returns>
+     **************************************************************************************************/
+    double GetInterpolationAlpha() const;
+
+    /**************************************************************************************************
+     * <summary>Writes the physics state of the world into a full snapshot: the kinematics, mass,
+     * timed forces, sleep state and force generator subscriptions of every body, the fat bounds the
+     * partition holds them by, the cached contacts and the time banked towards the next step.
+     * Shapes, materials and the objects themselves are not included.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="snapshot">[out] The snapshot. Its buffer is reused.</param>
+     **************************************************************************************************/
+    void SaveSnapshot(a2de::WorldSnapshot& snapshot) const;
+
+    /**************************************************************************************************
+     * <summary>Puts the world back into the state of a full snapshot, in place. The world must hold
+     * the same objects in the same handles as when the snapshot was saved; nothing is changed if
+     * it does not.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="snapshot">The snapshot. Decode a delta first.</param>
+     * <returns>true if it succeeds, false if the snapshot is not a full one of this version or does
+     * not match the world.</returns>
+     **************************************************************************************************/
+    bool RestoreSnapshot(const a2de::WorldSnapshot& snapshot);
+
+    /**************************************************************************************************
+     * <summary>Finds the first body the segment from start to end touches. Only the bodies the
+     * partition finds along the segment are tested, against their collision shapes.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="start">   The start of the ray.</param>
+     * <param name="end">     The end of the ray.</param>
+     * <param name="hit">     [out] The closest hit, or the one the callback stopped at.</param>
+     * <param name="callback">[in,out] If non-null, filters the bodies tested and receives the hits.</param>
+     * <returns>true if anything was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool RayCast(const a2de::Vector2D& start, const a2de::Vector2D& end, a2de::QueryHit& hit, a2de::IQueryCallback* callback);
+
+    /**************************************************************************************************
+     * <summary>Finds the first body a shape touches as it moves. Only the bodies the partition finds
+     * inside the bounds of the whole motion are tested. The shape only translates.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="shape">      The shape, where it starts.</param>
+     * <param name="translation">How far the shape moves.</param>
+     * <param name="hit">        [out] The closest hit, or the one the callback stopped at.</param>
+     * <param name="callback">   [in,out] If non-null, filters the bodies tested and receives the hits.</param>
+     * <returns>true if anything was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool ShapeCast(const a2de::Shape& shape, const a2de::Vector2D& translation, a2de::QueryHit& hit, a2de::IQueryCallback* callback);
+
+    /**************************************************************************************************
+     * <summary>Finds every body that overlaps an area. Only the bodies the partition finds inside
+     * the bounds of the area are tested.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="area">    The area.</param>
+     * <param name="hits">    [in,out] The hits are appended here, each with the deepest point and
+     *                        the normal that pushes the body out of the area.</param>
+     * <param name="callback">[in,out] If non-null, filters the bodies tested and receives the hits.</param>
+     * <returns>The number of hits appended.</returns>
+     **************************************************************************************************/
+    std::size_t OverlapQuery(const a2de::Shape& area, std::vector<a2de::QueryHit>& hits, a2de::IQueryCallback* callback);
 
 protected:
 private:
@@ -445,6 +684,66 @@ private:
      **************************************************************************************************/
     void DeallocateWorld();
 
+    /**************************************************************************************************
+     * <summary>Values that flag what a snapshot holds for a handle.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    enum SNAPSHOT_FLAG {
+        SNAPSHOT_BODY = 0x01,
+        SNAPSHOT_ACTIVE = 0x02,
+        SNAPSHOT_GRAVITY = 0x04,
+        SNAPSHOT_DRAG = 0x08,
+    };
+
+    /**************************************************************************************************
+     * <summary>Finds the first of the candidates a shape touches as it moves. Once a hit is found
+     * the motion is cut short there, so farther candidates stop early.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="shape">      The shape, where it starts.</param>
+     * <param name="translation">How far the shape moves.</param>
+     * <param name="candidates"> The handles the partition found.</param>
+     * <param name="hit">        [out] The closest hit, or the one the callback stopped at.</param>
+     * <param name="callback">   [in,out] If non-null, filters the bodies tested and receives the hits.</param>
+     * <returns>true if anything was hit, false if not.</returns>
+     **************************************************************************************************/
+    bool Cast(const a2de::Shape& shape, const a2de::Vector2D& translation, const std::vector<a2de::BodyHandle*>& candidates, a2de::QueryHit& hit, a2de::IQueryCallback* callback);
+
+    /**************************************************************************************************
+     * <summary>Reads a snapshot, either only checking that it matches the world or putting the world
+     * into its state.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="snapshot">The snapshot.</param>
+     * <param name="apply">   true to change the world, false to only check.</param>
+     * <returns>true if the snapshot matches the world, false if not.</returns>
+     **************************************************************************************************/
+    bool ReadSnapshot(const a2de::WorldSnapshot& snapshot, bool apply);
+
+    /**************************************************************************************************
+     * <summary>Advances the world by one step, split into the substeps.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="deltaTime">The time of the step.</param>
+     **************************************************************************************************/
+    void Step(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Records where every body is before a fixed step, to interpolate from.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    void SavePreviousPositions();
+
+    /**************************************************************************************************
+     * <summary>Moves every body that moved during the last step to its interpolated position,
+     * remembering where it really is.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    void BeginInterpolatedPoses();
+
+    /**************************************************************************************************
+     * <summary>Puts every body moved by BeginInterpolatedPoses back where it really is.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    void EndInterpolatedPoses();
+
     /**************************************************************************************************
      * <summary>Updates the objects in world described by deltaTime.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -453,105 +752,164 @@ private:
     void UpdateObjectsInWorld(double deltaTime);
 
     /**************************************************************************************************
-     * <summary>Updates the grid.</summary>
+     * <summary>Updates the grid. Only handles whose bodies have left their fat bounds are reinserted.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
      **************************************************************************************************/
     void UpdateGrid();
 
     /**************************************************************************************************
-     * <summary>Calculates the Narrow phase collision.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="contact_pairs">[in,out] The contact pairs.</param>
-     * <param name="deltaTime">    Time since the last frame.</param>
+     * <summary>Records where every awake bullet starts the step, before the bodies move.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
      **************************************************************************************************/
-    void NarrowPhaseCollision(a2de::World::ContactPairs& contact_pairs, double deltaTime);
+    void BeginBulletSweeps();
 
     /**************************************************************************************************
-     * <summary>Interpenetration solver.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="first_body"> [in,out] If non-null, the first body.</param>
-     * <param name="second_body">[in,out] If non-null, the second body.</param>
-     * <param name="deltaTime">  Time since the last frame.</param>
+     * <summary>Sweeps every bullet that moved farther than its own size from where it started to
+     * where it ended. The partition is queried with the bounds covering the whole sweep, and the
+     * bullet stops at the earliest time of impact against anything found, its velocity along the
+     * normal reflected. Other bodies count as resting where they ended.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
      **************************************************************************************************/
-    void PositionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body, double deltaTime);
+    void SweepBullets();
 
     /**************************************************************************************************
-     * <summary>Velocity solver.</summary>
+     * <summary>Calculates the Narrow phase collision for every cached contact that is touching.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="first_body"> [in,out] If non-null, the first body.</param>
-     * <param name="second_body">[in,out] If non-null, the second body.</param>
+     * <param name="deltaTime">Time since the last frame.</param>
      **************************************************************************************************/
-    void VelocitySolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    void NarrowPhaseCollision(double deltaTime);
 
     /**************************************************************************************************
-     * <summary>Calculates the broad phase collision.</summary>
+     * <summary>Calculates the broad phase collision, bringing the contact cache up to date.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <returns>.</returns>
      **************************************************************************************************/
-    a2de::World::ContactPairs BroadPhaseCollision();
+    void BroadPhaseCollision();
 
     /**************************************************************************************************
-     * <summary>Generates contact pairs.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="queried_boxes">[in,out] [in,out] If non-null, the queried boxes.</param>
-     * <returns>The contact pairs.</returns>
+     * <summary>Touches the cached contact of every candidate handle pair whose bounds overlap.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="candidates">[in,out] The candidate handle pairs.</param>
      **************************************************************************************************/
-    a2de::World::ContactPairs GenerateContactPairs(std::vector<a2de::Vector2D>& queried_elems);
+    void GenerateContactPairs(std::vector<std::pair<a2de::BodyHandle*, a2de::BodyHandle*> >& candidates);
 
     /**************************************************************************************************
-     * <summary>Queries all cameras.</summary>
-     * <remarks>Casey Ugone, 5/20/2013.</remarks>
-     * <param name="queried_boxes">[in,out] [in,out] If non-null, the queried boxes.</param>
+     * <summary>Notifies the contact listener of every cached contact, and every sensor of what
+     * overlaps it.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
      **************************************************************************************************/
-    void QueryAllCameras(std::vector<a2de::Vector2D>& queried_elems);
+    void DispatchContactEvents();
 
     /**************************************************************************************************
-     * <summary>Shape collision solver.</summary>
-     * <remarks>Casey Ugone, 5/21/2013.</remarks>
-     * <param name="first_collision_shape"> [in,out] If non-null, the first collision shape.</param>
-     * <param name="second_collision_shape">[in,out] If non-null, the second collision shape.</param>
+     * <summary>Notifies the contact listener and the sensor of a contact of one event.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="contact">The contact.</param>
+     * <param name="state">  The state to report, which may differ from the state of the contact.</param>
      **************************************************************************************************/
-    std::vector<ContactData> ShapeCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    void DispatchContactEvent(const a2de::Contact& contact, a2de::Contact::STATE state);
 
     /**************************************************************************************************
-     * <summary>Circle-Circle collision solver.</summary>
-     * <remarks>Casey Ugone, 5/21/2013.</remarks>
-     * <param name="first_collision_shape"> [in,out] If non-null, the first collision shape.</param>
-     * <param name="second_collision_shape">[in,out] If non-null, the second collision shape.</param>
+     * <summary>Notifies the sensor of a contact, if it has exactly one, of the object on its other
+     * side. Two sensors do not report each other.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="contact">The contact.</param>
+     * <param name="state">  The state to report, which may differ from the state of the contact.</param>
      **************************************************************************************************/
-    std::vector<ContactData> CircleCircleCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    void DispatchSensorEvent(const a2de::Contact& contact, a2de::Contact::STATE state);
 
     /**************************************************************************************************
-     * <summary>Circle-Line collision solver.</summary>
-     * <remarks>Casey Ugone, 5/21/2013.</remarks>
-     * <param name="first_collision_shape"> [in,out] If non-null, the first collision shape.</param>
-     * <param name="second_collision_shape">[in,out] If non-null, the second collision shape.</param>
+     * <summary>Runs the shape collision solver for a range of the live contacts. Only reads the bodies
+     * and writes each contact's own manifold, so ranges may run on different threads.</summary>
+     * <remarks>Casey Ugone, 8/9/2014.</remarks>
+     * <param name="first">The index of the first live contact.</param>
+     * <param name="last"> One past the index of the last live contact.</param>
      **************************************************************************************************/
-    std::vector<ContactData> CircleLineCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    void GenerateContacts(std::size_t first, std::size_t last);
 
     /**************************************************************************************************
-     * <summary>Circle-Rectangle collision solver.</summary>
-     * <remarks>Casey Ugone, 5/21/2013.</remarks>
-     * <param name="first_collision_shape"> [in,out] If non-null, the first collision shape.</param>
-     * <param name="second_collision_shape">[in,out] If non-null, the second collision shape.</param>
+     * <summary>Integrates every body in the store, in blocks spread across threads when there are
+     * enough of them.</summary>
+     * <remarks>Casey Ugone, 8/13/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
      **************************************************************************************************/
-    std::vector<ContactData> CircleRectangleCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    void IntegrateBodies(double deltaTime);
 
     /**************************************************************************************************
-     * <summary>Rectangle-Line collision solver.</summary>
-     * <remarks>Casey Ugone, 5/21/2013.</remarks>
-     * <param name="first_collision_shape"> [in,out] If non-null, the first collision shape.</param>
-     * <param name="second_collision_shape">[in,out] If non-null, the second collision shape.</param>
+     * <summary>Copies which bodies subscribe to the gravity and drag handlers into the body store, so
+     * the batched world forces reach only those. Only runs when a subscription changed or a body was
+     * attached since the last copy.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     **************************************************************************************************/
+    void UpdateSubscriptions();
+
+    /**************************************************************************************************
+     * <summary>Applies the batched world forces to a block of body slots and integrates it.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="first">    The first slot.</param>
+     * <param name="last">     One past the last slot.</param>
+     * <param name="deltaTime">Time since the last frame.</param>
      **************************************************************************************************/
-    std::vector<ContactData> RectangleLineCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    void IntegrateBlock(std::size_t first, std::size_t last, double deltaTime);
 
     /**************************************************************************************************
-     * <summary>Rectangle-Rectangle collision solver.</summary>
+     * <summary>Groups dynamic bodies that touch into islands and puts to sleep every island whose
+     * bodies have all rested for the time to sleep. Islands holding a body that is not resting are
+     * woken whole.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <param name="deltaTime">Time since the last frame.</param>
+     **************************************************************************************************/
+    void UpdateIslands(double deltaTime);
+
+    /**************************************************************************************************
+     * <summary>Finds the island of a handle.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <param name="id">The handle id.</param>
+     * <returns>The handle id that represents the island.</returns>
+     **************************************************************************************************/
+    unsigned long FindIsland(unsigned long id);
+
+    /**************************************************************************************************
+     * <summary>Query if a body is static, i.e. has zero or infinite mass. Static bodies never join
+     * islands, so resting on the ground does not link everything on it.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <param name="body">The body.</param>
+     * <returns>true if static, false if not.</returns>
+     **************************************************************************************************/
+    static bool IsStaticBody(const a2de::RigidBody* body);
+
+    /**************************************************************************************************
+     * <summary>Query if a body is dynamic and awake.</summary>
+     * <remarks>Casey Ugone, 8/7/2014.</remarks>
+     * <param name="body">The body.</param>
+     * <returns>true if awake, false if asleep or static.</returns>
+     **************************************************************************************************/
+    static bool IsAwakeBody(const a2de::RigidBody* body);
+
+    /**************************************************************************************************
+     * <summary>Queries all cameras.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="queried_elems">[in,out] The handles visible to any camera.</param>
+     **************************************************************************************************/
+    void QueryAllCameras(std::vector<a2de::BodyHandle*>& queried_elems);
+
+    /**************************************************************************************************
+     * <summary>Gets the handle assigned to an object.</summary>
+     * <remarks>Casey Ugone, 7/20/2014.</remarks>
+     * <param name="obj">[in,out] If non-null, the object.</param>
+     * <returns>null if the object has no handle, else the handle.</returns>
+     **************************************************************************************************/
+    a2de::BodyHandle* GetHandle(Object* obj);
+
+    /**************************************************************************************************
+     * <summary>Shape collision solver. Hands the pair to the routine the dispatcher holds for their
+     * shape types.</summary>
      * <remarks>Casey Ugone, 5/21/2013.</remarks>
-     * <param name="first_collision_shape"> [in,out] If non-null, the first collision shape.</param>
-     * <param name="second_collision_shape">[in,out] If non-null, the second collision shape.</param>
+     * <param name="first_body"> [in,out] If non-null, the first body.</param>
+     * <param name="second_body">[in,out] If non-null, the second body.</param>
+     * <param name="manifold">   [in,out] The manifold that receives the points, normal pointing from
+     *                           the first body to the second.</param>
+     * <returns>true if the shapes touch, false if not.</returns>
      **************************************************************************************************/
-    std::vector<ContactData> RectangleRectangleCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body);
+    bool ShapeCollisionSolver(a2de::RigidBody* first_body, a2de::RigidBody* second_body, a2de::ContactManifold& manifold);
 
     /// <summary> The dimensions </summary>
     Vector2D _dimensions;
@@ -566,9 +924,80 @@ private:
     GravityForceGenerator* _gh;
     /// <summary> The drag handler </summary>
     DragForceGenerator* _dh;
+    /// <summary> How the gravity and drag handlers reach the bodies </summary>
+    a2de::WorldDef::WORLDFORCES_TYPE _world_forces;
+    /// <summary> The revision of the gravity handler's subscribers last copied into the body store </summary>
+    unsigned long _gravity_revision;
+    /// <summary> The revision of the drag handler's subscribers last copied into the body store </summary>
+    unsigned long _drag_revision;
+    /// <summary> Whether the subscriptions must be copied again whatever the revisions </summary>
+    bool _subscriptions_dirty;
+
+    /// <summary> The body handles, indexed by handle id </summary>
+    std::vector<a2de::BodyHandle*> _handles;
+    /// <summary> The released handle ids available for reuse </summary>
+    std::vector<unsigned long> _free_handles;
+    /// <summary> The kinematic data of every body, indexed by handle id </summary>
+    a2de::BodyStore _bodies;
 
     /// <summary> The spatial partition grid </summary>
-    a2de::QuadTree<a2de::Vector2D>* _grid;
+    a2de::IBroadPhase<a2de::BodyHandle*>* _grid;
+
+    /// <summary> The candidate pairs, kept to avoid allocating every frame </summary>
+    std::vector<std::pair<a2de::BodyHandle*, a2de::BodyHandle*> > _candidates;
+    /// <summary> The handle id and starting position of each bullet swept this step </summary>
+    std::vector<std::pair<unsigned long, a2de::Vector2D> > _bullet_starts;
+    /// <summary> The contacts kept between frames </summary>
+    a2de::ContactCache _contacts;
+    /// <summary> The contact listener </summary>
+    a2de::IContactListener* _contact_listener;
+    /// <summary> The overlap listener of every sensor object, indexed by handle id; null for the rest </summary>
+    std::vector<a2de::ISensor*> _sensors;
+    /// <summary> The number of sensors in the world </summary>
+    std::size_t _sensor_count;
+
+    /// <summary> Whether resting islands are put to sleep </summary>
+    bool _allow_sleeping;
+    /// <summary> The kinetic energy per kilogram below which a body is resting </summary>
+    double _sleep_energy;
+    /// <summary> The time every body of an island must rest before the island sleeps </summary>
+    double _time_to_sleep;
+    /// <summary> The union-find parent of each handle id </summary>
+    std::vector<unsigned long> _islands;
+    /// <summary> The shortest rest time of each island, indexed by its representative id </summary>
+    std::vector<double> _island_sleep_times;
+    /// <summary> The cache indices of the contacts the narrow phase resolves this frame </summary>
+    std::vector<std::size_t> _active_contacts;
+    /// <summary> The solver for the live contacts </summary>
+    a2de::ContactSolver _solver;
+    /// <summary> The narrow phase routine of each pair of shape types </summary>
+    a2de::CollisionDispatcher _dispatcher;
+
+    /// <summary> The time of each step, 0 to step by each update's time </summary>
+    double _fixed_time_step;
+    /// <summary> The number of equal parts each step is split into </summary>
+    std::size_t _substeps;
+    /// <summary> The most fixed steps one update may take </summary>
+    std::size_t _max_steps;
+    /// <summary> The time banked towards the next fixed step </summary>
+    double _accumulator;
+    /// <summary> How far the banked time reaches towards the next step </summary>
+    double _interpolation_alpha;
+    /// <summary> Where each body was before the last fixed step, indexed by handle id </summary>
+    std::vector<a2de::Vector2D> _previous_positions;
+    /// <summary> The handle id and real position of each body drawn at its interpolated position </summary>
+    std::vector<std::pair<unsigned long, a2de::Vector2D> > _render_positions;
+
+    /// <summary> The fewest live contacts worth spreading across threads </summary>
+    static const std::size_t PARALLEL_CONTACT_THRESHOLD;
+    /// <summary> The number of live contacts handed to a worker at a time </summary>
+    static const std::size_t CONTACT_BLOCK_SIZE;
+    /// <summary> The fewest body slots worth spreading across threads </summary>
+    static const std::size_t PARALLEL_BODY_THRESHOLD;
+    /// <summary> The number of body slots handed to a worker at a time </summary>
+    static const std::size_t BODY_BLOCK_SIZE;
+    /// <summary> How far short of what it hits a swept bullet stops, in world units </summary>
+    static const double BULLET_SEPARATION;
 
 };
 
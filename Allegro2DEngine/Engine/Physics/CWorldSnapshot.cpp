@@ -0,0 +1,228 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CWorldSnapshot.cpp
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Implements the world snapshot class
+ **************************************************************************************************/
+#include "CWorldSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+
+A2DE_BEGIN
+
+const unsigned long WorldSnapshot::MAGIC;
+const unsigned char WorldSnapshot::VERSION;
+const std::size_t WorldSnapshot::HEADER_SIZE;
+const std::size_t WorldSnapshot::MIN_SKIP;
+
+WorldSnapshot::WorldSnapshot() : _data() {
+    /* DO NOTHING */
+}
+
+WorldSnapshot::WorldSnapshot(const WorldSnapshot& other) : _data(other._data) {
+    /* DO NOTHING */
+}
+
+WorldSnapshot& WorldSnapshot::operator=(const WorldSnapshot& rhs) {
+    if(this == &rhs) return *this;
+
+    _data.assign(rhs._data.begin(), rhs._data.end());
+    return *this;
+}
+
+WorldSnapshot::~WorldSnapshot() {
+    _data.clear();
+}
+
+void WorldSnapshot::Clear() {
+    _data.clear();
+}
+
+bool WorldSnapshot::IsEmpty() const {
+    return _data.empty();
+}
+
+bool WorldSnapshot::IsDelta() const {
+    return HasHeader(KIND_DELTA);
+}
+
+std::size_t WorldSnapshot::GetSize() const {
+    return _data.size();
+}
+
+const unsigned char* WorldSnapshot::GetData() const {
+    return _data.empty() ? nullptr : &_data[0];
+}
+
+bool WorldSnapshot::SetData(const unsigned char* data, std::size_t size) {
+    _data.clear();
+    if(data == nullptr || size == 0) return false;
+    _data.assign(data, data + size);
+    if(HasHeader(KIND_FULL) || HasHeader(KIND_DELTA)) return true;
+    _data.clear();
+    return false;
+}
+
+bool WorldSnapshot::Encode(const WorldSnapshot& base, const WorldSnapshot& target) {
+    if(this == &base || this == &target) return false;
+    if(base.HasHeader(KIND_FULL) == false || target.HasHeader(KIND_FULL) == false) return false;
+
+    const std::vector<unsigned char>& b = base._data;
+    const std::vector<unsigned char>& t = target._data;
+    std::size_t size = t.size();
+    std::size_t shared = std::min(size, b.size());
+
+    _data.clear();
+    WriteHeader(KIND_DELTA);
+    WriteCount(size);
+    WriteCount(b.size());
+
+    //Each run is the equal bytes to skip followed by the changed bytes to keep. A short equal run
+    //costs more to skip than to keep, so it stays inside the changed bytes.
+    std::size_t position = 0;
+    while(position < size) {
+        std::size_t skip = 0;
+        while(position + skip < shared && t[position + skip] == b[position + skip]) ++skip;
+        std::size_t first = position + skip;
+        std::size_t last = first;
+        while(last < size) {
+            if(last >= shared || t[last] != b[last]) {
+                ++last;
+                continue;
+            }
+            std::size_t equal = 0;
+            while(last + equal < shared && t[last + equal] == b[last + equal]) ++equal;
+            if(equal >= MIN_SKIP || last + equal == size) break;
+            last += equal;
+        }
+        WriteCount(skip);
+        WriteCount(last - first);
+        _data.insert(_data.end(), t.begin() + first, t.begin() + last);
+        position = last;
+    }
+    return true;
+}
+
+bool WorldSnapshot::Decode(const WorldSnapshot& base, const WorldSnapshot& delta) {
+    if(this == &base || this == &delta) return false;
+    if(base.HasHeader(KIND_FULL) == false || delta.HasHeader(KIND_DELTA) == false) return false;
+
+    std::size_t offset = HEADER_SIZE;
+    std::size_t size = 0;
+    std::size_t base_size = 0;
+    if(delta.ReadCount(offset, size) == false || delta.ReadCount(offset, base_size) == false) return false;
+    if(base_size != base._data.size()) return false;
+
+    _data.resize(size);
+    std::size_t position = 0;
+    while(position < size) {
+        std::size_t skip = 0;
+        std::size_t kept = 0;
+        if(delta.ReadCount(offset, skip) == false || delta.ReadCount(offset, kept) == false) break;
+        if(position + skip > base_size || position + skip + kept > size) break;
+        if(offset + kept > delta._data.size()) break;
+        std::copy(base._data.begin() + position, base._data.begin() + position + skip, _data.begin() + position);
+        position += skip;
+        std::copy(delta._data.begin() + offset, delta._data.begin() + offset + kept, _data.begin() + position);
+        position += kept;
+        offset += kept;
+    }
+    if(position == size) return true;
+    _data.clear();
+    return false;
+}
+
+void WorldSnapshot::BeginWrite() {
+    _data.clear();
+    WriteHeader(KIND_FULL);
+}
+
+void WorldSnapshot::WriteByte(unsigned char value) {
+    _data.push_back(value);
+}
+
+void WorldSnapshot::WriteUnsigned(unsigned long value) {
+    for(std::size_t i = 0; i < 4; ++i) {
+        _data.push_back(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void WorldSnapshot::WriteDouble(double value) {
+    unsigned long long bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    for(std::size_t i = 0; i < 8; ++i) {
+        _data.push_back(static_cast<unsigned char>((bits >> (8 * i)) & 0xFF));
+    }
+}
+
+bool WorldSnapshot::BeginRead(std::size_t& offset) const {
+    if(HasHeader(KIND_FULL) == false) return false;
+    offset = HEADER_SIZE;
+    return true;
+}
+
+bool WorldSnapshot::ReadByte(std::size_t& offset, unsigned char& value) const {
+    if(offset + 1 > _data.size()) return false;
+    value = _data[offset];
+    offset += 1;
+    return true;
+}
+
+bool WorldSnapshot::ReadUnsigned(std::size_t& offset, unsigned long& value) const {
+    if(offset + 4 > _data.size()) return false;
+    value = 0;
+    for(std::size_t i = 0; i < 4; ++i) {
+        value |= static_cast<unsigned long>(_data[offset + i]) << (8 * i);
+    }
+    offset += 4;
+    return true;
+}
+
+bool WorldSnapshot::ReadDouble(std::size_t& offset, double& value) const {
+    if(offset + 8 > _data.size()) return false;
+    unsigned long long bits = 0;
+    for(std::size_t i = 0; i < 8; ++i) {
+        bits |= static_cast<unsigned long long>(_data[offset + i]) << (8 * i);
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    offset += 8;
+    return true;
+}
+
+void WorldSnapshot::WriteHeader(KIND kind) {
+    WriteUnsigned(MAGIC);
+    WriteByte(VERSION);
+    WriteByte(static_cast<unsigned char>(kind));
+}
+
+void WorldSnapshot::WriteCount(std::size_t value) {
+    while(value >= 0x80) {
+        _data.push_back(static_cast<unsigned char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    _data.push_back(static_cast<unsigned char>(value));
+}
+
+bool WorldSnapshot::ReadCount(std::size_t& offset, std::size_t& value) const {
+    value = 0;
+    for(std::size_t shift = 0; offset < _data.size() && shift < 8 * sizeof(std::size_t); shift += 7) {
+        unsigned char byte = _data[offset++];
+        value |= static_cast<std::size_t>(byte & 0x7F) << shift;
+        if((byte & 0x80) == 0) return true;
+    }
+    return false;
+}
+
+bool WorldSnapshot::HasHeader(KIND kind) const {
+    std::size_t offset = 0;
+    unsigned long magic = 0;
+    if(ReadUnsigned(offset, magic) == false || magic != MAGIC) return false;
+    unsigned char version = 0;
+    unsigned char written_kind = 0;
+    if(ReadByte(offset, version) == false || ReadByte(offset, written_kind) == false) return false;
+    return version == VERSION && written_kind == static_cast<unsigned char>(kind);
+}
+
+A2DE_END
@@ -0,0 +1,242 @@
+/**************************************************************************************************
+// file:	Engine\Physics\CWorldSnapshot.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the world snapshot class
+ **************************************************************************************************/
+#ifndef A2DE_CWORLDSNAPSHOT_H
+#define A2DE_CWORLDSNAPSHOT_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+
+A2DE_BEGIN
+
+/**************************************************************************************************
+ * <summary>The physics state of a World packed into bytes. Every value is written little endian
+ * with no padding, behind a header that names the format version, so a snapshot can be kept in
+ * memory or written to a file as is. The buffer is kept when the snapshot is written again, so
+ * saving every frame only allocates when the world has grown.
+ *
+ * A snapshot is either full or a delta. A delta holds only the runs of bytes that differ from a
+ * base snapshot and is decoded against that same base.</summary>
+ * <remarks>Casey Ugone, 8/20/2014.</remarks>
+ **************************************************************************************************/
+class WorldSnapshot {
+public:
+
+    /// <summary> The first four bytes of every snapshot </summary>
+    static const unsigned long MAGIC = 0x53574132;
+    /// <summary> The version of the format written </summary>
+    static const unsigned char VERSION = 1;
+    /// <summary> The size in bytes of the header of a full snapshot </summary>
+    static const std::size_t HEADER_SIZE = 6;
+
+    /**************************************************************************************************
+     * <summary>Default constructor. The snapshot is empty.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    WorldSnapshot();
+
+    /**************************************************************************************************
+     * <summary>Copy constructor.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="other">The other.</param>
+     **************************************************************************************************/
+    WorldSnapshot(const WorldSnapshot& other);
+
+    /**************************************************************************************************
+     * <summary>Assignment operator. Reuses the buffer when it is large enough.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="rhs">The right hand side.</param>
+     * <returns>A deep copy of this object.</returns>
+     **************************************************************************************************/
+    WorldSnapshot& operator=(const WorldSnapshot& rhs);
+
+    /**************************************************************************************************
+     * <summary>Destructor.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    ~WorldSnapshot();
+
+    /**************************************************************************************************
+     * <summary>Empties the snapshot, keeping the buffer.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    void Clear();
+
+    /**************************************************************************************************
+     * <summary>Query if the snapshot holds nothing.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>true if empty, false if not.</returns>
+     **************************************************************************************************/
+    bool IsEmpty() const;
+
+    /**************************************************************************************************
+     * <summary>Query if the snapshot is a delta against another.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>true if a delta, false if full or empty.</returns>
+     **************************************************************************************************/
+    bool IsDelta() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the size of the snapshot.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>The size in bytes.</returns>
+     **************************************************************************************************/
+    std::size_t GetSize() const;
+
+    /**************************************************************************************************
+     * <summary>Gets the bytes of the snapshot, e.g. to write them to a file.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <returns>null if empty, else the bytes.</returns>
+     **************************************************************************************************/
+    const unsigned char* GetData() const;
+
+    /**************************************************************************************************
+     * <summary>Loads bytes written by another snapshot, e.g. read back from a file.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="data">The bytes.</param>
+     * <param name="size">The number of bytes.</param>
+     * <returns>true if the bytes start with a header of this version, false if not. The snapshot is
+     * left empty when they do not.</returns>
+     **************************************************************************************************/
+    bool SetData(const unsigned char* data, std::size_t size);
+
+    /**************************************************************************************************
+     * <summary>Makes this snapshot the delta that turns one full snapshot into another. Equal runs of
+     * bytes are skipped; the bytes between them are kept.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="base">  The full snapshot the delta is taken against.</param>
+     * <param name="target">The full snapshot the delta decodes to.</param>
+     * <returns>true if it succeeds, false if either snapshot is not full.</returns>
+     **************************************************************************************************/
+    bool Encode(const WorldSnapshot& base, const WorldSnapshot& target);
+
+    /**************************************************************************************************
+     * <summary>Makes this snapshot the full snapshot a delta was taken to.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="base"> The full snapshot the delta was taken against.</param>
+     * <param name="delta">The delta.</param>
+     * <returns>true if it succeeds, false if the delta is not one, was taken against a base of
+     * another size or is cut short.</returns>
+     **************************************************************************************************/
+    bool Decode(const WorldSnapshot& base, const WorldSnapshot& delta);
+
+    /**************************************************************************************************
+     * <summary>Starts writing a full snapshot, replacing what the snapshot held.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    void BeginWrite();
+
+    /**************************************************************************************************
+     * <summary>Appends a byte.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="value">The value.</param>
+     **************************************************************************************************/
+    void WriteByte(unsigned char value);
+
+    /**************************************************************************************************
+     * <summary>Appends an unsigned value as four bytes.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="value">The value, less than 2^32.</param>
+     **************************************************************************************************/
+    void WriteUnsigned(unsigned long value);
+
+    /**************************************************************************************************
+     * <summary>Appends a double as its eight bytes.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="value">The value.</param>
+     **************************************************************************************************/
+    void WriteDouble(double value);
+
+    /**************************************************************************************************
+     * <summary>Starts reading a full snapshot.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="offset">[out] Where the first value after the header is.</param>
+     * <returns>true if the snapshot is full and of this version, false if not.</returns>
+     **************************************************************************************************/
+    bool BeginRead(std::size_t& offset) const;
+
+    /**************************************************************************************************
+     * <summary>Reads a byte.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="offset">[in,out] Where the value is; moved past it.</param>
+     * <param name="value"> [out] The value.</param>
+     * <returns>true if it succeeds, false if the snapshot ends first.</returns>
+     **************************************************************************************************/
+    bool ReadByte(std::size_t& offset, unsigned char& value) const;
+
+    /**************************************************************************************************
+     * <summary>Reads an unsigned value written by WriteUnsigned.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="offset">[in,out] Where the value is; moved past it.</param>
+     * <param name="value"> [out] The value.</param>
+     * <returns>true if it succeeds, false if the snapshot ends first.</returns>
+     **************************************************************************************************/
+    bool ReadUnsigned(std::size_t& offset, unsigned long& value) const;
+
+    /**************************************************************************************************
+     * <summary>Reads a double written by WriteDouble.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="offset">[in,out] Where the value is; moved past it.</param>
+     * <param name="value"> [out] The value.</param>
+     * <returns>true if it succeeds, false if the snapshot ends first.</returns>
+     **************************************************************************************************/
+    bool ReadDouble(std::size_t& offset, double& value) const;
+
+protected:
+private:
+
+    /**************************************************************************************************
+     * <summary>Values that represent the kind of a snapshot, kept in the header after the version.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     **************************************************************************************************/
+    enum KIND {
+        KIND_FULL,
+        KIND_DELTA,
+    };
+
+    /// <summary> The fewest equal bytes worth ending a run of changed bytes for </summary>
+    static const std::size_t MIN_SKIP = 8;
+
+    /**************************************************************************************************
+     * <summary>Appends a header.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="kind">The kind of snapshot.</param>
+     **************************************************************************************************/
+    void WriteHeader(KIND kind);
+
+    /**************************************************************************************************
+     * <summary>Appends a count in as few bytes as it needs, seven bits to a byte.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="value">The count.</param>
+     **************************************************************************************************/
+    void WriteCount(std::size_t value);
+
+    /**************************************************************************************************
+     * <summary>Reads a count written by WriteCount.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="offset">[in,out] Where the count is; moved past it.</param>
+     * <param name="value"> [out] The count.</param>
+     * <returns>true if it succeeds, false if the snapshot ends first.</returns>
+     **************************************************************************************************/
+    bool ReadCount(std::size_t& offset, std::size_t& value) const;
+
+    /**************************************************************************************************
+     * <summary>Query if the snapshot starts with a header of this version and a kind.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="kind">The kind of snapshot.</param>
+     * <returns>true if it does, false if not.</returns>
+     **************************************************************************************************/
+    bool HasHeader(KIND kind) const;
+
+    /// <summary> The bytes </summary>
+    std::vector<unsigned char> _data;
+};
+
+A2DE_END
+
+#endif
@@ -13,14 +13,15 @@
 A2DE_BEGIN
 
 
-    ADTForceGenerator::ADTForceGenerator() : _subscribers() { /* DO NOTHING */ }
+    ADTForceGenerator::ADTForceGenerator() : _subscribers(), _revision(0) { /* DO NOTHING */ }
 
-ADTForceGenerator::ADTForceGenerator(const ADTForceGenerator& other) : _subscribers(other._subscribers) { /* DO NOTHING */ }
+ADTForceGenerator::ADTForceGenerator(const ADTForceGenerator& other) : _subscribers(other._subscribers), _revision(0) { /* DO NOTHING */ }
 
 ADTForceGenerator& ADTForceGenerator::operator=(const ADTForceGenerator& rhs) {
     if(this == &rhs) return *this;
 
     this->_subscribers = rhs._subscribers;
+    ++this->_revision;
 
     return *this;
 }
@@ -37,6 +38,7 @@ bool ADTForceGenerator::RegisterBody(Object* body) {
     std::list<Object*>::iterator _iter = std::find(_subscribers.begin(), _subscribers.end(), body);
     if(_iter != _subscribers.end()) return false;
     _subscribers.push_back(body);
+    ++_revision;
 
     b->ClearForces();
     b->ClearImpulses();
@@ -53,12 +55,26 @@ void ADTForceGenerator::UnregisterBody(Object* body) {
     std::list<Object*>::iterator _iter = std::find(_subscribers.begin(), _subscribers.end(), body);
     if(_iter == _subscribers.end()) return;
     _subscribers.erase(_iter);
+    ++_revision;
 
     b->ClearForces();
     b->ClearImpulses();
 
 }
 
+bool ADTForceGenerator::IsRegistered(const Object* body) const {
+    if(body == nullptr) return false;
+    return std::find(_subscribers.begin(), _subscribers.end(), body) != _subscribers.end();
+}
+
+const std::list<Object*>& ADTForceGenerator::GetSubscribers() const {
+    return _subscribers;
+}
+
+unsigned long ADTForceGenerator::GetRevision() const {
+    return _revision;
+}
+
 void ADTForceGenerator::SetBody(const a2de::RigidBodyDef& body) { a2de::Object::SetBody(body); }
 
 const a2de::RigidBody* ADTForceGenerator::GetBody() const { return a2de::Object::GetBody(); }
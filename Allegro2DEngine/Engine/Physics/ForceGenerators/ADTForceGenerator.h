@@ -63,6 +63,29 @@ public:
      **************************************************************************************************/
     void UnregisterBody(Object* body);
 
+    /**************************************************************************************************
+     * <summary>Query if a body is registered.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="body">The body.</param>
+     * <returns>true if registered, false if not.</returns>
+     **************************************************************************************************/
+    bool IsRegistered(const Object* body) const;
+
+    /**************************************************************************************************
+     * <summary>Gets the registered bodies.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <returns>The subscribers.</returns>
+     **************************************************************************************************/
+    const std::list<Object*>& GetSubscribers() const;
+
+    /**************************************************************************************************
+     * <summary>Gets a count of the changes to the registered bodies, so a caller that mirrors them
+     * can tell when they have changed without comparing the lists.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <returns>The revision.</returns>
+     **************************************************************************************************/
+    unsigned long GetRevision() const;
+
     /**************************************************************************************************
      * <summary>Updates all registered bodies by deltaTime.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -73,6 +96,8 @@ public:
 protected:
     /// <summary> The subscribers </summary>
     std::list<Object*> _subscribers;
+    /// <summary> The number of times a body was registered or unregistered </summary>
+    unsigned long _revision;
 
     virtual void SetBody(const a2de::RigidBodyDef& body);
     virtual const a2de::RigidBody* GetBody() const;
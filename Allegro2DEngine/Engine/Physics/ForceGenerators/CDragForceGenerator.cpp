@@ -7,6 +7,8 @@
  **************************************************************************************************/
 #include "CDragForceGenerator.h"
 
+#include "../CBodyStore.h"
+
 #include "../../a2de_objects.h"
 #include "../../a2de_math.h"
 #include <algorithm>
@@ -22,6 +24,8 @@ void DragForceGenerator::Update(double /*deltaTime*/) {
         if(elem == nullptr) return;
         a2de::RigidBody* body = elem->GetBody();
         if(body == nullptr) return;
+        //Sleeping bodies are at rest; there is nothing to drag.
+        if(body->IsActive() == false) return;
 
         Vector2D force = body->GetVelocity();
 
@@ -35,6 +39,10 @@ void DragForceGenerator::Update(double /*deltaTime*/) {
     });
 }
 
+void DragForceGenerator::Update(a2de::BodyStore& bodies, std::size_t first, std::size_t last) {
+    bodies.ApplyDrag(first, last, _coefficients.first, _coefficients.second);
+}
+
 DragForceGenerator::DragForceGenerator() : ADTForceGenerator(), _coefficients(0.0, 0.0) { /* DO NOTHING */ }
 
 DragForceGenerator::DragForceGenerator(double k1, double k2) : ADTForceGenerator(), _coefficients(k1, k2) { /* DO NOTHING */ }
@@ -16,6 +16,8 @@
 
 A2DE_BEGIN
 
+class BodyStore;
+
 class DragForceGenerator : public ADTForceGenerator {
 public:
 
@@ -61,6 +63,16 @@ public:
      **************************************************************************************************/
     virtual void Update(double deltaTime);
 
+    /**************************************************************************************************
+     * <summary>Adds drag to every body in a range of a store's slots in one pass, without going through the
+     * subscribers. Slots that are not subscribed get drag too.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="bodies">[in,out] The body store.</param>
+     * <param name="first"> The first slot.</param>
+     * <param name="last">  One past the last slot.</param>
+     **************************************************************************************************/
+    void Update(a2de::BodyStore& bodies, std::size_t first, std::size_t last);
+
     /**************************************************************************************************
      * <summary>Sets the linear coefficient constant.</summary>
      * <remarks>Casey Ugone, 5/20/2013.</remarks>
@@ -7,6 +7,8 @@
  **************************************************************************************************/
 #include "CGravityForceGenerator.h"
 
+#include "../CBodyStore.h"
+
 #include "../../Math/MiscMath.h"
 #include "../../a2de_objects.h"
 #include <algorithm>
@@ -83,11 +85,17 @@ void GravityForceGenerator::Update(double /*deltaTime*/) {
         if(elem == nullptr) return;
         a2de::RigidBody* body = elem->GetBody();
         if(body == nullptr) return;
+        //Applying a force wakes the body; sleeping bodies stay asleep until something touches them.
+        if(body->IsActive() == false) return;
 
         body->ApplyImpulse((_gravity * body->GetGravityModifier() * body->GetMass()));
     });
 }
 
+void GravityForceGenerator::Update(a2de::BodyStore& bodies, std::size_t first, std::size_t last) {
+    bodies.ApplyGravity(first, last, _gravity);
+}
+
 a2de::Vector2D GravityForceGenerator::GetGravityValue() const {
     return _gravity;
 }
@@ -15,6 +15,8 @@
 
 A2DE_BEGIN
 
+class BodyStore;
+
 class GravityForceGenerator : public ADTForceGenerator {
 
 public:
@@ -119,6 +121,16 @@ public:
      **************************************************************************************************/
     virtual void Update(double deltaTime);
 
+    /**************************************************************************************************
+     * <summary>Adds gravity to every awake dynamic body in a range of a store's slots in one pass, without going
+     * through the subscribers. Slots that are not subscribed get gravity too.</summary>
+     * <remarks>Casey Ugone, 8/14/2014.</remarks>
+     * <param name="bodies">[in,out] The body store.</param>
+     * <param name="first"> The first slot.</param>
+     * <param name="last">  One past the last slot.</param>
+     **************************************************************************************************/
+    void Update(a2de::BodyStore& bodies, std::size_t first, std::size_t last);
+
     /**************************************************************************************************
      * <summary>Sets a gravity.</summary>
      * <remarks>Casey Ugone, 8/29/2012.</remarks>
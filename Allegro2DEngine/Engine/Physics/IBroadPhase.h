@@ -0,0 +1,142 @@
+/**************************************************************************************************
+// file:	Engine\Physics\IBroadPhase.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the IBroadPhase interface
+ **************************************************************************************************/
+#ifndef A2DE_IBROADPHASE_H
+#define A2DE_IBROADPHASE_H
+
+#include "../a2de_vals.h"
+
+#include <vector>
+#include <utility>
+#include <cmath>
+
+#include <allegro/gfx.h>
+
+#include "../Math/CVector2D.h"
+#include "../Math/CRectangle.h"
+
+A2DE_BEGIN
+
+class Shape;
+
+/**************************************************************************************************
+ * <summary>A spatial partition the World can use to find candidate collision pairs.</summary>
+ * <remarks>Casey Ugone, 7/22/2014.</remarks>
+ **************************************************************************************************/
+template<typename T>
+class IBroadPhase {
+public:
+
+    /**************************************************************************************************
+     * <summary>Adds an element.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="elem">The element to add.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    virtual bool Add(const T& elem)=0;
+
+    /**************************************************************************************************
+     * <summary>Removes an element.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="elem">The element to remove.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    virtual bool Remove(const T& elem)=0;
+
+    /**************************************************************************************************
+     * <summary>Updates an element whose extents have changed.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="elem">The element to update.</param>
+     * <returns>true if it succeeds, false if it fails.</returns>
+     **************************************************************************************************/
+    virtual bool Update(const T& elem)=0;
+
+    /**************************************************************************************************
+     * <summary>Removes every element.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     **************************************************************************************************/
+    virtual void Clear()=0;
+
+    /**************************************************************************************************
+     * <summary>Queries a given area.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="area">The area.</param>
+     * <returns>The elements that may overlap the area.</returns>
+     **************************************************************************************************/
+    virtual std::vector<T> Query(const a2de::Shape& area)=0;
+
+    /**************************************************************************************************
+     * <summary>Queries the segment from start to end. Partitions that cannot walk a ray are
+     * queried with the bounds of the segment instead.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="start">The start of the ray.</param>
+     * <param name="end">  The end of the ray.</param>
+     * <returns>The elements that may cross the segment.</returns>
+     **************************************************************************************************/
+    virtual std::vector<T> QueryRay(const a2de::Vector2D& start, const a2de::Vector2D& end) {
+        double half_width = std::fabs(end.GetX() - start.GetX()) / 2.0;
+        double half_height = std::fabs(end.GetY() - start.GetY()) / 2.0;
+        return Query(a2de::Rectangle((start + end) / 2.0, a2de::Vector2D(half_width, half_height)));
+    }
+
+    /**************************************************************************************************
+     * <summary>Gets the pairs of elements that may overlap.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="pairs">[in,out] The candidate pairs are appended here.</param>
+     **************************************************************************************************/
+    virtual void QueryPairs(std::vector<std::pair<T, T> >& pairs)=0;
+
+    /**************************************************************************************************
+     * <summary>Draws the partition.</summary>
+     * <remarks>Casey Ugone, 7/22/2014.</remarks>
+     * <param name="dest">[in,out] If non-null, destination for the.</param>
+     **************************************************************************************************/
+    virtual void Draw(BITMAP* dest)=0;
+
+    virtual ~IBroadPhase() { /* DO NOTHING */ }
+protected:
+private:
+};
+
+template<typename T>
+T* ptr(T& obj) {
+    //turn reference into pointer!
+    return &obj;
+}
+
+template<typename T>
+T* ptr(T* obj) {
+    //obj is already pointer, return it!
+    return obj;
+}
+
+template<typename T>
+const T& bounds_of(const T& obj) {
+    //Values are their own extents, e.g. a Vector2D is a point.
+    return obj;
+}
+
+template<typename T>
+const T& bounds_of(const T* obj) {
+    //Pointers to shapes use the pointed-to shape as the extents.
+    return *obj;
+}
+
+template<typename T>
+const T& bounds_of(T* obj) {
+    //Without this a non-const pointer binds to bounds_of(const T&) and becomes its own extents.
+    return *obj;
+}
+
+template<typename T>
+void refit(const T& /*obj*/) {
+    //Elements without stored extents have nothing to refit.
+}
+
+A2DE_END
+
+#endif
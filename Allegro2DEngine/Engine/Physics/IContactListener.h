@@ -0,0 +1,53 @@
+/**************************************************************************************************
+// file:	Engine\Physics\IContactListener.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the IContactListener interface
+ **************************************************************************************************/
+#ifndef A2DE_ICONTACTLISTENER_H
+#define A2DE_ICONTACTLISTENER_H
+
+#include "../a2de_vals.h"
+
+A2DE_BEGIN
+
+struct Contact;
+
+/**************************************************************************************************
+ * <summary>Receives the contact events of a World. Override only the events of interest.</summary>
+ * <remarks>Casey Ugone, 8/5/2014.</remarks>
+ **************************************************************************************************/
+class IContactListener {
+public:
+
+    /**************************************************************************************************
+     * <summary>Called the first frame two bodies touch.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="contact">The contact.</param>
+     **************************************************************************************************/
+    virtual void BeginContact(const a2de::Contact& /*contact*/) { /* DO NOTHING */ }
+
+    /**************************************************************************************************
+     * <summary>Called every following frame the two bodies still touch.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="contact">The contact.</param>
+     **************************************************************************************************/
+    virtual void PersistContact(const a2de::Contact& /*contact*/) { /* DO NOTHING */ }
+
+    /**************************************************************************************************
+     * <summary>Called the first frame two bodies no longer touch, or when either is removed from the
+     * world while they do.</summary>
+     * <remarks>Casey Ugone, 8/5/2014.</remarks>
+     * <param name="contact">The contact as it was when they last touched.</param>
+     **************************************************************************************************/
+    virtual void EndContact(const a2de::Contact& /*contact*/) { /* DO NOTHING */ }
+
+    virtual ~IContactListener() { /* DO NOTHING */ }
+protected:
+private:
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,74 @@
+/**************************************************************************************************
+// file:	Engine\Physics\IQueryCallback.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the IQueryCallback interface
+ **************************************************************************************************/
+#ifndef A2DE_IQUERYCALLBACK_H
+#define A2DE_IQUERYCALLBACK_H
+
+#include "../a2de_vals.h"
+
+#include "../Math/CVector2D.h"
+
+A2DE_BEGIN
+
+class Object;
+class RigidBody;
+
+/**************************************************************************************************
+ * <summary>What a ray cast, shape cast or overlap query of a World found.</summary>
+ * <remarks>Casey Ugone, 8/20/2014.</remarks>
+ **************************************************************************************************/
+struct QueryHit {
+    QueryHit() {
+        object = nullptr;
+        body = nullptr;
+        fraction = 0.0;
+    }
+    /// <summary> The object hit </summary>
+    a2de::Object* object;
+    /// <summary> The body of the object hit </summary>
+    a2de::RigidBody* body;
+    /// <summary> Where the ray or cast shape first touches the body </summary>
+    a2de::Vector2D point;
+    /// <summary> The unit normal of the body's surface there, facing the ray or cast shape </summary>
+    a2de::Vector2D normal;
+    /// <summary> How far along the ray or translation the hit is, from 0 to 1. Always 0 for an overlap </summary>
+    double fraction;
+};
+
+/**************************************************************************************************
+ * <summary>Filters and receives the hits of a World query. Override only what is needed; by
+ * default every body is tested and the query runs to the end.</summary>
+ * <remarks>Casey Ugone, 8/20/2014.</remarks>
+ **************************************************************************************************/
+class IQueryCallback {
+public:
+
+    /**************************************************************************************************
+     * <summary>Called for every candidate the partition finds, before its shape is tested.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="object">The object.</param>
+     * <returns>true to test the object, false to skip it.</returns>
+     **************************************************************************************************/
+    virtual bool ShouldQuery(const a2de::Object* /*object*/) { return true; }
+
+    /**************************************************************************************************
+     * <summary>Called for every hit. A ray or shape cast reports only hits closer than the closest
+     * one so far, in no particular order.</summary>
+     * <remarks>Casey Ugone, 8/20/2014.</remarks>
+     * <param name="hit">The hit.</param>
+     * <returns>true to keep going, false to stop the query at this hit.</returns>
+     **************************************************************************************************/
+    virtual bool ReportHit(const a2de::QueryHit& /*hit*/) { return true; }
+
+    virtual ~IQueryCallback() { /* DO NOTHING */ }
+protected:
+private:
+};
+
+A2DE_END
+
+#endif
@@ -0,0 +1,56 @@
+/**************************************************************************************************
+// file:	Engine\Physics\ISensor.h
+// A2DE
+// Copyright (c) 2013 Blisspoint Softworks and Casey Ugone. All rights reserved.
+// Contact cugone@gmail.com for questions or support.
+// summary:	Declares the ISensor interface
+ **************************************************************************************************/
+#ifndef A2DE_ISENSOR_H
+#define A2DE_ISENSOR_H
+
+#include "../a2de_vals.h"
+
+A2DE_BEGIN
+
+class Object;
+
+/**************************************************************************************************
+ * <summary>An object whose body is a sensor and that wants to hear what overlaps it. The World
+ * finds the overlaps in its broad phase and reports them from its contact cache, so each event
+ * is raised once per pair and frame with no bookkeeping on the sensor's side. Override only the
+ * events of interest.</summary>
+ * <remarks>Casey Ugone, 8/21/2014.</remarks>
+ **************************************************************************************************/
+class ISensor {
+public:
+
+    /**************************************************************************************************
+     * <summary>Called the first frame an object overlaps the sensor.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="object">The object.</param>
+     **************************************************************************************************/
+    virtual void BeginOverlap(a2de::Object* /*object*/) { /* DO NOTHING */ }
+
+    /**************************************************************************************************
+     * <summary>Called every following frame the object still overlaps the sensor.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="object">The object.</param>
+     **************************************************************************************************/
+    virtual void PersistOverlap(a2de::Object* /*object*/) { /* DO NOTHING */ }
+
+    /**************************************************************************************************
+     * <summary>Called the first frame the object no longer overlaps the sensor, or when either is
+     * removed from the world while they overlap.</summary>
+     * <remarks>Casey Ugone, 8/21/2014.</remarks>
+     * <param name="object">The object.</param>
+     **************************************************************************************************/
+    virtual void EndOverlap(a2de::Object* /*object*/) { /* DO NOTHING */ }
+
+    virtual ~ISensor() { /* DO NOTHING */ }
+protected:
+private:
+};
+
+A2DE_END
+
+#endif
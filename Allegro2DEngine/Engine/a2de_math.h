@@ -30,5 +30,6 @@
 #include "Math/CTriangle.h"
 #include "Math/CPolygon.h"
 #include "Math/CSpline.h"
+#include "Math/GJK.h"
 
 #endif
\ No newline at end of file
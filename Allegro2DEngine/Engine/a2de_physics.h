@@ -14,10 +14,25 @@
 #include "Physics/AABB.h"
 #include "Physics/OBB.h"
 #include "Physics/CRigidBody.h"
+#include "Physics/CForceBuffer.h"
 #include "Physics/CRigidBodyState.h"
 #include "Physics/CCamera.h"
 #include "Physics/CWorld.h"
+#include "Physics/IBroadPhase.h"
 #include "Physics/CQuadTree.h"
+#include "Physics/CGrid.h"
+#include "Physics/CSweepAndPrune.h"
+#include "Physics/CDynamicTree.h"
+#include "Physics/CLooseQuadTree.h"
+#include "Physics/CBodyHandle.h"
+#include "Physics/CBodyStore.h"
+#include "Physics/CContactManifold.h"
+#include "Physics/CContactCache.h"
+#include "Physics/CContactSolver.h"
+#include "Physics/CConvexHull.h"
+#include "Physics/CCollisionDispatcher.h"
+#include "Physics/IContactListener.h"
+#include "Physics/ISensor.h"
 #include "Physics/a2de_force_generators.h"
 #include "Physics/CTrigger.h"
 #include "Physics/CPhysicsArea.h"